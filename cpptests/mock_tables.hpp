@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+#include <gsl/gsl_randist.h>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpy11/rng.hpp>
+
+struct mock_tables
+// The parts of fwdpp::ts::table_collection used by the
+// tree traversals in fwdpy11/evolvets: counting mutations
+// and adding infinite- and finite-sites mutations.
+{
+    struct edge
+    {
+        double left, right;
+        fwdpp::ts::table_index_t parent, child;
+    };
+    struct node
+    {
+        double time;
+    };
+    struct site
+    {
+        double position;
+        std::int8_t ancestral_state;
+    };
+    struct mutation_record
+    {
+        fwdpp::ts::table_index_t node;
+        std::size_t key;
+        fwdpp::ts::table_index_t site;
+        std::int8_t derived_state;
+        bool neutral;
+    };
+    std::vector<edge> edges;
+    std::vector<node> nodes;
+    std::vector<site> sites;
+    std::vector<mutation_record> mutations;
+    std::vector<std::size_t> input_left, output_right;
+    double L;
+
+    explicit mock_tables(double genome_length = 1.0)
+        : edges{}, nodes{}, sites{}, mutations{}, input_left{}, output_right{},
+          L{genome_length}
+    {
+    }
+
+    double
+    genome_length() const
+    {
+        return L;
+    }
+
+    void
+    build_indexes()
+    // Edges in order of left and of right
+    {
+        input_left.resize(edges.size());
+        std::iota(input_left.begin(), input_left.end(), 0);
+        output_right = input_left;
+        std::sort(input_left.begin(), input_left.end(),
+                  [this](std::size_t a, std::size_t b) {
+                      return edges[a].left < edges[b].left;
+                  });
+        std::sort(output_right.begin(), output_right.end(),
+                  [this](std::size_t a, std::size_t b) {
+                      return edges[a].right < edges[b].right;
+                  });
+    }
+
+    void
+    add_wright_fisher_genealogy(const fwdpy11::GSLrng_t& rng, int N, int G)
+    // G generations of N haploid nodes.  Node g * N + i is
+    // individual i of generation g, at time g.  Each node
+    // after the first generation has two parents and one
+    // crossover.  The edges are then indexed.
+    {
+        for (int g = 0; g < G; ++g)
+            {
+                for (int i = 0; i < N; ++i)
+                    {
+                        nodes.push_back({static_cast<double>(g)});
+                        if (g > 0)
+                            {
+                                fwdpp::ts::table_index_t child = g * N + i;
+                                auto p1 = static_cast<fwdpp::ts::table_index_t>(
+                                    (g - 1) * N + gsl_rng_uniform_int(rng.get(), N));
+                                auto p2 = static_cast<fwdpp::ts::table_index_t>(
+                                    (g - 1) * N + gsl_rng_uniform_int(rng.get(), N));
+                                auto x = gsl_ran_flat(rng.get(), 0., L);
+                                edges.push_back({0., x, p1, child});
+                                edges.push_back({x, L, p2, child});
+                            }
+                    }
+            }
+        build_indexes();
+    }
+};
@@ -0,0 +1,109 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/regions/RecombinationRegions.hpp>
+
+using unit_type = fwdpy11::GeneticMapUnitParameters::unit_type;
+
+struct aggregated_map_fixture
+{
+    fwdpy11::GSLrng_t rng;
+    std::vector<double> breakpoints;
+    const unsigned nreps;
+
+    aggregated_map_fixture() : rng(42), breakpoints{}, nreps(100000)
+    {
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_AggregatedGeneticMap)
+
+BOOST_FIXTURE_TEST_CASE(test_empty_map, aggregated_map_fixture)
+{
+    fwdpy11::AggregatedGeneticMap gmap({});
+    gmap.generate_breakpoints(rng, breakpoints);
+    BOOST_REQUIRE(breakpoints.empty());
+    BOOST_REQUIRE(gmap(rng).empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_many_poisson_intervals, aggregated_map_fixture)
+{
+    std::vector<fwdpy11::GeneticMapUnitParameters> units;
+    for (unsigned i = 0; i < 10000; ++i)
+        {
+            units.push_back({unit_type::poisson_interval, static_cast<double>(i),
+                             static_cast<double>(i + 1), 1e-4, false});
+        }
+    fwdpy11::AggregatedGeneticMap gmap(units);
+    double total = 0.0;
+    for (unsigned i = 0; i < nreps; ++i)
+        {
+            gmap.generate_breakpoints(rng, breakpoints);
+            if (!breakpoints.empty())
+                {
+                    BOOST_REQUIRE_EQUAL(breakpoints.back(),
+                                        std::numeric_limits<double>::max());
+                    BOOST_REQUIRE(std::is_sorted(begin(breakpoints), end(breakpoints)));
+                    BOOST_REQUIRE(breakpoints.front() >= 0.0);
+                    BOOST_REQUIRE(breakpoints[breakpoints.size() - 2] < 10000.0);
+                    total += breakpoints.size() - 1;
+                }
+        }
+    BOOST_CHECK_CLOSE(total / nreps, 1.0, 2.0);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_points, aggregated_map_fixture)
+{
+    fwdpy11::AggregatedGeneticMap gmap(
+        {{unit_type::binomial_point, 1.0, 1.0, 0.3, false},
+         {unit_type::poisson_point, 2.0, 2.0, 0.5, false}});
+    unsigned nbinomial = 0, npoisson = 0;
+    for (unsigned i = 0; i < nreps; ++i)
+        {
+            gmap.generate_breakpoints(rng, breakpoints);
+            auto b = std::count(begin(breakpoints), end(breakpoints), 1.0);
+            auto p = std::count(begin(breakpoints), end(breakpoints), 2.0);
+            BOOST_REQUIRE(b <= 1);
+            BOOST_REQUIRE(p <= 1);
+            nbinomial += b;
+            npoisson += p;
+        }
+    BOOST_CHECK_CLOSE(static_cast<double>(nbinomial) / nreps, 0.3, 2.0);
+    // A Poisson point contributes a breakpoint when the
+    // number of events is odd.
+    BOOST_CHECK_CLOSE(static_cast<double>(npoisson) / nreps,
+                      (1.0 - std::exp(-2.0 * 0.5)) / 2.0, 2.0);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_fixed_and_certain_units, aggregated_map_fixture)
+{
+    fwdpy11::AggregatedGeneticMap gmap(
+        {{unit_type::fixed_crossovers, 0.0, 10.0, 3, true},
+         {unit_type::binomial_interval, 20.0, 30.0, 1.0, false}});
+    for (unsigned i = 0; i < 100; ++i)
+        {
+            gmap.generate_breakpoints(rng, breakpoints);
+            BOOST_REQUIRE_EQUAL(breakpoints.size(), 5);
+            for (std::size_t j = 0; j < 3; ++j)
+                {
+                    BOOST_REQUIRE_EQUAL(breakpoints[j], std::floor(breakpoints[j]));
+                    BOOST_REQUIRE(breakpoints[j] < 10.0);
+                }
+            BOOST_REQUIRE(breakpoints[3] >= 20.0 && breakpoints[3] < 30.0);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_units)
+{
+    BOOST_REQUIRE_THROW(
+        fwdpy11::AggregatedGeneticMap({{unit_type::binomial_point, 1.0, 1.0, 1.5, false}}),
+        std::invalid_argument);
+    BOOST_REQUIRE_THROW(fwdpy11::AggregatedGeneticMap(
+                            {{unit_type::poisson_interval, 0.0, 1.0, -1.0, false}}),
+                        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolvets/incremental_mutation_counts.hpp>
+
+struct mock_genome
+// Stands in for fwdpp::haploid_genome
+{
+    std::uint32_t n;
+    std::vector<std::uint32_t> mutations, smutations;
+};
+
+namespace
+{
+    std::vector<std::uint32_t>
+    full_recount(const std::vector<mock_genome>& genomes, std::size_t nmutations)
+    {
+        std::vector<std::uint32_t> rv(nmutations, 0);
+        for (auto& g : genomes)
+            {
+                for (auto k : g.mutations)
+                    {
+                        rv[k] += g.n;
+                    }
+                for (auto k : g.smutations)
+                    {
+                        rv[k] += g.n;
+                    }
+            }
+        return rv;
+    }
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(test_IncrementalMutationCounts)
+
+BOOST_AUTO_TEST_CASE(test_matches_full_recount)
+// Mimic the genome book-keeping of evolve_generation_ts:
+// new genomes overwrite extinct ones or are appended,
+// and the counts of parental genomes are zeroed.
+{
+    fwdpy11::GSLrng_t rng(42);
+    std::vector<mock_genome> genomes(10, mock_genome{2, {}, {}});
+    std::size_t nmutations = 0;
+    fwdpy11::IncrementalMutationCounts counts;
+    counts.update(genomes, nmutations);
+    for (unsigned generation = 0; generation < 200; ++generation)
+        {
+            if (generation % 37 == 0)
+                {
+                    counts.invalidate();
+                }
+            counts.record_parental_genomes(genomes);
+            std::vector<std::size_t> parents, recycling_bin;
+            for (std::size_t i = 0; i < genomes.size(); ++i)
+                {
+                    if (genomes[i].n == 0)
+                        {
+                            recycling_bin.push_back(i);
+                        }
+                    parents.insert(parents.end(), genomes[i].n, i);
+                    genomes[i].n = 0;
+                }
+            for (unsigned offspring = 0; offspring < 20; ++offspring)
+                {
+                    auto p = parents[gsl_rng_uniform_int(rng.get(), parents.size())];
+                    if (gsl_rng_uniform(rng.get()) < 0.75)
+                        {
+                            ++genomes[p].n;
+                            continue;
+                        }
+                    mock_genome g{1, genomes[p].mutations, genomes[p].smutations};
+                    g.smutations.push_back(nmutations++);
+                    if (gsl_rng_uniform(rng.get()) < 0.5)
+                        {
+                            g.mutations.push_back(nmutations++);
+                        }
+                    if (!recycling_bin.empty())
+                        {
+                            genomes[recycling_bin.back()] = std::move(g);
+                            recycling_bin.pop_back();
+                        }
+                    else
+                        {
+                            genomes.emplace_back(std::move(g));
+                        }
+                }
+            counts.update(genomes, nmutations);
+            BOOST_REQUIRE(counts.counts == full_recount(genomes, nmutations));
+        }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+#include <cstdint>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/regions/RecombinationRegions.hpp>
+#include <fwdpy11/evolvets/meiosis_buffers.hpp>
+
+struct mock_intermediates
+// Stands in for fwdpp::ts::mut_rec_intermediates
+{
+    std::vector<double> breakpoints;
+    std::vector<std::uint32_t> mutation_keys;
+};
+
+BOOST_AUTO_TEST_SUITE(test_MeiosisBuffers)
+
+BOOST_AUTO_TEST_CASE(test_pool_reuses_storage)
+{
+    fwdpy11::vector_pool<double> pool;
+    auto v = pool.acquire();
+    v.assign(10, 1.0);
+    pool.record_growth(0, v);
+    BOOST_REQUIRE_EQUAL(pool.allocations(), 1);
+    auto p = v.data();
+    pool.release(v);
+    BOOST_REQUIRE_EQUAL(pool.size(), 1);
+    auto w = pool.acquire();
+    BOOST_REQUIRE(w.empty());
+    BOOST_REQUIRE_EQUAL(w.data(), p);
+    BOOST_REQUIRE_EQUAL(pool.allocations(), 1);
+    // Vectors without storage are not pooled
+    std::vector<double> empty;
+    pool.release(empty);
+    BOOST_REQUIRE_EQUAL(pool.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_steady_state_has_no_allocations)
+{
+    // Binomial units give at most five breakpoints per meiosis,
+    // including the terminating value, so the largest buffer
+    // needed is reached during the warm-up generations.
+    using unit_type = fwdpy11::GeneticMapUnitParameters::unit_type;
+    std::vector<fwdpy11::GeneticMapUnitParameters> units;
+    for (unsigned i = 0; i < 4; ++i)
+        {
+            units.push_back({unit_type::binomial_point, static_cast<double>(i),
+                             static_cast<double>(i), 0.5, false});
+        }
+    fwdpy11::AggregatedGeneticMap rmodel(units);
+    fwdpy11::GSLrng_t rng(101);
+    fwdpy11::MeiosisBuffers buffers;
+
+    // Same steps as the recombination callback bound by
+    // evolvets and the recycling of each offspring's
+    // intermediates in evolve_generation_ts.
+    auto meiosis = [&]() {
+        mock_intermediates m{buffers.breakpoints.acquire(),
+                             buffers.mutation_keys.acquire()};
+        auto capacity = m.breakpoints.capacity();
+        rmodel.generate_breakpoints(rng, m.breakpoints);
+        buffers.breakpoints.record_growth(capacity, m.breakpoints);
+        return m;
+    };
+    auto generation = [&]() {
+        for (unsigned i = 0; i < 1000; ++i)
+            {
+                auto first = meiosis();
+                auto second = meiosis();
+                buffers.recycle(first);
+                buffers.recycle(second);
+            }
+    };
+    for (unsigned i = 0; i < 5; ++i)
+        {
+            generation();
+        }
+    BOOST_REQUIRE(buffers.allocations() > 0);
+    auto allocations = buffers.allocations();
+    auto pooled = buffers.breakpoints.size();
+    auto capacity = buffers.breakpoints.capacity();
+    for (unsigned i = 0; i < 20; ++i)
+        {
+            generation();
+            BOOST_REQUIRE_EQUAL(buffers.allocations(), allocations);
+            BOOST_REQUIRE_EQUAL(buffers.breakpoints.size(), pooled);
+            BOOST_REQUIRE_EQUAL(buffers.breakpoints.capacity(), capacity);
+        }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,7 +1,7 @@
 #include <cstdint>
 #include <queue>
 #include <vector>
-#include <unordered_map>
+#include <fwdpy11/types/MutationPositionLookup.hpp>
 #include <boost/test/unit_test.hpp>
 #include <gsl/gsl_matrix.h>
 #include <fwdpy11/regions/ExpS.hpp>
@@ -28,7 +28,7 @@ generate_mutation(const fwdpy11::Sregion &s, std::vector<fwdpy11::Mutation> &mut
 {
     fwdpy11::GSLrng_t rng(42);
     fwdpp::flagged_mutation_queue q(std::queue<std::size_t>{});
-    std::unordered_multimap<double, std::uint32_t> lookup_table;
+    fwdpy11::MutationPositionLookup lookup_table;
     return s(q, mutations, lookup_table, 0, rng);
 }
 
@@ -0,0 +1,186 @@
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/types/MutationPositionLookup.hpp>
+
+struct lookup_fixture
+{
+    fwdpy11::MutationPositionLookup lookup;
+
+    lookup_fixture() : lookup{}
+    {
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            {
+                lookup.emplace(static_cast<double>(i) / 1000., i);
+            }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_MutationPositionLookup)
+
+BOOST_AUTO_TEST_CASE(test_empty_lookup)
+{
+    fwdpy11::MutationPositionLookup lookup;
+    BOOST_REQUIRE(lookup.empty());
+    BOOST_REQUIRE(lookup.find(0.5) == lookup.end());
+    BOOST_REQUIRE_EQUAL(lookup.count(0.5), 0);
+    BOOST_REQUIRE(lookup.begin() == lookup.end());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_find, lookup_fixture)
+{
+    BOOST_REQUIRE_EQUAL(lookup.size(), 1000);
+    for (std::uint32_t i = 0; i < 1000; ++i)
+        {
+            auto itr = lookup.find(static_cast<double>(i) / 1000.);
+            BOOST_REQUIRE(itr != lookup.end());
+            BOOST_REQUIRE_EQUAL(itr->second, i);
+        }
+    BOOST_REQUIRE(lookup.find(2.0) == lookup.end());
+    BOOST_REQUIRE_EQUAL(std::distance(lookup.begin(), lookup.end()), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(test_multiple_keys_at_same_position)
+{
+    fwdpy11::MutationPositionLookup lookup;
+    lookup.emplace(0.25, 1);
+    lookup.emplace(0.5, 2);
+    lookup.emplace(0.25, 3);
+    lookup.emplace(-0.0, 4);
+    BOOST_REQUIRE_EQUAL(lookup.count(0.25), 2);
+    BOOST_REQUIRE_EQUAL(lookup.count(0.0), 1);
+    std::vector<std::uint32_t> keys;
+    auto r = lookup.equal_range(0.25);
+    for (; r.first != r.second; ++r.first)
+        {
+            keys.push_back(r.first->second);
+        }
+    std::sort(begin(keys), end(keys));
+    BOOST_REQUIRE(keys == std::vector<std::uint32_t>({1, 3}));
+    BOOST_REQUIRE(lookup.erase(0.25, 1));
+    BOOST_REQUIRE(!lookup.erase(0.25, 1));
+    BOOST_REQUIRE_EQUAL(lookup.count(0.25), 1);
+    BOOST_REQUIRE_EQUAL(lookup.find(0.25)->second, 3);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_erase_iterator, lookup_fixture)
+{
+    auto itr = lookup.find(0.5);
+    lookup.erase(itr);
+    BOOST_REQUIRE(lookup.find(0.5) == lookup.end());
+    BOOST_REQUIRE_EQUAL(lookup.size(), 999);
+    // Re-insertion reuses the deleted slot
+    lookup.emplace(0.5, 1001);
+    BOOST_REQUIRE_EQUAL(lookup.find(0.5)->second, 1001);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_erase_if, lookup_fixture)
+{
+    auto n = lookup.erase_if([](const auto& e) { return e.second % 2 == 0; });
+    BOOST_REQUIRE_EQUAL(n, 500);
+    BOOST_REQUIRE_EQUAL(lookup.size(), 500);
+    for (auto& e : lookup)
+        {
+            BOOST_REQUIRE(e.second % 2 == 1);
+            BOOST_REQUIRE(lookup.find(e.first) != lookup.end());
+        }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_remap, lookup_fixture)
+{
+    std::vector<std::uint32_t> new_keys(1000, std::numeric_limits<std::uint32_t>::max());
+    std::uint32_t next = 0;
+    for (std::uint32_t i = 0; i < 1000; i += 4)
+        {
+            new_keys[i] = next++;
+        }
+    lookup.remap(new_keys);
+    BOOST_REQUIRE_EQUAL(lookup.size(), 250);
+    for (std::uint32_t i = 0; i < 1000; ++i)
+        {
+            auto itr = lookup.find(static_cast<double>(i) / 1000.);
+            if (i % 4 == 0)
+                {
+                    BOOST_REQUIRE(itr != lookup.end());
+                    BOOST_REQUIRE_EQUAL(itr->second, i / 4);
+                }
+            else
+                {
+                    BOOST_REQUIRE(itr == lookup.end());
+                }
+        }
+    new_keys.resize(10);
+    BOOST_REQUIRE_THROW(lookup.remap(new_keys), std::out_of_range);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_batched_insert_and_equality, lookup_fixture)
+{
+    std::vector<fwdpy11::MutationPositionLookup::value_type> values(lookup.begin(),
+                                                                    lookup.end());
+    std::reverse(begin(values), end(values));
+    fwdpy11::MutationPositionLookup other;
+    other.insert(begin(values), end(values));
+    BOOST_REQUIRE(other == lookup);
+    other.emplace(3.0, 0);
+    BOOST_REQUIRE(other != lookup);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_clear_and_shrink, lookup_fixture)
+{
+    auto c = lookup.capacity();
+    lookup.clear();
+    BOOST_REQUIRE(lookup.empty());
+    BOOST_REQUIRE_EQUAL(lookup.capacity(), c);
+    BOOST_REQUIRE(lookup.find(0.5) == lookup.end());
+    lookup.shrink_to_fit();
+    BOOST_REQUIRE_EQUAL(lookup.capacity(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_discrete_genome)
+{
+    fwdpy11::MutationPositionLookup lookup;
+    lookup.emplace(3., 0);
+    lookup.set_discrete_genome_length(10);
+    BOOST_REQUIRE(lookup.discrete());
+    BOOST_REQUIRE(lookup.find(3.) != lookup.end());
+    BOOST_REQUIRE(lookup.find(4.) == lookup.end());
+    BOOST_REQUIRE(lookup.find(3.5) == lookup.end());
+    BOOST_REQUIRE_EQUAL(lookup.canonical_position(3.5), 3.);
+    BOOST_REQUIRE_THROW(lookup.emplace(2.5, 1), std::invalid_argument);
+    BOOST_REQUIRE_THROW(lookup.emplace(10., 1), std::invalid_argument);
+    for (std::uint32_t i = 0; i < 10; ++i)
+        {
+            if (i != 3)
+                {
+                    lookup.emplace(static_cast<double>(i), i);
+                }
+        }
+    BOOST_REQUIRE(lookup.all_sites_occupied());
+    lookup.emplace(5., 10);
+    BOOST_REQUIRE(lookup.erase(5., 5));
+    BOOST_REQUIRE(lookup.all_sites_occupied());
+    BOOST_REQUIRE(lookup.erase(5., 10));
+    BOOST_REQUIRE(!lookup.all_sites_occupied());
+    BOOST_REQUIRE(lookup.find(5.) == lookup.end());
+    lookup.erase_if([](const auto& e) { return e.second == 7; });
+    BOOST_REQUIRE(lookup.find(7.) == lookup.end());
+    lookup.set_discrete_genome_length(0);
+    BOOST_REQUIRE(!lookup.discrete());
+    lookup.emplace(2.5, 11);
+    BOOST_REQUIRE_EQUAL(lookup.canonical_position(3.5), 3.5);
+    BOOST_REQUIRE_THROW(lookup.set_discrete_genome_length(10), std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_memory_accounting, lookup_fixture)
+{
+    auto bytes = lookup.bytes();
+    BOOST_REQUIRE(bytes >= lookup.size() * sizeof(std::pair<double, std::uint32_t>));
+    BOOST_REQUIRE(bytes <= lookup.capacity_bytes());
+    lookup.clear();
+    BOOST_REQUIRE_EQUAL(lookup.bytes(), 0u);
+    BOOST_REQUIRE(lookup.capacity_bytes() > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
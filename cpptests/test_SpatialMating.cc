@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/spatial/SpatialMating.hpp>
+
+struct spatial_fixture
+// A 10x10 lattice of individuals one unit apart
+{
+    fwdpy11::GSLrng_t rng;
+    std::vector<fwdpy11::DiploidMetadata> metadata;
+
+    spatial_fixture() : rng(42), metadata{}
+    {
+        for (std::size_t i = 0; i < 100; ++i)
+            {
+                fwdpy11::DiploidMetadata md{};
+                md.w = 1.0;
+                md.label = i;
+                md.geography[0] = static_cast<double>(i / 10);
+                md.geography[1] = static_cast<double>(i % 10);
+                metadata.push_back(md);
+            }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_SpatialMating)
+
+BOOST_AUTO_TEST_CASE(test_invalid_parameters)
+{
+    BOOST_REQUIRE_THROW(fwdpy11::SpatialMating(0., 1., 1., 1., 0., 1000),
+                        std::invalid_argument);
+    BOOST_REQUIRE_THROW(fwdpy11::SpatialMating(1., 1., 0., 1., 0., 1000),
+                        std::invalid_argument);
+    BOOST_REQUIRE_THROW(fwdpy11::SpatialMating(1., 1., 1., -1., 0., 1000),
+                        std::invalid_argument);
+    BOOST_REQUIRE_THROW(fwdpy11::SpatialMating(1., 1., 1., 1., 0., 0),
+                        std::invalid_argument);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_mates_are_nearby, spatial_fixture)
+{
+    // The mating radius is 1.5
+    fwdpy11::SpatialMating s(9., 9., 0.5, 1., 0., 1000);
+    s.update(rng, metadata);
+    for (std::size_t i = 0; i < 1000; ++i)
+        {
+            auto p1 = i % metadata.size();
+            auto p2 = s.pick_mate(rng, p1, metadata);
+            BOOST_REQUIRE(p2 != p1);
+            auto dx = metadata[p1].geography[0] - metadata[p2].geography[0];
+            auto dy = metadata[p1].geography[1] - metadata[p2].geography[1];
+            BOOST_REQUIRE(dx * dx + dy * dy <= 1.5 * 1.5);
+        }
+    // Individuals in other demes are not mates
+    for (auto& md : metadata)
+        {
+            md.deme = static_cast<std::int32_t>(md.label % 2);
+        }
+    s.update(rng, metadata);
+    for (std::size_t i = 0; i < 1000; ++i)
+        {
+            auto p1 = i % metadata.size();
+            auto p2 = s.pick_mate(rng, p1, metadata);
+            BOOST_REQUIRE_EQUAL(metadata[p1].deme, metadata[p2].deme);
+        }
+    // An isolated individual has no mates
+    fwdpy11::SpatialMating narrow(9., 9., 0.1, 1., 0., 1000);
+    narrow.update(rng, metadata);
+    BOOST_REQUIRE_EQUAL(narrow.pick_mate(rng, 0, metadata),
+                        std::numeric_limits<std::size_t>::max());
+}
+
+BOOST_FIXTURE_TEST_CASE(test_density_regulation, spatial_fixture)
+{
+    fwdpy11::SpatialMating s(9., 9., 0.4, 1., 2., 1000);
+    s.update(rng, metadata);
+    // Radius is 1.2: corners have 2 neighbors and
+    // interior points have 4.
+    BOOST_REQUIRE_CLOSE(s.density()[0], 1. / 2., 1e-8);
+    BOOST_REQUIRE_CLOSE(s.density()[55], 1. / 3., 1e-8);
+    // Fitness is not changed
+    for (const auto& md : metadata)
+        {
+            BOOST_REQUIRE_EQUAL(md.w, 1.0);
+        }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_dispersal_stays_in_habitat, spatial_fixture)
+{
+    fwdpy11::SpatialMating s(9., 9., 0.5, 5., 0., 1000);
+    fwdpy11::DiploidMetadata offspring{};
+    for (std::size_t i = 0; i < 10000; ++i)
+        {
+            s.disperse(rng, metadata[i % metadata.size()], offspring);
+            BOOST_REQUIRE(offspring.geography[0] >= 0. && offspring.geography[0] <= 9.);
+            BOOST_REQUIRE(offspring.geography[1] >= 0. && offspring.geography[1] <= 9.);
+        }
+    metadata[0].geography[0] = 10.;
+    BOOST_REQUIRE_THROW(s.update(rng, metadata), std::runtime_error);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_validate_positions, spatial_fixture)
+{
+    fwdpy11::SpatialMating s(9., 9., 0.5, 1., 0., 1000);
+    s.validate_positions(metadata);
+    metadata[0].geography[1] = -1.;
+    BOOST_REQUIRE_THROW(s.validate_positions(metadata), std::invalid_argument);
+    for (auto& md : metadata)
+        {
+            md.geography[0] = md.geography[1] = 0.;
+        }
+    BOOST_REQUIRE_THROW(s.validate_positions(metadata), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(test_clustered_individuals)
+// Everyone is at the same point, so each block holds the
+// whole population and the work per individual is capped.
+{
+    fwdpy11::GSLrng_t rng(42);
+    std::vector<fwdpy11::DiploidMetadata> metadata;
+    for (std::size_t i = 0; i < 5000; ++i)
+        {
+            fwdpy11::DiploidMetadata md{};
+            md.w = 1.0;
+            md.label = i;
+            md.geography[0] = md.geography[1] = 0.5;
+            metadata.push_back(md);
+        }
+    fwdpy11::SpatialMating s(1., 1., 0.1, 0.1, 10., 100);
+    s.validate_positions(metadata);
+    s.update(rng, metadata);
+    // The estimated number of neighbors is close to 4999.
+    for (auto d : s.density())
+        {
+            BOOST_REQUIRE_CLOSE(d, 1. / (1. + 4999. / 10.), 5.);
+        }
+    std::vector<unsigned> times_chosen(metadata.size(), 0);
+    for (std::size_t i = 0; i < 10000; ++i)
+        {
+            auto p1 = i % metadata.size();
+            auto p2 = s.pick_mate(rng, p1, metadata);
+            BOOST_REQUIRE(p2 < metadata.size());
+            BOOST_REQUIRE(p2 != p1);
+            ++times_chosen[p2];
+        }
+    // Mates are spread over the population rather than
+    // drawn from a fixed subset.
+    auto nchosen = std::count_if(begin(times_chosen), end(times_chosen),
+                                 [](unsigned n) { return n > 0; });
+    BOOST_REQUIRE(nchosen > 4000);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolvets/count_mutations.hpp>
+#include "mock_tables.hpp"
+
+using fwdpp::ts::table_index_t;
+
+struct count_mutations_fixture
+// A Wright-Fisher genealogy of haploid nodes with one
+// crossover per node and many mutations.
+{
+    static constexpr int N = 30;
+    static constexpr int G = 40;
+    fwdpy11::GSLrng_t rng;
+    mock_tables tables;
+    std::vector<double> positions;
+    std::vector<table_index_t> samples, preserved;
+
+    count_mutations_fixture()
+        : rng(42), tables{}, positions{}, samples{}, preserved{}
+    {
+        tables.add_wright_fisher_genealogy(rng, N, G);
+        // Enough mutations that the work is split
+        // into several chunks
+        for (int i = 0; i < 100000; ++i)
+            {
+                positions.push_back(gsl_rng_uniform(rng.get()));
+            }
+        std::sort(positions.begin(), positions.end());
+        for (std::size_t m = 0; m < positions.size(); ++m)
+            {
+                tables.sites.push_back({positions[m], 0});
+                // Keys are not in position order
+                tables.mutations.push_back(
+                    {static_cast<table_index_t>(gsl_rng_uniform_int(rng.get(), N * G)),
+                     positions.size() - m - 1, static_cast<table_index_t>(m), 1, true});
+            }
+        for (int i = 0; i < N; ++i)
+            {
+                samples.push_back((G - 1) * N + i);
+            }
+        for (int i = 0; i < N; i += 3)
+            {
+                preserved.push_back(G / 2 * N + i);
+            }
+    }
+
+    std::uint32_t
+    brute_force_count(std::size_t m, const std::vector<table_index_t>& sample_list) const
+    {
+        auto x = tables.sites[tables.mutations[m].site].position;
+        std::vector<table_index_t> parent(tables.nodes.size(), fwdpp::ts::NULL_INDEX);
+        for (auto& e : tables.edges)
+            {
+                if (e.left <= x && x < e.right)
+                    {
+                        parent[e.child] = e.parent;
+                    }
+            }
+        std::uint32_t n = 0;
+        for (auto s : sample_list)
+            {
+                for (auto u = s; u != fwdpp::ts::NULL_INDEX; u = parent[u])
+                    {
+                        if (u == tables.mutations[m].node)
+                            {
+                                ++n;
+                                break;
+                            }
+                    }
+            }
+        return n;
+    }
+};
+
+BOOST_FIXTURE_TEST_SUITE(test_count_mutations, count_mutations_fixture)
+
+BOOST_AUTO_TEST_CASE(test_parallel_matches_brute_force)
+{
+    std::vector<std::uint32_t> mcounts, preserved_counts;
+    fwdpy11::count_mutations(tables, positions, samples, preserved, mcounts,
+                             preserved_counts, 4);
+    for (std::size_t m = 0; m < tables.mutations.size(); m += 499)
+        {
+            auto key = tables.mutations[m].key;
+            BOOST_REQUIRE_EQUAL(mcounts[key], brute_force_count(m, samples));
+            BOOST_REQUIRE_EQUAL(preserved_counts[key], brute_force_count(m, preserved));
+        }
+    std::vector<std::uint32_t> serial, serial_preserved;
+    fwdpy11::count_mutations(tables, positions, samples, preserved, serial,
+                             serial_preserved, 1);
+    BOOST_REQUIRE(serial == mcounts);
+    BOOST_REQUIRE(serial_preserved == preserved_counts);
+    std::vector<std::uint32_t> alive_only;
+    fwdpy11::count_mutations(tables, positions, samples, alive_only, 3);
+    BOOST_REQUIRE(alive_only == mcounts);
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_samples)
+{
+    std::vector<std::uint32_t> mcounts;
+    BOOST_REQUIRE_THROW(fwdpy11::count_mutations(tables, positions,
+                                                 std::vector<table_index_t>{0, 0},
+                                                 mcounts),
+                        std::invalid_argument);
+    BOOST_REQUIRE_THROW(fwdpy11::count_mutations(tables, positions,
+                                                 std::vector<table_index_t>{N * G},
+                                                 mcounts),
+                        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,209 @@
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/discrete_demography/MigrationMatrix.hpp>
+#include <fwdpy11/discrete_demography/simulation/multideme_fitness_lookups.hpp>
+#include <fwdpy11/discrete_demography/simulation/build_migration_lookup.hpp>
+#include <fwdpy11/discrete_demography/simulation.hpp>
+
+struct mock_metadata
+// The fields of DiploidMetadata used by the lookups
+{
+    double w;
+    std::int32_t deme;
+    std::size_t label;
+};
+
+struct lookups_fixture
+{
+    fwdpy11::GSLrng_t rng;
+    std::vector<mock_metadata> metadata;
+    fwdpy11::discrete_demography::current_deme_sizes_vector deme_sizes;
+    fwdpy11::discrete_demography::multideme_fitness_lookups<std::uint32_t> wlookups;
+
+    lookups_fixture()
+        : rng(42), metadata{}, deme_sizes(std::vector<std::uint32_t>{0, 0, 0}),
+          wlookups(3)
+    {
+        for (std::size_t i = 0; i < 30; ++i)
+            {
+                metadata.push_back({1.0, static_cast<std::int32_t>(i % 3), i});
+                deme_sizes.get()[i % 3]++;
+            }
+    }
+};
+
+BOOST_AUTO_TEST_SUITE(test_demographic_lookups)
+
+BOOST_FIXTURE_TEST_CASE(test_neutral_demes_use_uniform_draws, lookups_fixture)
+{
+    wlookups.update(deme_sizes, metadata);
+    for (std::int32_t deme = 0; deme < 3; ++deme)
+        {
+            BOOST_REQUIRE(wlookups.uniform[deme]);
+            BOOST_REQUIRE(wlookups.lookups[deme] == nullptr);
+            BOOST_REQUIRE(wlookups.has_parents(deme));
+            for (unsigned i = 0; i < 100; ++i)
+                {
+                    auto p = wlookups.get_parent(rng, deme_sizes, deme);
+                    BOOST_REQUIRE_EQUAL(metadata[p].deme, deme);
+                }
+        }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_only_changed_demes_are_rebuilt, lookups_fixture)
+{
+    metadata[0].w = 0.5;
+    metadata[1].w = 0.5;
+    wlookups.update(deme_sizes, metadata);
+    BOOST_REQUIRE(!wlookups.uniform[0]);
+    BOOST_REQUIRE(!wlookups.uniform[1]);
+    BOOST_REQUIRE(wlookups.uniform[2]);
+    auto deme0 = wlookups.lookups[0].get();
+    // Change a fitness in deme 1 only
+    metadata[1].w = 0.25;
+    wlookups.update(deme_sizes, metadata);
+    BOOST_REQUIRE(!wlookups.changed[0]);
+    BOOST_REQUIRE(wlookups.changed[1]);
+    BOOST_REQUIRE(!wlookups.changed[2]);
+    BOOST_REQUIRE_EQUAL(wlookups.lookups[0].get(), deme0);
+    // Moving an individual changes the ranges
+    // of all demes.
+    metadata[2].deme = 0;
+    deme_sizes.get()[2]--;
+    deme_sizes.get()[0]++;
+    wlookups.update(deme_sizes, metadata);
+    for (std::int32_t deme = 0; deme < 3; ++deme)
+        {
+            BOOST_REQUIRE(wlookups.changed[deme]);
+            for (unsigned i = 0; i < 100; ++i)
+                {
+                    auto p = wlookups.get_parent(rng, deme_sizes, deme);
+                    BOOST_REQUIRE_EQUAL(metadata[p].deme, deme);
+                }
+        }
+}
+
+BOOST_FIXTURE_TEST_CASE(test_zero_fitness_deme_is_not_uniform, lookups_fixture)
+{
+    for (auto& md : metadata)
+        {
+            if (md.deme == 2)
+                {
+                    md.w = 0.0;
+                }
+        }
+    wlookups.update(deme_sizes, metadata);
+    BOOST_REQUIRE(!wlookups.uniform[2]);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_migration_lookup_rebuilds_stale_rows, lookups_fixture)
+{
+    std::unique_ptr<fwdpy11::discrete_demography::MigrationMatrix> M(
+        new fwdpy11::discrete_demography::MigrationMatrix(
+            std::vector<double>{1., 0., 0., 0.5, 0.5, 0., 0., 0., 1.}, 3, true));
+    fwdpy11::discrete_demography::migration_lookup ml(3, false);
+    fwdpy11::discrete_demography::build_migration_lookup(M, deme_sizes, ml);
+    std::vector<gsl_ran_discrete_t*> tables;
+    for (auto& l : ml.lookups)
+        {
+            BOOST_REQUIRE(l != nullptr);
+            tables.push_back(l.get());
+        }
+    // Nothing changed
+    fwdpy11::discrete_demography::build_migration_lookup(M, deme_sizes, ml);
+    for (std::size_t i = 0; i < 3; ++i)
+        {
+            BOOST_REQUIRE_EQUAL(ml.lookups[i].get(), tables[i]);
+        }
+    // Only rows with deme 1 as a source depend on its size
+    deme_sizes.get()[1]++;
+    fwdpy11::discrete_demography::build_migration_lookup(M, deme_sizes, ml);
+    BOOST_REQUIRE_EQUAL(ml.lookups[0].get(), tables[0]);
+    BOOST_REQUIRE_EQUAL(ml.lookups[2].get(), tables[2]);
+    tables[1] = ml.lookups[1].get();
+    M->set_migration_rates(2, std::vector<double>{0., 0.5, 0.5});
+    ml.mark_stale(2);
+    fwdpy11::discrete_demography::build_migration_lookup(M, deme_sizes, ml);
+    BOOST_REQUIRE_EQUAL(ml.lookups[0].get(), tables[0]);
+    BOOST_REQUIRE_EQUAL(ml.lookups[1].get(), tables[1]);
+    BOOST_REQUIRE_EQUAL(ml.sources[2].size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_event_skipping_matches_full_update)
+// Generations without events take a shortcut through
+// mass_migrations_and_current_sizes and finalize_demographic_state.
+// Compare to applying all of the steps each generation.
+{
+    using namespace fwdpy11::discrete_demography;
+    auto make_model = []() {
+        std::unique_ptr<MigrationMatrix> M(new MigrationMatrix(
+            std::vector<double>{1., 0., 0., 0., 1., 0., 0., 0., 1.}, 3, false));
+        return DiscreteDemography(
+            {MassMigration(10, 0, 1, 0, -1, 0.5, false, false, true),
+             MassMigration(50, 1, 2, 0, -1, 0.3, true, false, false)},
+            {SetExponentialGrowth(20, 0, 1.02), SetExponentialGrowth(60, 0, NOGROWTH),
+             SetExponentialGrowth(70, 2, 0.99)},
+            {SetDemeSize(100, 1, 33, true)}, {}, std::move(M),
+            {SetMigrationRates(30, 0, std::vector<double>{0.5, 0.5, 0.}),
+             SetMigrationRates(90, 2, std::vector<double>{0.5, 0., 0.5})});
+    };
+    fwdpy11::GSLrng_t rng(42), rng_ref(42);
+    auto demography = make_model(), demography_ref = make_model();
+    std::vector<mock_metadata> metadata, metadata_ref;
+    for (std::size_t i = 0; i < 200; ++i)
+        {
+            metadata.push_back({1.0, static_cast<std::int32_t>(i % 3), i});
+        }
+    metadata_ref = metadata;
+    auto state = initialize_model_state(0, metadata, demography);
+    auto state_ref = initialize_model_state(0, metadata_ref, demography_ref);
+    unsigned skipped = 0;
+    for (std::uint32_t generation = 0; generation < 200; ++generation)
+        {
+            mass_migrations_and_current_sizes(rng, generation, metadata, demography,
+                                              *state);
+            skipped += (state->sizes_carried_over
+                        && generation < state->next_event_time);
+            finalize_demographic_state(generation, metadata, demography, *state);
+
+            auto& sizes_rates = state_ref->sizes_rates;
+            mass_migration(rng_ref, generation, demography_ref.mass_migration_tracker,
+                           sizes_rates.growth_rates, sizes_rates.growth_rate_onset_times,
+                           sizes_rates.growth_initial_sizes, metadata_ref);
+            get_current_deme_sizes(metadata_ref, sizes_rates.current_deme_sizes);
+            auto N = apply_demographic_events(generation, demography_ref, state_ref->M,
+                                              state_ref->miglookup, sizes_rates);
+            build_migration_lookup(state_ref->M, sizes_rates.current_deme_sizes,
+                                   state_ref->miglookup);
+
+            BOOST_REQUIRE(state->sizes_rates.current_deme_sizes.get()
+                          == sizes_rates.current_deme_sizes.get());
+            BOOST_REQUIRE(state->sizes_rates.next_deme_sizes.get()
+                          == sizes_rates.next_deme_sizes.get());
+            BOOST_REQUIRE(state->sizes_rates.growth_rates.get()
+                          == sizes_rates.growth_rates.get());
+            BOOST_REQUIRE_EQUAL(state->ttlN_next(), N);
+            for (std::size_t deme = 0; deme < 3; ++deme)
+                {
+                    BOOST_REQUIRE(state->miglookup.sources[deme]
+                                  == state_ref->miglookup.sources[deme]);
+                }
+            // The offspring become the next generation's parents
+            metadata.clear();
+            for (std::int32_t deme = 0; deme < 3; ++deme)
+                {
+                    for (std::uint32_t i = 0; i < sizes_rates.next_deme_sizes.get()[deme];
+                         ++i)
+                        {
+                            metadata.push_back({1.0, deme, metadata.size()});
+                        }
+                }
+            metadata_ref = metadata;
+        }
+    BOOST_REQUIRE(skipped > 150);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,56 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/discrete_demography/exceptions.hpp>
+#include <fwdpy11/discrete_demography/simulation/demography_trajectory.hpp>
+
+using namespace fwdpy11::discrete_demography;
+
+BOOST_AUTO_TEST_SUITE(test_demography_trajectory)
+
+BOOST_AUTO_TEST_CASE(test_growth_between_events)
+{
+    DiscreteDemography::mass_migration_vector mass_migrations{
+        MassMigration(10, 0, 1, 0, -1, 0.5, true, false, true)};
+    DiscreteDemography::set_growth_rates_vector growth{SetExponentialGrowth(20, 0, 1.01),
+                                                       SetExponentialGrowth(30, 1, 0.5)};
+    DiscreteDemography demography(mass_migrations, growth, {}, {}, nullptr, {});
+    auto trajectory = evaluate_demography({100}, demography, 0, 1000);
+    BOOST_REQUIRE_EQUAL(trajectory.maxdemes, 2);
+    BOOST_REQUIRE(trajectory.times == (std::vector<std::uint32_t>{0, 10, 20, 30}));
+    BOOST_REQUIRE(trajectory.deme_sizes(10) == (std::vector<std::uint32_t>{50, 50}));
+    BOOST_REQUIRE(trajectory.deme_sizes(15) == (std::vector<std::uint32_t>{50, 50}));
+    for (std::uint32_t t = 21; t < 200; ++t)
+        {
+            BOOST_REQUIRE_EQUAL(trajectory.deme_sizes(t)[0],
+                                std::round(50. * std::pow(1.01, t - 20)));
+        }
+    BOOST_REQUIRE_EQUAL(trajectory.deme_sizes(40)[1], 0);
+    BOOST_REQUIRE_EQUAL(trajectory.global_extinction_time,
+                        std::numeric_limits<std::uint32_t>::max());
+    // The input model is not modified
+    BOOST_REQUIRE(demography.mass_migration_tracker.get().first
+                  == demography.mass_migrations.begin());
+}
+
+BOOST_AUTO_TEST_CASE(test_global_extinction_between_events)
+{
+    DiscreteDemography demography({}, {SetExponentialGrowth(5, 0, 0.9)}, {}, {},
+                                  nullptr, {});
+    auto trajectory = evaluate_demography({100}, demography, 0, 1000);
+    auto t = trajectory.global_extinction_time;
+    BOOST_REQUIRE(t < 1000);
+    BOOST_REQUIRE(trajectory.deme_sizes(t)[0] > 0);
+    BOOST_REQUIRE_EQUAL(trajectory.deme_sizes(t + 1)[0], 0);
+}
+
+BOOST_AUTO_TEST_CASE(test_no_valid_parents)
+{
+    DiscreteDemography demography({}, {}, {SetDemeSize(3, 1, 10, true)}, {}, nullptr,
+                                  {});
+    BOOST_CHECK_THROW(evaluate_demography({100}, demography, 0, 10), DemographyError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolvets/finite_sites.hpp>
+#include "mock_tables.hpp"
+
+using fwdpp::ts::table_index_t;
+
+namespace
+{
+    struct finite_sites_fixture
+    // Node 0 is the root of two trees.  Nodes 1 and 2 are
+    // its children.  Nodes 3 and 4 descend from node 1 on
+    // [0, 5) and from node 2 on [5, 10).  Nodes 5 and 6
+    // always descend from node 2.
+    {
+        mock_tables tables;
+        fwdpy11::nucleotide_model jc69;
+
+        finite_sites_fixture() : tables(10.0), jc69{}
+        {
+            tables.nodes = {{0.}, {5.}, {5.}, {10.}, {10.}, {10.}, {10.}};
+            tables.edges = {{0., 10., 0, 1}, {0., 10., 0, 2}, {0., 5., 1, 3},
+                            {0., 5., 1, 4},  {5., 10., 2, 3}, {5., 10., 2, 4},
+                            {0., 10., 2, 5}, {0., 10., 2, 6}};
+            // Edges in order of left and of right
+            tables.input_left = {0, 1, 2, 3, 6, 7, 4, 5};
+            tables.output_right = {2, 3, 0, 1, 4, 5, 6, 7};
+            for (std::size_t i = 0; i < 4; ++i)
+                {
+                    jc69.stationary[i] = 0.25;
+                    for (std::size_t j = 0; j < 4; ++j)
+                        {
+                            jc69.transitions[i][j] = (i == j) ? 0.0 : 1. / 3.;
+                        }
+                }
+        }
+
+        table_index_t
+        parent_node(table_index_t u, double position) const
+        {
+            for (const auto& e : tables.edges)
+                {
+                    if (e.child == u && e.left <= position && position < e.right)
+                        {
+                            return e.parent;
+                        }
+                }
+            return fwdpp::ts::NULL_INDEX;
+        }
+    };
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(test_finite_sites, finite_sites_fixture)
+
+BOOST_AUTO_TEST_CASE(test_parents_and_states)
+{
+    fwdpy11::GSLrng_t rng(101);
+    auto rv = fwdpy11::finite_sites(rng, tables, 20.0, jc69);
+    BOOST_REQUIRE(!rv.mutation_site.empty());
+    BOOST_REQUIRE_EQUAL(rv.site_position.size(), rv.site_ancestral_state.size());
+    for (std::size_t i = 1; i < rv.site_position.size(); ++i)
+        {
+            BOOST_REQUIRE(rv.site_position[i - 1] < rv.site_position[i]);
+        }
+    bool stacked = false;
+    for (std::size_t m = 0; m < rv.mutation_site.size(); ++m)
+        {
+            auto site = rv.mutation_site[m];
+            auto position = rv.site_position[site];
+            BOOST_REQUIRE_EQUAL(position, static_cast<double>(static_cast<int>(position)));
+            if (m > 0)
+                {
+                    BOOST_REQUIRE(rv.mutation_site[m - 1] <= site);
+                    stacked |= (rv.mutation_site[m - 1] == site);
+                }
+
+            // The parent is the most recent earlier mutation
+            // on the path from the node to the root.
+            auto expected = fwdpp::ts::NULL_INDEX;
+            for (auto u = rv.mutation_node[m];
+                 u != fwdpp::ts::NULL_INDEX && expected == fwdpp::ts::NULL_INDEX;
+                 u = parent_node(u, position))
+                {
+                    for (std::size_t k = 0; k < m; ++k)
+                        {
+                            if (rv.mutation_site[k] == site && rv.mutation_node[k] == u
+                                && rv.mutation_time[k] < rv.mutation_time[m])
+                                {
+                                    expected = static_cast<table_index_t>(k);
+                                }
+                        }
+                }
+            BOOST_REQUIRE_EQUAL(rv.mutation_parent[m], expected);
+            auto inherited = expected == fwdpp::ts::NULL_INDEX
+                                 ? rv.site_ancestral_state[site]
+                                 : rv.mutation_derived_state[expected];
+            BOOST_REQUIRE(rv.mutation_derived_state[m] != inherited);
+            BOOST_REQUIRE(rv.mutation_derived_state[m] >= 0
+                          && rv.mutation_derived_state[m] < 4);
+        }
+    BOOST_REQUIRE(stacked);
+}
+
+BOOST_AUTO_TEST_CASE(test_existing_sites_are_skipped)
+{
+    tables.sites.push_back(mock_tables::site{3.0, 0});
+    fwdpy11::GSLrng_t rng(202);
+    auto rv = fwdpy11::finite_sites(rng, tables, 20.0, jc69);
+    BOOST_REQUIRE(!rv.site_position.empty());
+    for (auto x : rv.site_position)
+        {
+            BOOST_REQUIRE(x != 3.0);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(test_invalid_input)
+{
+    fwdpy11::GSLrng_t rng(303);
+    BOOST_REQUIRE_THROW(fwdpy11::finite_sites(rng, tables, -1.0, jc69),
+                        std::invalid_argument);
+    jc69.transitions[0][1] = 0.5;
+    BOOST_REQUIRE_THROW(fwdpy11::finite_sites(rng, tables, 1.0, jc69),
+                        std::invalid_argument);
+    jc69.transitions[0][1] = 1. / 3.;
+    tables.L = 10.5;
+    BOOST_REQUIRE_THROW(fwdpy11::finite_sites(rng, tables, 1.0, jc69),
+                        std::invalid_argument);
+    tables.L = 10.0;
+    tables.input_left.clear();
+    BOOST_REQUIRE_THROW(fwdpy11::finite_sites(rng, tables, 1.0, jc69),
+                        std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/evolvets/infinite_sites.hpp>
+#include "mock_tables.hpp"
+
+using fwdpp::ts::table_index_t;
+
+namespace
+{
+    struct mock_lookup
+    {
+        std::multimap<double, std::uint32_t> data;
+
+        bool
+        discrete() const
+        {
+            return false;
+        }
+        double
+        canonical_position(double x) const
+        {
+            return x;
+        }
+        std::multimap<double, std::uint32_t>::const_iterator
+        find(double x) const
+        {
+            return data.find(x);
+        }
+        std::multimap<double, std::uint32_t>::const_iterator
+        end() const
+        {
+            return data.end();
+        }
+        std::size_t
+        size() const
+        {
+            return data.size();
+        }
+        void
+        reserve(std::size_t)
+        {
+        }
+        void
+        emplace(double x, std::uint32_t key)
+        {
+            data.emplace(x, key);
+        }
+    };
+
+    struct mock_mutation
+    {
+        bool neutral;
+        double pos;
+        std::int32_t g;
+        mock_mutation(bool n, double p, double, double, std::int32_t g_)
+            : neutral(n), pos(p), g(g_)
+        {
+        }
+    };
+
+    struct mock_population
+    {
+        using mutation_container = std::vector<mock_mutation>;
+        std::shared_ptr<mock_tables> tables;
+        mutation_container mutations;
+        std::vector<std::uint32_t> mcounts, mcounts_from_preserved_nodes;
+        mock_lookup mut_lookup;
+        std::vector<table_index_t> alive_nodes, preserved_sample_nodes;
+        static constexpr int N = 20;
+        static constexpr int G = 30;
+
+        mock_population()
+            : tables(new mock_tables(10.0)), mutations{}, mcounts{},
+              mcounts_from_preserved_nodes{}, mut_lookup{}, alive_nodes{},
+              preserved_sample_nodes{}
+        // A Wright-Fisher genealogy of haploid nodes,
+        // with one crossover per node.
+        {
+            fwdpy11::GSLrng_t rng(101);
+            tables->add_wright_fisher_genealogy(rng, N, G);
+            auto& t = *tables;
+            // An existing mutation that is extinct,
+            // and one that is segregating.
+            mutations.emplace_back(true, 1.5, 0., 0., 3);
+            mutations.emplace_back(true, 2.5, 0., 0., 3);
+            mcounts = {0, 1};
+            mut_lookup.emplace(2.5, 1);
+            t.sites.push_back({2.5, 0});
+            t.mutations.push_back({(G - 1) * N, 1, 0, 1, true});
+        }
+
+        void
+        fill_alive_nodes()
+        {
+            alive_nodes.clear();
+            for (int i = 0; i < N; ++i)
+                {
+                    alive_nodes.push_back((G - 1) * N + i);
+                }
+        }
+
+        void
+        fill_preserved_nodes()
+        {
+            preserved_sample_nodes.clear();
+        }
+    };
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(test_infinite_sites)
+
+BOOST_AUTO_TEST_CASE(test_output_does_not_depend_on_threads)
+{
+    mock_population pop;
+    fwdpy11::GSLrng_t rng1(42), rng2(42);
+    auto serial = fwdpy11::detail::generate_neutral_mutations(rng1, *pop.tables,
+                                                              pop.mut_lookup, 1.0, 1);
+    auto parallel = fwdpy11::detail::generate_neutral_mutations(
+        rng2, *pop.tables, pop.mut_lookup, 1.0, 4);
+    BOOST_REQUIRE(!serial.empty());
+    BOOST_REQUIRE_EQUAL(serial.size(), parallel.size());
+    for (std::size_t i = 0; i < serial.size(); ++i)
+        {
+            BOOST_REQUIRE_EQUAL(serial[i].position, parallel[i].position);
+            BOOST_REQUIRE_EQUAL(serial[i].node, parallel[i].node);
+            BOOST_REQUIRE_EQUAL(serial[i].origin_time, parallel[i].origin_time);
+        }
+}
+
+BOOST_AUTO_TEST_CASE(test_number_of_mutations)
+// Each node except the first generation has one unit
+// of branch length over the whole genome.
+{
+    mock_population pop;
+    fwdpy11::GSLrng_t rng(42);
+    const double mu = 2.0;
+    std::size_t total = 0;
+    const int reps = 20;
+    for (int r = 0; r < reps; ++r)
+        {
+            total += fwdpy11::detail::generate_neutral_mutations(
+                         rng, *pop.tables, pop.mut_lookup, mu, 2)
+                         .size();
+        }
+    double expected = mu * (mock_population::G - 1) * mock_population::N * reps;
+    BOOST_REQUIRE_CLOSE(static_cast<double>(total), expected, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(test_tables_are_merged)
+{
+    mock_population pop;
+    fwdpy11::GSLrng_t rng(42);
+    auto n = fwdpy11::infinite_sites(rng, pop, 0.5, 3);
+    BOOST_REQUIRE(n > 0);
+    const auto& t = *pop.tables;
+    BOOST_REQUIRE_EQUAL(t.mutations.size(), n + 1);
+    BOOST_REQUIRE_EQUAL(t.sites.size(), n + 1);
+    BOOST_REQUIRE_EQUAL(pop.mutations.size(), n + 1);
+    BOOST_REQUIRE_EQUAL(pop.mut_lookup.size(), n + 1);
+    std::set<std::size_t> keys;
+    for (std::size_t i = 0; i < t.mutations.size(); ++i)
+        {
+            BOOST_REQUIRE_EQUAL(t.mutations[i].site, static_cast<table_index_t>(i));
+            if (i > 0)
+                {
+                    BOOST_REQUIRE(t.sites[i - 1].position < t.sites[i].position);
+                }
+            BOOST_REQUIRE_EQUAL(pop.mutations[t.mutations[i].key].pos,
+                                t.sites[i].position);
+            keys.insert(t.mutations[i].key);
+            auto node_time = t.nodes[t.mutations[i].node].time;
+            BOOST_REQUIRE(pop.mutations[t.mutations[i].key].g <= node_time);
+        }
+    BOOST_REQUIRE_EQUAL(keys.size(), t.mutations.size());
+    // The extinct mutation's slot was reused
+    BOOST_REQUIRE(keys.count(0));
+    BOOST_REQUIRE_EQUAL(pop.mcounts.size(), pop.mutations.size());
+    BOOST_REQUIRE(std::all_of(pop.mcounts.begin(), pop.mcounts.end(),
+                              [](std::uint32_t c) { return c <= mock_population::N; }));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -213,6 +213,28 @@ BOOST_AUTO_TEST_CASE(test_copies_happen_before_moves)
         }
 }
 
+BOOST_AUTO_TEST_CASE(test_moves_and_copies_to_distant_demes)
+/*
+ * Moves and copies into demes with large indexes,
+ * leaving intermediate demes empty.  Two moves from
+ * the same deme at the same time cannot move more
+ * individuals than are in the deme.
+ */
+{
+    deme_sizes_t expected = {{0, 0}, {17, pop.N / 2}, {31, pop.N / 2}, {40, pop.N / 4}};
+    mass_migrations.emplace_back(copy_individuals(0, 0, 40, 0.25, true));
+    mass_migrations.emplace_back(move_individuals(0, 0, 31, 0.5, true));
+    mass_migrations.emplace_back(move_individuals(0, 0, 17, 0.75, true));
+    auto demog = make_model();
+    DiscreteDemography_roundtrip(rng, pop, demog, 1);
+    auto deme_sizes = get_deme_sizes(pop.diploid_metadata);
+    BOOST_CHECK_EQUAL(deme_sizes.size(), 3);
+    for (auto&& e : expected)
+        {
+            BOOST_CHECK_EQUAL(e.second, deme_sizes[e.first]);
+        }
+}
+
 BOOST_AUTO_TEST_CASE(test_mass_move_with_growth)
 /*
  * In generation 5, the mass movement from 0 to 1
@@ -31,6 +31,17 @@ BOOST_AUTO_TEST_CASE(test_migration_matrix_too_large)
                       std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(test_sparse_migration_rates_column_out_of_range)
+// Row 1 of a sparse 2x2 matrix refers to a third deme.
+// This must be caught before the simulation starts.
+{
+    set_migmatrix(std::vector<double>{0.5, 0.5, 0.5, 0.5}, 2, false);
+    set_migration_rates.emplace_back(5, std::vector<std::size_t>{0, 1, 2},
+                                     std::vector<std::size_t>{0, 2},
+                                     std::vector<double>{1., 1.});
+    BOOST_CHECK_THROW({ auto ddemog = make_model(); }, std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_CASE(test_change_migration_rates_simple_two_deme_migration_bad_matrix)
 /*
  * For a 2-deme model, the mig matrix is
@@ -172,6 +172,82 @@ BOOST_AUTO_TEST_CASE(test_SetMigrationRates)
         std::invalid_argument);
 }
 
+BOOST_AUTO_TEST_CASE(test_sparse_MigrationMatrix)
+{
+    std::vector<double> dense{0.9, 0.1, 0., 0., 1., 0., 0.25, 0., 0.75};
+    fwdpy11::discrete_demography::MigrationMatrix m(dense, 3, false);
+    BOOST_REQUIRE_EQUAL(m.nnz(), 5);
+    // Duplicate entries in a row are summed
+    fwdpy11::discrete_demography::MigrationMatrix s(
+        std::vector<std::size_t>{0, 3, 4, 6}, std::vector<std::size_t>{1, 0, 0, 1, 2, 0},
+        std::vector<double>{0.1, 0.4, 0.5, 1., 0.75, 0.25}, false);
+    BOOST_REQUIRE_EQUAL(s.nnz(), 5);
+    BOOST_REQUIRE(s.dense() == m.dense());
+    BOOST_REQUIRE(s.dense() == dense);
+    BOOST_REQUIRE_EQUAL(s.rate(2, 0), 0.25);
+    BOOST_REQUIRE_EQUAL(s.rate(2, 1), 0.);
+
+    s.set_migration_rates(2, std::vector<double>{0., 0.5, 0.5});
+    BOOST_REQUIRE_EQUAL(s.nnz(), 5);
+    BOOST_REQUIRE_EQUAL(s.rate(2, 0), 0.);
+    BOOST_REQUIRE_EQUAL(s.rate(2, 1), 0.5);
+
+    // indptr must be non-decreasing and end at the number of entries
+    BOOST_CHECK_THROW(
+        {
+            fwdpy11::discrete_demography::MigrationMatrix(
+                std::vector<std::size_t>{0, 2, 1}, std::vector<std::size_t>{0, 1},
+                std::vector<double>{0.5, 0.5}, false);
+        },
+        std::invalid_argument);
+    BOOST_CHECK_THROW(
+        {
+            fwdpy11::discrete_demography::MigrationMatrix(
+                std::vector<std::size_t>{0, 1}, std::vector<std::size_t>{1},
+                std::vector<double>{1.}, false);
+        },
+        std::invalid_argument);
+    BOOST_CHECK_THROW(
+        {
+            fwdpy11::discrete_demography::SetMigrationRates(
+                0, std::vector<std::size_t>{0, 1, 2}, std::vector<std::size_t>{0, 1},
+                std::vector<double>{1., 0.5});
+        },
+        std::invalid_argument);
+    fwdpy11::discrete_demography::SetMigrationRates e(
+        0, std::vector<std::size_t>{0, 1, 2}, std::vector<std::size_t>{0, 1},
+        std::vector<double>{1., 1.});
+    BOOST_REQUIRE(e.sparse());
+    BOOST_REQUIRE_EQUAL(e.deme, fwdpy11::discrete_demography::NULLDEME);
+}
+
+BOOST_AUTO_TEST_CASE(test_sparse_row_SetMigrationRates)
+{
+    std::vector<double> dense{0.9, 0.1, 0., 0., 1., 0., 0.25, 0., 0.75};
+    fwdpy11::discrete_demography::MigrationMatrix m(dense, 3, false);
+    fwdpy11::discrete_demography::SetMigrationRates e(
+        0, 2, std::vector<std::size_t>{1, 0}, std::vector<double>{0.5, 0.5});
+    BOOST_REQUIRE(e.sparse_row());
+    m.set_migration_rates(e.deme, e.indices, e.migrates);
+    BOOST_REQUIRE_EQUAL(m.nnz(), 5);
+    BOOST_REQUIRE_EQUAL(m.rate(2, 0), 0.5);
+    BOOST_REQUIRE_EQUAL(m.rate(2, 1), 0.5);
+    BOOST_REQUIRE_EQUAL(m.rate(2, 2), 0.);
+    BOOST_REQUIRE_EQUAL(m.rate(0, 0), 0.9);
+
+    // Rates must sum to zero or one
+    BOOST_CHECK_THROW(
+        {
+            fwdpy11::discrete_demography::SetMigrationRates(
+                0, 2, std::vector<std::size_t>{0}, std::vector<double>{0.5});
+        },
+        std::invalid_argument);
+    // Source demes must exist
+    BOOST_CHECK_THROW(
+        { m.set_migration_rates(2, std::vector<std::size_t>{3}, std::vector<double>{1.}); },
+        std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_FIXTURE_TEST_SUITE(test_set_migration_rates, MigrationMatrix_fixture)
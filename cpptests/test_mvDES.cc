@@ -0,0 +1,66 @@
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <gsl/gsl_matrix.h>
+#include <fwdpp/simfunctions/recycling.hpp>
+#include <fwdpy11/regions/mvDES.hpp>
+#include <fwdpy11/regions/MultivariateGaussianEffects.hpp>
+#include <fwdpy11/regions/Region.hpp>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/Mutation.hpp>
+#include <fwdpy11/types/MutationPositionLookup.hpp>
+#include <fwdpy11/mutation_dominance/MutationDominance.hpp>
+
+BOOST_AUTO_TEST_SUITE(test_mvDES)
+
+BOOST_AUTO_TEST_CASE(test_blocks_of_correlated_effect_sizes)
+// Effect sizes are generated in blocks.  Their
+// moments must match the input distribution
+// over many blocks.
+{
+    const std::vector<double> vcov{1.0, 0.5, 0.25, 0.5, 1.0, 0.5, 0.25, 0.5, 1.0};
+    const std::vector<double> means{1.0, 0.0, -1.0};
+    gsl_matrix_const_view vcov_view = gsl_matrix_const_view_array(vcov.data(), 3, 3);
+    fwdpy11::MultivariateGaussianEffects mvg(fwdpy11::Region(0, 1, 1, true, 0), 1.,
+                                             vcov_view.matrix, 1,
+                                             fwdpy11::FixedDominance(0.25));
+    fwdpy11::mvDES mv(mvg, means);
+
+    fwdpy11::GSLrng_t rng(42);
+    fwdpp::flagged_mutation_queue q(std::queue<std::size_t>{});
+    fwdpy11::MutationPositionLookup lookup_table;
+    std::vector<fwdpy11::Mutation> mutations;
+    const std::size_t n = 20000;
+    for (std::size_t i = 0; i < n; ++i)
+        {
+            mv(q, mutations, lookup_table, 0, rng);
+        }
+    BOOST_REQUIRE_EQUAL(mutations.size(), n);
+
+    std::vector<double> sums(3, 0.), cross(9, 0.);
+    for (const auto& m : mutations)
+        {
+            BOOST_REQUIRE_EQUAL(m.esizes.size(), 3u);
+            for (std::size_t i = 0; i < 3; ++i)
+                {
+                    BOOST_REQUIRE_EQUAL(m.heffects[i], 0.25);
+                    sums[i] += m.esizes[i];
+                    for (std::size_t j = 0; j < 3; ++j)
+                        {
+                            cross[3 * i + j] += (m.esizes[i] - means[i])
+                                                * (m.esizes[j] - means[j]);
+                        }
+                }
+        }
+    for (std::size_t i = 0; i < 3; ++i)
+        {
+            BOOST_CHECK_SMALL(sums[i] / n - means[i], 0.05);
+            for (std::size_t j = 0; j < 3; ++j)
+                {
+                    BOOST_CHECK_SMALL(cross[3 * i + j] / n - vcov[3 * i + j], 0.05);
+                }
+        }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
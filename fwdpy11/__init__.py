@@ -38,6 +38,7 @@ from .discrete_demography import (  # NOQA
     SetExponentialGrowth,
     SetMigrationRates,
     SetSelfingRate,
+    demography_trajectory,
 )
 from .regions import *  # NOQA
 from .genetic_map_unit import (
@@ -53,6 +54,7 @@ from .mutation_dominance import (  # NOQA
     ExponentialDominance,
     LargeEffectExponentiallyRecessive,
 )
+from .spatial import SpatialMating  # NOQA
 from .genetic_values import (  # NOQA
     PleiotropicOptima,
     Optimum,
@@ -73,6 +75,7 @@ from ._types import (
     DataMatrixIterator,
     TableCollection,
     DiploidPopulation,
+    Simplifier,
     TreeIterator,
     VariantIterator,
 )  # NOQA
@@ -23,6 +23,7 @@ import fwdpy11
 
 from ._fwdpy11 import GSLrng, SampleRecorder
 from ._types import DiploidPopulation, ModelParams
+from .spatial import SpatialMating
 
 
 def _validate_event_timings(demography: fwdpy11.DiscreteDemography, generation: int):
@@ -55,6 +56,11 @@ def evolvets(
     remove_extinct_variants: bool = True,
     preserve_first_generation: bool = False,
     check_demographic_event_timings: bool = True,
+    discrete_genome: bool = False,
+    constant_fitness: bool = False,
+    spatial_mating: Optional[SpatialMating] = None,
+    memory_limit: Optional[int] = None,
+    compaction_threshold: Optional[float] = None,
 ):
     """
     Evolve a population with tree sequence recording
@@ -87,6 +93,24 @@ def evolvets(
                                             will occur prior to the current
                                             generation of the population.
     :type check_demographic_event_timings: bool
+    :param discrete_genome: (False) If ``True``, mutation positions and
+                            recombination breakpoints are integers in
+                            ``[0, pop.tables.genome_length)``.
+                            The setting only applies to this call.
+    :type discrete_genome: bool
+    :param constant_fitness: (False) If ``True``, declare that all individuals
+                             in a deme have the same fitness.  See below.
+    :type constant_fitness: bool
+    :param spatial_mating: (None) A model of mate choice and dispersal
+                           in continuous space.
+    :type spatial_mating: :class:`fwdpy11.SpatialMating`
+    :param memory_limit: (None) A limit, in bytes, on the memory allocated
+                         by the population.  See below.
+    :type memory_limit: int
+    :param compaction_threshold: (None) Compact the population's mutation
+                                 and genome containers when the fraction
+                                 in use falls below this value.  See below.
+    :type compaction_threshold: float
 
     The recording of genetic values into :attr:`fwdpy11.PopulationBase.genetic_values`
     is suppressed by default.  First, it is redundant with
@@ -95,6 +119,40 @@ def evolvets(
     However, it is useful to track these data for some
     cases when simulating multivariate mutational effects (pleiotropy).
 
+    When ``constant_fitness`` is ``True``, genetic values, noise, and fitness
+    are calculated once per deme and copied to all offspring in that deme.
+    The genetic value objects are not updated during the simulation and
+    parents are sampled uniformly within demes.
+    This mode is intended for neutral models, such as burn-in phases.
+    It is an error to use it with a non-zero selected mutation rate or
+    when the population contains selected mutations.
+    Models with random noise or genetic values that depend on anything
+    other than selected mutations must not use it.
+
+    If ``memory_limit`` is not ``None``, the memory allocated by the
+    population, as reported by :meth:`fwdpy11.DiploidPopulation.memory_usage`,
+    plus the memory held by the buffer of new edges and by the
+    output tables and node map of the simplification algorithm,
+    is checked each generation.  The segment buffers used internally
+    by simplification are not included, so the memory in use
+    during simplification can exceed the limit.  If the total exceeds
+    the limit, the tables are simplified and unused capacity is released.
+    If the limit is still exceeded, :class:`fwdpy11.MemoryLimitExceeded`
+    is raised.  The population should not be evolved further after this
+    exception.  The mutation keys of genomes and the effect sizes of
+    mutations are only measured after each simplification, so that the
+    check does not visit every genome and mutation each generation.
+
+    Extinct mutations and genomes are recycled, so the containers of
+    the population never shrink below their largest size during a
+    simulation.  If ``compaction_threshold`` is not ``None``, then
+    after each simplification, the containers are compacted if the
+    fraction of mutations or genomes still in use is less than
+    ``compaction_threshold``.  Compaction changes the mutation keys
+    stored in the tables and genomes, so keys must not be stored
+    across generations by recorders.  Compaction requires edge table
+    indexing and does nothing if ``suppress_table_indexing`` is ``True``.
+
     .. note::
         If recorder is None,
         then :class:`fwdpy11.NoAncientSamples` will be used.
@@ -115,6 +173,11 @@ def evolvets(
         Update to refactored ModelParams.
         Added ``check_demographic_event_timings``.
 
+    .. versionchanged:: 0.16.0
+
+        Added ``discrete_genome``, ``constant_fitness``, ``spatial_mating``,
+        ``memory_limit``, and ``compaction_threshold``.
+
     """
     if recorder is None:
         from ._fwdpy11 import NoAncientSamples
@@ -157,6 +220,18 @@ def evolvets(
     mm = MutationRegions.create(pneutral, params.nregions, params.sregions)
     rm = dispatch_create_GeneticMap(params.rates.recombination_rate, params.recregions)
 
+    if memory_limit is None:
+        memory_limit = 0
+    elif memory_limit <= 0:
+        raise ValueError(f"memory_limit must be > 0, got {memory_limit}")
+
+    if compaction_threshold is None:
+        compaction_threshold = 0.0
+    elif not 0.0 < compaction_threshold <= 1.0:
+        raise ValueError(
+            f"compaction_threshold must be in (0, 1], got {compaction_threshold}"
+        )
+
     from ._fwdpy11 import SampleRecorder
 
     sr = SampleRecorder()
@@ -185,4 +260,9 @@ def evolvets(
         reset_treeseqs_after_simplify,
         preserve_first_generation,
         post_simplification_recorder,
+        discrete_genome,
+        constant_fitness,
+        spatial_mating,
+        memory_limit,
+        compaction_threshold,
     )
@@ -14,6 +14,7 @@ import itertools
 import demes
 
 from ..discrete_demography import (
+    _CSRMatrix,
     MassMigration,
     MigrationMatrix,
     SetDemeSize,
@@ -31,6 +32,54 @@ from ..demographic_models import DemographicModelDetails, DemographicModelCitati
 
 from .._demography import exponential_growth_rate
 
+# Migration matrices are built one sparse row at a time.
+# A row is a dict mapping source demes to rates.
+# Models with at least this many demes are given sparse
+# matrices and sparse SetMigrationRates events, so that
+# neither the importer nor the simulation allocates
+# npops * npops values.  Smaller models are given dense
+# numpy arrays, as in previous versions.
+_SPARSE_MIGMATRIX_MIN_DEMES = 64
+
+_SparseRows = List[Dict[int, float]]
+
+
+def _identity_rows(n: int) -> _SparseRows:
+    return [{i: 1.0} for i in range(n)]
+
+
+def _add_to_row(row: Dict[int, float], j: int, value: float) -> None:
+    v = row.get(j, 0.0) + value
+    if v == 0.0:
+        row.pop(j, None)
+    else:
+        row[j] = v
+
+
+def _sparse_output(n: int) -> bool:
+    return n >= _SPARSE_MIGMATRIX_MIN_DEMES
+
+
+def _migmatrix_output(rows: _SparseRows):
+    n = len(rows)
+    if _sparse_output(n):
+        return _CSRMatrix.from_rows(rows, n)
+    rv = np.zeros((n, n))
+    for i, row in enumerate(rows):
+        for j, v in row.items():
+            rv[i, j] = v
+    return rv
+
+
+def _migration_row_output(row: Dict[int, float], n: int):
+    if _sparse_output(n):
+        return _CSRMatrix.from_rows([row], n)
+    rv = np.zeros(n)
+    for j, v in row.items():
+        rv[j] = v
+    return rv
+
+
 # TODO: need type hints for dg
 def demography_from_demes(
     dg: Union[str, demes.Graph], burnin: int
@@ -43,7 +92,15 @@ def demography_from_demes(
     :param int burnin: The factor for the burnin time, so that burn in occurs for
         burnin * N generations.
 
+    For models with at least 64 demes, the migration matrix and the
+    :class:`fwdpy11.SetMigrationRates` events are sparse matrices.
+    Otherwise, they are dense :class:`numpy.ndarray` objects.
+
     .. versionadded:: 0.14.0
+
+    .. versionchanged:: 0.16.0
+
+        Sparse migration matrices for models with many demes.
     """
     if isinstance(dg, str):
         g = demes.load(dg)
@@ -159,43 +216,49 @@ class _Fwdpy11Events(object):
     set_selfing_rates: List[SetSelfingRate] = attr.Factory(list)
     idmap: Dict = None
 
-    # The initial continuous migration matrix
-    initial_migmatrix: Optional[MigrationMatrix] = None
+    # The initial continuous migration matrix, as sparse rows
+    initial_migmatrix: Optional[_SparseRows] = None
     # The migration matrix that we update to get changes in migration rates
-    migmatrix: Optional[MigrationMatrix] = None
+    migmatrix: Optional[_SparseRows] = None
 
     # The following do not correspond to fwdpy11 event types.
     migration_rate_changes: List[_MigrationRateChange] = attr.Factory(list)
     # deme_extinctions: List[_DemeExtinctionEvent] = attr.Factory(list)
 
     def _update_changes_at_m(self, changes_at_m, migration_rate_change):
-        # tally changes
+        # tally changes.  changes_at_m holds sparse changes
+        # to the continuous and instantaneous matrices,
+        # keyed by destination deme.
+        dest = migration_rate_change.destination
+        source = migration_rate_change.source
+        rate_change = migration_rate_change.rate_change
         if migration_rate_change.from_deme_graph:
-            changes_at_m[0][migration_rate_change.destination][
-                migration_rate_change.source
-            ] += migration_rate_change.rate_change
-            if migration_rate_change.destination != migration_rate_change.source:
-                changes_at_m[0][migration_rate_change.destination][
-                    migration_rate_change.destination
-                ] -= migration_rate_change.rate_change
+            row = changes_at_m[0].setdefault(dest, {})
+            row[source] = row.get(source, 0.0) + rate_change
+            if dest != source:
+                row[dest] = row.get(dest, 0.0) - rate_change
         else:
-            changes_at_m[1][migration_rate_change.destination][
-                migration_rate_change.source
-            ] += migration_rate_change.rate_change
-            changes_at_m[1][migration_rate_change.destination][
-                migration_rate_change.destination
-            ] -= migration_rate_change.rate_change
+            row = changes_at_m[1].setdefault(dest, {})
+            row[source] = row.get(source, 0.0) + rate_change
+            row[dest] = row.get(dest, 0.0) - rate_change
 
     def _update_continuous_mass_migrations(self, changes_at_m, M_cont, M_mass):
-        M_cont += changes_at_m[0]
-        M_mass += changes_at_m[1]
+        for M, changes in zip((M_cont, M_mass), changes_at_m):
+            for dest, row in changes.items():
+                for source, value in row.items():
+                    _add_to_row(M[dest], source, value)
         return M_cont, M_mass
 
-    def _migration_matrix_from_partition(self, M_cont, M_mass):
-        new_migmatrix = np.diag(np.diag(M_mass)).dot(M_cont) + (
-            M_mass - np.diag(np.diag(M_mass))
-        )
-        return new_migmatrix
+    def _migration_matrix_row_from_partition(self, M_cont, M_mass, i):
+        # Row i of diag(diag(M_mass)) . M_cont + (M_mass - diag(diag(M_mass)))
+        scale = M_mass[i].get(i, 0.0)
+        rv = {}
+        for j, v in M_cont[i].items():
+            _add_to_row(rv, j, scale * v)
+        for j, v in M_mass[i].items():
+            if j != i:
+                _add_to_row(rv, j, v)
+        return rv
 
     def _build_migration_rate_changes(self) -> List[SetMigrationRates]:
         # We track the coninuous migration rates, and then augment with a matrix that
@@ -205,11 +268,16 @@ class _Fwdpy11Events(object):
         # and add to ancestry source from the off diagonal source column)
         # but for some generations has ancestry pointing to different demes due
         # to pulse, split, etc events
-        if self.migmatrix is not None:
-            M_cont = copy.deepcopy(self.migmatrix)
-        else:
-            M_cont = np.eye(len(self.idmap))
-        M_mass = np.eye(len(self.idmap))
+        #
+        # All matrices are sparse rows.  Only the rows changed
+        # at a given time are recalculated, so the cost scales
+        # with the number of changes rather than with the
+        # number of demes squared.
+        n = len(self.idmap)
+        if self.migmatrix is None:
+            self.migmatrix = _identity_rows(n)
+        M_cont = copy.deepcopy(self.migmatrix)
+        M_mass = _identity_rows(n)
 
         set_migration_rates: List[SetMigrationRates] = []
 
@@ -221,13 +289,10 @@ class _Fwdpy11Events(object):
         #    self.deme_extinctions, key=lambda x: (x.when, x.deme)
         # )
         m = 0
-        changes_at_m = [
-            np.zeros((len(self.idmap), len(self.idmap))),  # from Graph
-            np.zeros((len(self.idmap), len(self.idmap))),  # not from Graph
-        ]
         while m < len(self.migration_rate_changes):
             # gather all migration rate changes and extinction events
             # that occur at a given time
+            changes_at_m = [{}, {}]  # from Graph, not from Graph
             self._update_changes_at_m(changes_at_m, self.migration_rate_changes[m])
             mm = m + 1
 
@@ -243,25 +308,20 @@ class _Fwdpy11Events(object):
             M_cont, M_mass = self._update_continuous_mass_migrations(
                 changes_at_m, M_cont, M_mass
             )
-            # get the new migration matrix
-            new_migmatrix = self._migration_matrix_from_partition(M_cont, M_mass)
-            # for any rows that don't match, add a fwdpy11.SetMigrationRate
-            for i in range(len(self.idmap)):
-                if np.any(self.migmatrix[i] != new_migmatrix[i]):
+            # for any rows that change, add a fwdpy11.SetMigrationRate
+            for i in sorted(set(changes_at_m[0]) | set(changes_at_m[1])):
+                new_row = self._migration_matrix_row_from_partition(M_cont, M_mass, i)
+                if new_row != self.migmatrix[i]:
                     set_migration_rates.append(
                         SetMigrationRates(
-                            self.migration_rate_changes[m].when, i, new_migmatrix[i]
+                            self.migration_rate_changes[m].when,
+                            i,
+                            _migration_row_output(new_row, n),
                         )
                     )
-
-            self.migmatrix = new_migmatrix
+                    self.migmatrix[i] = new_row
 
             m = mm
-            # reset changes
-            changes_at_m = [
-                np.zeros((len(self.idmap), len(self.idmap))),  # from Graph
-                np.zeros((len(self.idmap), len(self.idmap))),  # not from Graph
-            ]
 
         return set_migration_rates
 
@@ -273,7 +333,9 @@ class _Fwdpy11Events(object):
             set_deme_sizes=self.set_deme_sizes,
             set_growth_rates=self.set_growth_rates,
             set_selfing_rates=self.set_selfing_rates,
-            migmatrix=self.initial_migmatrix,
+            migmatrix=None
+            if self.initial_migmatrix is None
+            else _migmatrix_output(self.initial_migmatrix),
             set_migration_rates=set_migration_rates,
         )
 
@@ -400,17 +462,17 @@ def _set_initial_migration_matrix(
     start time at or before that time
     """
     if len(idmap) > 1:
-        migmatrix = np.zeros((len(idmap), len(idmap)))
+        migmatrix: _SparseRows = [{} for _ in range(len(idmap))]
         for deme_id, ii in idmap.items():
             if dg[deme_id].start_time == math.inf:
-                migmatrix[ii, ii] = 1.0
+                migmatrix[ii][ii] = 1.0
         if len(dg.migrations) > 0:
             for m in dg.migrations:
                 if m.start_time == math.inf:
-                    migmatrix[idmap[m.dest]][idmap[m.source]] += m.rate
-                    migmatrix[idmap[m.dest]][idmap[m.dest]] -= m.rate
+                    _add_to_row(migmatrix[idmap[m.dest]], idmap[m.source], m.rate)
+                    _add_to_row(migmatrix[idmap[m.dest]], idmap[m.dest], -m.rate)
 
-        events.migmatrix = migmatrix
+        events.migmatrix = copy.deepcopy(migmatrix)
         events.initial_migmatrix = migmatrix
 
 
@@ -30,15 +30,40 @@ from ..discrete_demography import DiscreteDemography
 from .diploid_population import DiploidPopulation
 
 
+def _densify_migration(dc):
+    # The debugger edits the migration matrix in place,
+    # which requires dense matrices.
+    M = dc["migmatrix"]
+    if M is not None and hasattr(M.migmatrix, "tocsr"):
+        dc["migmatrix"] = fwdpy11.MigrationMatrix(
+            np.asarray(M.migmatrix.todense()), M.scaled
+        )
+    if dc["set_migration_rates"] is not None:
+        dc["set_migration_rates"] = [
+            fwdpy11.SetMigrationRates(e.when, e.deme, _dense_rates(e))
+            if hasattr(e.migrates, "tocsr")
+            else e
+            for e in dc["set_migration_rates"]
+        ]
+    return dc
+
+
+def _dense_rates(e):
+    rv = np.asarray(e.migrates.todense())
+    if e.deme >= 0:
+        return rv.flatten()
+    return rv
+
+
 def _create_event_list(o):
     try:
         d = o.model.asdict()
         dc = copy.deepcopy(d)
-        return fwdpy11.DiscreteDemography(**dc)
+        return fwdpy11.DiscreteDemography(**_densify_migration(dc))
     except AttributeError:
         d = o.asdict()
         dc = copy.deepcopy(d)
-        return fwdpy11.DiscreteDemography(**dc)
+        return fwdpy11.DiscreteDemography(**_densify_migration(dc))
 
 
 def _create_initial_deme_sizes(o):
@@ -88,6 +113,12 @@ class DemographyDebugger(object):
 
         Initialization now done with attr.
         A list of initial deme sizes is now accepted.
+
+    .. versionchanged:: 0.16.0
+
+        Models are checked by :func:`fwdpy11.demography_trajectory`,
+        which uses the same code as a simulation.  The report is
+        generated the first time that :attr:`report` is accessed.
     """
 
     initial_deme_sizes: Union[List[int], DiploidPopulation] = attr.ib(
@@ -109,6 +140,18 @@ class DemographyDebugger(object):
                 "Invalid number of " "demes in simulation: {}".format(self.maxdemes)
             )
 
+        # The real work is done in C++, by the same code
+        # used during a simulation.  The Python replay that
+        # generates the report is only run if the report is requested.
+        try:
+            self._trajectory = fwdpy11.demography_trajectory(
+                self.initial_deme_sizes, self._events, self.simlen
+            )
+        except fwdpy11.DemographyError as e:
+            raise ValueError(str(e)) from e
+        self._report = None
+
+    def _initialize_replay_state(self):
         self.current_deme_sizes = np.zeros(self.maxdemes, dtype=np.uint32)
         for i, j in enumerate(self.initial_deme_sizes):
             self.current_deme_sizes[i] = j
@@ -123,10 +166,6 @@ class DemographyDebugger(object):
         self.has_metadata = np.zeros(self.maxdemes, dtype=np.int32)
         self.has_metadata[(self.current_deme_sizes > 0)] = 1
 
-        # The real work
-        self._report = None
-        self._process_demographic_model(self._events, self.simlen)
-
     @initial_deme_sizes.validator
     def validate_initial_deme_sizes(self, attribute, value):
         if len(value) == 0:
@@ -573,13 +612,34 @@ class DemographyDebugger(object):
             self._report.append(temp.format(simlen, deme_sizes))
 
     def _process_demographic_model(self, events, simlen):
+        self._initialize_replay_state()
         event_queues = self._make_event_queues(events)
         self._generate_report(event_queues, simlen)
 
+    @property
+    def trajectory(self):
+        """
+        The deme sizes and rates at each time when
+        demographic events happen, evaluated by
+        :func:`fwdpy11.demography_trajectory`.
+
+        :rtype: :class:`fwdpy11.DemographyTrajectory`
+
+        .. versionadded:: 0.16.0
+        """
+        return self._trajectory
+
     @property
     def report(self):
         """
         Obtain the details of the demographic
         model as a nicely-formatting string.
+
+        .. versionchanged:: 0.16.0
+
+            The report is generated the first time
+            that it is requested.
         """
+        if self._report is None:
+            self._process_demographic_model(self._events, self.simlen)
         return str("").join(self._report)
@@ -3,6 +3,7 @@ from typing import IO, Dict, Iterable, Iterator, List, Optional, Tuple, Union
 import demes
 import fwdpy11._types
 import fwdpy11.tskit_tools._dump_tables_to_tskit
+import fwdpy11.tskit_tools._import_tables
 import numpy as np
 import tskit
 from fwdpy11.tskit_tools import WrappedTreeSequence
@@ -39,21 +40,55 @@ class DiploidPopulation(ll_DiploidPopulation, PopulationMixin):
         else:
             super(DiploidPopulation, self).__init__(ll_pop)
 
-        self._pytables = TableCollection(self._tables)
+        self._pytables = self._wrap_tables()
+
+    def _wrap_tables(self):
+        rv = TableCollection(self._tables)
+        # Checked by fwdpy11.Simplifier, which modifies tables in place
+        rv._owned_by_population = True
+        return rv
 
     @classmethod
-    def create_from_tskit(cls, ts: tskit.TreeSequence):
+    def create_from_tskit(
+        cls, ts: tskit.TreeSequence, *, import_mutations: bool = False
+    ):
         """
         Create a new object from an tskit.TreeSequence
 
         :param ts: A tree sequence from tskit
         :type ts: tskit.TreeSequence
+        :param import_mutations: If True, import sites and mutations
+        :type import_mutations: bool
 
         :return: A population object with an initialized :class:`fwdpy11.TableCollection`
         :rtype: :class:`fwdpy11.DiploidPopulation`
 
+        The alive individuals are made from the sample nodes
+        with the most recent time.  If these nodes belong to
+        individuals, the individuals become diploids, in order
+        of their ids.  Otherwise, consecutive nodes are paired.
+
+        If the individual table uses the metadata schema written
+        by :func:`fwdpy11.DiploidPopulation.dump_tables_to_tskit`,
+        the metadata of the alive individuals are copied.
+
+        When importing mutations, each site must have at most
+        one mutation.  Mutations not present in the alive
+        individuals are not imported.  If the mutation table uses
+        fwdpy11's metadata schema, then all fields of each
+        :class:`fwdpy11.Mutation` are recovered and non-neutral
+        mutations are added to the genomes of the individuals.
+        Otherwise, mutations are neutral with origin times
+        obtained from the tree sequence.
+
         .. versionadded:: 0.2.0
 
+        .. versionchanged:: 0.16.0
+
+            Added `import_mutations`.
+            Alive nodes are found using sample flags.
+            Individual metadata are decoded.
+
         .. note::
 
             In general, initializing a population using
@@ -66,7 +101,121 @@ class DiploidPopulation(ll_DiploidPopulation, PopulationMixin):
             for example.)
 
         """
-        ll = ll_DiploidPopulation._create_from_tskit(ts)
+        (
+            columns,
+            mutation_metadata,
+            individual_metadata,
+        ) = fwdpy11.tskit_tools._import_tables.tree_sequence_columns(
+            ts, import_mutations
+        )
+        ll = ll_DiploidPopulation._create_from_tskit(
+            columns, mutation_metadata, individual_metadata, import_mutations
+        )
+        return cls(0, 0.0, ll_pop=ll)
+
+    @classmethod
+    def create_from_arrays(
+        cls,
+        length: float,
+        *,
+        positions: np.ndarray,
+        genome_offsets: np.ndarray,
+        genome_keys: np.ndarray,
+        diploids: np.ndarray,
+        effect_sizes: Optional[np.ndarray] = None,
+        dominance: Optional[np.ndarray] = None,
+        origins: Optional[np.ndarray] = None,
+        neutral: Optional[np.ndarray] = None,
+        labels: Optional[np.ndarray] = None,
+        diploid_metadata: Optional[np.ndarray] = None,
+    ):
+        """
+        Create a new object from arrays of mutations, genomes,
+        and individuals.
+
+        :param length: The genome length
+        :type length: float
+        :param positions: Mutation positions, which must be unique
+        :type positions: numpy.ndarray
+        :param genome_offsets: Offsets of each genome's mutations
+                               in `genome_keys`
+        :type genome_offsets: numpy.ndarray
+        :param genome_keys: The mutations in each genome, given
+                            as indexes into `positions`
+        :type genome_keys: numpy.ndarray
+        :param diploids: The two genomes of each individual
+        :type diploids: numpy.ndarray
+        :param effect_sizes: (None) Mutation effect sizes
+        :type effect_sizes: numpy.ndarray
+        :param dominance: (None) Mutation dominance values
+        :type dominance: numpy.ndarray
+        :param origins: (None) Mutation origin times
+        :type origins: numpy.ndarray
+        :param neutral: (None) Which mutations are neutral
+        :type neutral: numpy.ndarray
+        :param labels: (None) Mutation labels
+        :type labels: numpy.ndarray
+        :param diploid_metadata: (None) Individual metadata
+        :type diploid_metadata: numpy.ndarray
+
+        :return: A population object
+        :rtype: :class:`fwdpy11.DiploidPopulation`
+
+        The genomes are a compressed sparse row matrix.
+        The mutations of genome `i` are
+        ``genome_keys[genome_offsets[i]:genome_offsets[i + 1]]``.
+        `diploids` has two columns, one row per individual,
+        and contains genome indexes.
+        Genomes may be shared by individuals.
+
+        By default, effect sizes are zero, dominance values are one,
+        mutations with an effect size of zero are neutral, origin times
+        are -1, and labels are zero.  Origin times must be negative,
+        as the population is at generation zero.
+
+        If given, `diploid_metadata` is a structured array with the
+        fields of the output of ``numpy.array(pop.diploid_metadata)``.
+        The `label` and `nodes` fields are ignored.
+
+        The table collection contains a node for each mutation at
+        its origin time.  Over the interval from the mutation's position
+        to the next mutation's position, this node is the parent of the
+        nodes carrying the mutation.
+
+        .. versionadded:: 0.16.0
+        """
+        positions = np.asarray(positions, dtype=np.float64)
+        diploids = np.asarray(diploids)
+        if diploids.ndim != 2 or diploids.shape[1] != 2:
+            raise ValueError("diploids must have two columns")
+        if effect_sizes is None:
+            effect_sizes = np.zeros(len(positions))
+        if dominance is None:
+            dominance = np.ones(len(positions))
+        if origins is None:
+            origins = np.full(len(positions), -1, dtype=np.int32)
+        if neutral is None:
+            neutral = np.asarray(effect_sizes) == 0.0
+        if labels is None:
+            labels = np.zeros(len(positions), dtype=np.uint16)
+        mutations = {
+            "position": positions,
+            "s": effect_sizes,
+            "h": dominance,
+            "origin": origins,
+            "neutral": np.asarray(neutral, dtype=np.uint8),
+            "label": labels,
+        }
+        genomes = {"offsets": genome_offsets, "keys": genome_keys}
+        metadata = None
+        if diploid_metadata is not None:
+            metadata = {
+                name: diploid_metadata[name]
+                for name in ("g", "e", "w", "geography", "parents", "deme", "sex")
+            }
+        ll = ll_DiploidPopulation._create_from_arrays(
+            length, mutations, genomes, diploids, metadata
+        )
         return cls(0, 0.0, ll_pop=ll)
 
     @classmethod
@@ -147,6 +296,9 @@ class DiploidPopulation(ll_DiploidPopulation, PopulationMixin):
     @property
     def tables(self) -> TableCollection:
         """Access the :class:`fwdpy11.TableCollection`"""
+        # A clone gets new tables the first time that it is evolved
+        if not self._pytables._is_same_object(self._tables):
+            self._pytables = self._wrap_tables()
         return self._pytables
 
     def _get_times(self):
@@ -178,6 +330,53 @@ class DiploidPopulation(ll_DiploidPopulation, PopulationMixin):
             return deme_sizes
         return {i: j for i, j in zip(deme_sizes[0], deme_sizes[1])}
 
+    def memory_usage(self) -> Dict[str, Tuple[int, int]]:
+        """
+        Return the memory used by each component of the population.
+
+        :returns: A dict mapping component names to the number of
+                  bytes used and the number of bytes allocated.
+        :rtype: dict
+
+        The components are the tables (``"tables.nodes"``,
+        ``"tables.edges"``, ``"tables.sites"``, ``"tables.mutations"``,
+        and ``"tables.indexes"``), ``"haploid_genomes"``, the mutation
+        keys stored in genomes (``"haploid_genomes.keys"``), ``"mutations"``
+        including their effect size vectors, ``"mcounts"``, ``"mut_lookup"``,
+        ``"fixations"``, ``"diploids"``, the metadata, and the genetic
+        value matrices.
+
+        The cost of this function is linear in the number of genomes
+        and mutations, so it may be called from a recorder.
+
+        .. versionadded:: 0.16.0
+        """
+        return self._memory_usage()
+
+    def clone(self):
+        """
+        Return a copy of the population that shares its tables.
+
+        The genomes, mutations, and metadata are copied.
+        The tables, which record the history of the population
+        and are usually much larger, are shared until either
+        population is evolved.  At that point, the population
+        being evolved copies the tables before changing them.
+        Cloning is therefore cheap when a population is used as
+        the starting point of several replicate simulations.
+
+        :rtype: :class:`fwdpy11.DiploidPopulation`
+
+        .. note::
+
+            :func:`fwdpy11.DiploidPopulation.dump_tables_to_tskit`
+            with ``destructive=True`` does not clear tables that
+            are shared with a clone.
+
+        .. versionadded:: 0.16.0
+        """
+        return self.__class__(0, 0.0, ll_pop=self._clone())
+
     def dump_tables_to_tskit(
         self,
         *,
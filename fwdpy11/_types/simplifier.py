@@ -0,0 +1,110 @@
+#
+# Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+#
+# This file is part of fwdpy11.
+#
+# fwdpy11 is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# fwdpy11 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+from typing import List, Tuple, Union
+
+import numpy as np
+
+from .._fwdpy11 import ll_Simplifier
+from .table_collection import TableCollection
+
+
+class Simplifier(ll_Simplifier):
+    """
+    Simplify table collections, reusing memory between calls.
+
+    Unlike :func:`fwdpy11.simplify_tables`, instances of this class
+    keep the internal buffers of the simplification algorithm,
+    so that simplifying many times does not repeatedly allocate memory.
+    This is useful when the same tables are simplified to many
+    different sample sets.
+
+    The buffers are shared by all calls on an instance, so calls on the
+    same instance from different Python threads are run one at a time.
+    Use one instance per thread to simplify concurrently.
+
+    .. versionadded:: 0.16.0
+    """
+
+    def __init__(self):
+        super(Simplifier, self).__init__()
+
+    def simplify(
+        self,
+        tables: TableCollection,
+        samples: Union[List[int], np.ndarray],
+        *,
+        build_indexes: bool = True
+    ) -> np.ndarray:
+        """
+        Simplify tables in place.
+
+        :param tables: A table collection
+        :type tables: :class:`fwdpy11.TableCollection`
+        :param samples: List of sample nodes
+        :type samples: list-like or array-like
+        :param build_indexes: If `False`, the edge table indexes are
+                              not rebuilt and are left empty.
+        :type build_indexes: bool
+
+        :returns: An array mapping input node ids to output node ids.
+        :rtype: numpy.ndarray
+
+        :raises ValueError: If `tables` belong to a population, such as
+                            :attr:`fwdpy11.DiploidPopulation.tables`.
+                            The population's data would no longer match its
+                            tables.  Use :func:`fwdpy11.simplify_tables` or
+                            :func:`simplify_batch`, which make copies.
+        """
+        if getattr(tables, "_owned_by_population", False) is True:
+            raise ValueError("cannot simplify the tables of a population in place")
+        return self._simplify(tables, samples, build_indexes)
+
+    def simplify_batch(
+        self,
+        tables: TableCollection,
+        sample_sets: List[Union[List[int], np.ndarray]],
+        *,
+        build_indexes: bool = True,
+        threads: int = 0
+    ) -> List[Tuple[TableCollection, np.ndarray]]:
+        """
+        Simplify the same tables to several sample sets in parallel.
+
+        The input tables are not modified.
+
+        :param tables: A table collection
+        :type tables: :class:`fwdpy11.TableCollection`
+        :param sample_sets: Lists of sample nodes
+        :type sample_sets: list
+        :param build_indexes: If `False`, the edge table indexes
+                              of the outputs are left empty.
+        :type build_indexes: bool
+        :param threads: Number of threads. The default uses one per core.
+        :type threads: int
+
+        :returns: The simplified tables and node id map for each sample set.
+        :rtype: list
+        """
+        return [
+            (TableCollection(t), idmap)
+            for t, idmap in self._simplify_batch(
+                tables, sample_sets, build_indexes, threads
+            )
+        ]
@@ -1,4 +1,4 @@
-from typing import Iterable
+from typing import Dict, Iterable, Tuple
 
 import numpy as np
 import sparse
@@ -127,6 +127,19 @@ class TableCollection(ll_TableCollection):
         """
         self._build_indexes()
 
+    def memory_usage(self) -> Dict[str, Tuple[int, int]]:
+        """
+        Return the memory used by each table and by the edge table indexes.
+
+        :returns: A dict mapping ``"nodes"``, ``"edges"``, ``"sites"``,
+                  ``"mutations"``, and ``"indexes"`` to the number of
+                  bytes used and the number of bytes allocated.
+        :rtype: dict
+
+        .. versionadded:: 0.16.0
+        """
+        return self._memory_usage()
+
     def _1dfs(self, samples, windows, include_function, simplify):
         """
         Returns an array with the zero and fixed
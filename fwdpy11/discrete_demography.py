@@ -262,8 +262,103 @@ class SetSelfingRate(fwdpy11._fwdpy11._ll_SetSelfingRate):
         super(SetSelfingRate, self).__init__(**d)
 
 
+class _CSRMatrix(object):
+    """
+    A compressed sparse row matrix with the parts of the
+    :mod:`scipy.sparse` interface used by this module.
+    Used by :func:`fwdpy11.discrete_demography.from_demes`
+    so that scipy is not required.
+    """
+
+    def __init__(self, shape, indptr, indices, data):
+        self.shape = tuple(shape)
+        self.indptr = np.asarray(indptr, dtype=np.int64)
+        self.indices = np.asarray(indices, dtype=np.int64)
+        self.data = np.asarray(data, dtype=np.float64)
+
+    @classmethod
+    def from_rows(cls, rows: typing.List[typing.Dict[int, float]], ncols: int):
+        """
+        Build from one dict per row, mapping column indexes
+        to values.  Zeros are not stored.
+        """
+        indptr = [0]
+        indices = []
+        data = []
+        for row in rows:
+            for j in sorted(row):
+                if row[j] != 0.0:
+                    indices.append(j)
+                    data.append(row[j])
+            indptr.append(len(indices))
+        return cls((len(rows), ncols), indptr, indices, data)
+
+    @property
+    def nnz(self) -> int:
+        return len(self.data)
+
+    def tocsr(self):
+        return self
+
+    def toarray(self) -> np.ndarray:
+        rv = np.zeros(self.shape)
+        rows = np.repeat(np.arange(self.shape[0]), np.diff(self.indptr))
+        rv[rows, self.indices] = self.data
+        return rv
+
+    def todense(self) -> np.ndarray:
+        return self.toarray()
+
+    def __repr__(self):
+        return (
+            f"_CSRMatrix(shape={self.shape}, indptr={self.indptr.tolist()}, "
+            f"indices={self.indices.tolist()}, data={self.data.tolist()})"
+        )
+
+
+def _is_sparse(m) -> bool:
+    # scipy.sparse matrices and arrays from the
+    # sparse package both provide tocsr()
+    return hasattr(m, "tocsr")
+
+
+def _csr_arrays(m):
+    csr = m.tocsr()
+    if csr.shape[0] != csr.shape[1]:
+        raise ValueError("MigrationMatrix must be square")
+    return csr.indptr.tolist(), csr.indices.tolist(), csr.data.tolist()
+
+
+def _canonical_entries(m):
+    # The shape, flattened indexes, and values of the
+    # non-zero entries, with duplicate entries summed
+    if _is_sparse(m):
+        csr = m.tocsr()
+        shape = tuple(csr.shape)
+        rows = np.repeat(np.arange(shape[0]), np.diff(np.asarray(csr.indptr)))
+        keys = rows * shape[1] + np.asarray(csr.indices)
+        data = np.asarray(csr.data, dtype=np.float64)
+    else:
+        a = np.asarray(m, dtype=np.float64)
+        shape = a.shape
+        keys = np.flatnonzero(a)
+        data = a.flatten()[keys]
+    keys, inverse = np.unique(keys, return_inverse=True)
+    sums = np.zeros(len(keys))
+    np.add.at(sums, inverse, data)
+    nonzero = sums != 0.0
+    return shape, keys[nonzero], sums[nonzero]
+
+
+def _matrices_equal(a, b) -> bool:
+    if _is_sparse(a) or _is_sparse(b):
+        sa, ka, va = _canonical_entries(a)
+        sb, kb, vb = _canonical_entries(b)
+        return sa == sb and np.array_equal(ka, kb) and np.array_equal(va, vb)
+    return np.array_equal(a, b)
+
+
 @attr_add_asblack
-@attr_class_pickle_with_super
 @attr_class_to_from_dict
 @attr.s(eq=False, auto_attribs=True, frozen=True, repr_ns="fwdpy11")
 class MigrationMatrix(fwdpy11._fwdpy11._ll_MigrationMatrix):
@@ -275,7 +370,7 @@ class MigrationMatrix(fwdpy11._fwdpy11._ll_MigrationMatrix):
     also determine the order of positional arguments:
 
     :param migmatrix: A square matrix of non-negative floats.
-    :type migmatrix: numpy.ndarray
+    :type migmatrix: numpy.ndarray or scipy.sparse matrix
     :param scaled: (True) If entries in `migmatrix` will be
      multiplied by deme sizes during simulation
     :type scaled: bool
@@ -286,16 +381,39 @@ class MigrationMatrix(fwdpy11._fwdpy11._ll_MigrationMatrix):
 
         Refactored to use attrs and inherit from
         low-level C++ class
+
+    .. versionchanged:: 0.16.0
+
+        `migmatrix` may be a sparse matrix.
+        Any object with a `tocsr` method, such as
+        those from :mod:`scipy.sparse`, is accepted.
+        The matrix is stored in compressed sparse row
+        format, so models with many demes and few
+        non-zero rates need not allocate a dense matrix.
     """
 
     migmatrix: np.ndarray = attr.ib()
     scaled: bool = attr.ib(default=False)
 
     def __attrs_post_init__(self):
-        super(MigrationMatrix, self).__init__(self.migmatrix, self.scaled)
+        self._init_ll()
+
+    def _init_ll(self):
+        if _is_sparse(self.migmatrix):
+            indptr, indices, data = _csr_arrays(self.migmatrix)
+            super(MigrationMatrix, self).__init__(indptr, indices, data, self.scaled)
+        else:
+            super(MigrationMatrix, self).__init__(self.migmatrix, self.scaled)
+
+    def __getstate__(self):
+        return self.asdict()
+
+    def __setstate__(self, d):
+        self.__dict__.update(d)
+        self._init_ll()
 
     def __eq__(self, other):
-        return self.scaled == other.scaled and np.array_equal(
+        return self.scaled == other.scaled and _matrices_equal(
             self.migmatrix, other.migmatrix
         )
 
@@ -347,6 +465,12 @@ class SetMigrationRates(fwdpy11._fwdpy11._ll_SetMigrationRates):
 
         Refactored to use attrs and inherit from
         low-level C++ class
+
+    .. versionchanged:: 0.16.0
+
+        `migrates` may be a sparse matrix.
+        When changing the rates into a single deme,
+        it must have one row.
     """
 
     when: int = attr.ib()
@@ -355,6 +479,16 @@ class SetMigrationRates(fwdpy11._fwdpy11._ll_SetMigrationRates):
 
     def __attrs_post_init__(self):
         if self.deme >= 0:
+            if _is_sparse(self.migrates):
+                csr = self.migrates.tocsr()
+                if csr.shape[0] != 1:
+                    raise ValueError(
+                        "sparse migration rates into a single deme must have one row"
+                    )
+                super(SetMigrationRates, self).__init__(
+                    self.when, self.deme, csr.indices.tolist(), csr.data.tolist()
+                )
+                return
             try:
                 super(SetMigrationRates, self).__init__(
                     self.when, self.deme, self.migrates.tolist()
@@ -363,6 +497,9 @@ class SetMigrationRates(fwdpy11._fwdpy11._ll_SetMigrationRates):
                 super(SetMigrationRates, self).__init__(
                     self.when, self.deme, self.migrates
                 )
+        elif _is_sparse(self.migrates):
+            indptr, indices, data = _csr_arrays(self.migrates)
+            super(SetMigrationRates, self).__init__(self.when, indptr, indices, data)
         else:
             super(SetMigrationRates, self).__init__(self.when, self.migrates.tolist())
 
@@ -371,16 +508,13 @@ class SetMigrationRates(fwdpy11._fwdpy11._ll_SetMigrationRates):
 
     def __setstate__(self, d):
         self.__dict__.update(d)
-        if self.deme == -1:
-            super(SetMigrationRates, self).__init__(self.when, self.migrates)
-        else:
-            super(SetMigrationRates, self).__init__(self.when, self.deme, self.migrates)
+        self.__attrs_post_init__()
 
     def __eq__(self, other):
         return (
             self.deme == other.deme
             and self.when == other.when
-            and np.array_equal(self.migrates, other.migrates)
+            and _matrices_equal(self.migrates, other.migrates)
         )
 
 
@@ -527,6 +661,51 @@ class DiscreteDemography(fwdpy11._fwdpy11._ll_DiscreteDemography):
             yield i
 
 
+def demography_trajectory(
+    initial_deme_sizes, model, simlen: typing.Optional[int] = None, start: int = 0
+) -> "fwdpy11.DemographyTrajectory":
+    """
+    Apply the events of a demographic model to deme sizes.
+
+    The events are applied by the same code used during a
+    simulation, but only the generations when events happen
+    are visited, making this function suitable for models with
+    many generations and many demes.  Errors in the model raise
+    the same exceptions that a simulation would.
+
+    :param initial_deme_sizes: The initial sizes of each deme
+    :type initial_deme_sizes: list or fwdpy11.DiploidPopulation
+    :param model: The demographic model
+    :type model: fwdpy11.DiscreteDemography or
+                 fwdpy11.demographic_models.DemographicModelDetails
+    :param simlen: The number of generations to evaluate.
+                   If `None`, stop after the last event.
+    :type simlen: int
+    :param start: The generation when evaluation starts.
+                  Events before this time are skipped.
+    :type start: int
+
+    :rtype: :class:`fwdpy11.DemographyTrajectory`
+
+    .. versionadded:: 0.16.0
+    """
+    try:
+        initial_deme_sizes = initial_deme_sizes.deme_sizes(as_dict=True)
+        initial_deme_sizes = [
+            int(initial_deme_sizes.get(i, 0))
+            for i in range(max(initial_deme_sizes) + 1)
+        ]
+    except AttributeError:
+        pass
+    try:
+        model = model.model
+    except AttributeError:
+        pass
+    return fwdpy11._fwdpy11._evaluate_demography(
+        initial_deme_sizes, model, start, simlen
+    )
+
+
 def from_demes(
     dg: typing.Union[str, demes.Graph], burnin: int = 10
 ) -> "DemographicModelDetails":
@@ -21,9 +21,10 @@
 
 #include <sstream>
 #include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
-#include <gsl/gsl_matrix.h>
 #include <fwdpp/util/named_type.hpp>
 
 #include "MassMigration.hpp"
@@ -224,22 +225,17 @@ namespace fwdpy11
                     {
                         return;
                     }
-                gsl_matrix_const_view v = gsl_matrix_const_view_array(
-                    migmatrix->M.data(), migmatrix->npops, migmatrix->npops);
-                gsl_vector_const_view diag
-                    = gsl_matrix_const_diagonal(&v.matrix);
                 bool allequal = true;
                 for (std::size_t i = 0;
                      allequal == true && i < migmatrix->npops; ++i)
                     {
-                        gsl_vector_const_view rv
-                            = gsl_matrix_const_row(&v.matrix, i);
                         double rsum = 0.0;
-                        for (std::size_t j = 0; j < migmatrix->npops; ++j)
+                        for (std::size_t j = migmatrix->row_offsets[i];
+                             j < migmatrix->row_offsets[i + 1]; ++j)
                             {
-                                rsum += gsl_vector_get(&rv.vector, j);
+                                rsum += migmatrix->values[j];
                             }
-                        if (rsum != gsl_vector_get(&diag.vector, i))
+                        if (rsum != migmatrix->rate(i, i))
                             {
                                 allequal = false;
                             }
@@ -265,7 +261,47 @@ namespace fwdpy11
                     }
                 for (auto& event : set_migration_rates)
                     {
-                        if (event.migrates.size() == migmatrix->npops)
+                        if (event.sparse_row())
+                            {
+                                if (std::any_of(begin(event.indices), end(event.indices),
+                                                [this](std::size_t i) {
+                                                    return i >= migmatrix->npops;
+                                                }))
+                                    {
+                                        throw std::invalid_argument(
+                                            "invalid matrix size");
+                                    }
+                                if (migmatrix->scaled == true)
+                                    {
+                                        auto sum = std::accumulate(
+                                            begin(event.migrates),
+                                            end(event.migrates), 0.);
+                                        if (sum != 0.0 && sum != 1.)
+                                            {
+                                                throw std::invalid_argument(
+                                                    "new migration rates must "
+                                                    "sum to "
+                                                    "1.0");
+                                            }
+                                    }
+                            }
+                        else if (event.sparse())
+                            {
+                                if (event.indptr.size() != migmatrix->npops + 1)
+                                    {
+                                        throw std::invalid_argument(
+                                            "invalid matrix size");
+                                    }
+                                if (std::any_of(begin(event.indices), end(event.indices),
+                                                [this](std::size_t i) {
+                                                    return i >= migmatrix->npops;
+                                                }))
+                                    {
+                                        throw std::invalid_argument(
+                                            "migration matrix column index out of range");
+                                    }
+                            }
+                        else if (event.migrates.size() == migmatrix->npops)
                             {
                                 if (migmatrix->scaled == true)
                                     {
@@ -375,6 +411,28 @@ namespace fwdpy11
             {
                 model_state = std::move(state);
             }
+
+            std::uint32_t
+            next_event_time() const
+            // The earliest time of an event that has not been
+            // applied, or the max value of std::uint32_t if
+            // there is none.
+            // Not visible to Python
+            {
+                auto rv = std::numeric_limits<std::uint32_t>::max();
+                auto update = [&rv](const auto& range) {
+                    if (range.get().first < range.get().second)
+                        {
+                            rv = std::min(rv, range.get().first->when);
+                        }
+                };
+                update(mass_migration_tracker);
+                update(deme_size_change_tracker);
+                update(growth_rate_change_tracker);
+                update(selfing_rate_change_tracker);
+                update(migration_rate_change_tracker);
+                return rv;
+            }
         };
     } // namespace discrete_demography
 } // namespace fwdpy11
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cmath>
+#include <utility>
 #include <fwdpp/gsl_discrete.hpp>
 #include "constants.hpp"
 
@@ -34,20 +35,28 @@ namespace fwdpy11
     namespace discrete_demography
     {
         class MigrationMatrix
+        /// The migration matrix is stored in compressed sparse
+        /// row (CSR) format.  Row i holds the rates into deme i.
+        /// The non-zero rates of row i are values[j] for
+        /// j in [row_offsets[i], row_offsets[i + 1]), and the
+        /// source deme of values[j] is columns[j].  Within a row,
+        /// columns are sorted.
+        ///
+        /// Changed in 0.16.0 from a dense npops * npops vector.
         {
           private:
             void
             validate_row(std::size_t i) const
             {
-                if (i * npops >= M.size())
+                if (i >= npops)
                     {
                         throw std::invalid_argument(
                             "MigrationMatrix: row index out of range");
                     }
                 double rsum = 0.;
-                for (std::size_t j = i * npops; j < i * npops + npops; ++j)
+                for (std::size_t j = row_offsets[i]; j < row_offsets[i + 1]; ++j)
                     {
-                        auto v = M[j];
+                        auto v = values[j];
                         if (v < 0.0)
                             {
                                 throw std::invalid_argument(
@@ -76,62 +85,298 @@ namespace fwdpy11
                     }
             }
 
+            void
+            assign_dense(const std::vector<double>& matrix)
+            {
+                if (matrix.size() != npops * npops)
+                    {
+                        throw std::invalid_argument("MigrationMatrix must be square");
+                    }
+                // Build into temporaries so that invalid
+                // input leaves this object unchanged.
+                std::vector<std::size_t> new_row_offsets(1, 0), new_columns;
+                std::vector<double> new_values;
+                for (std::size_t i = 0; i < npops; ++i)
+                    {
+                        for (std::size_t j = 0; j < npops; ++j)
+                            {
+                                auto v = matrix[i * npops + j];
+                                if (v != 0.0)
+                                    {
+                                        new_columns.push_back(j);
+                                        new_values.push_back(v);
+                                    }
+                            }
+                        new_row_offsets.push_back(new_columns.size());
+                    }
+                row_offsets.swap(new_row_offsets);
+                columns.swap(new_columns);
+                values.swap(new_values);
+            }
+
+            void
+            assign_sparse(const std::vector<std::size_t>& indptr,
+                          const std::vector<std::size_t>& indices,
+                          const std::vector<double>& data)
+            // Input rows need not be sorted and may contain
+            // duplicate entries, which are summed.
+            {
+                if (indptr.size() != npops + 1 || indptr.front() != 0
+                    || indptr.back() != indices.size()
+                    || indices.size() != data.size())
+                    {
+                        throw std::invalid_argument("invalid sparse migration matrix");
+                    }
+                // Build into temporaries so that invalid
+                // input leaves this object unchanged.
+                std::vector<std::size_t> new_row_offsets(1, 0), new_columns;
+                std::vector<double> new_values;
+                std::vector<std::pair<std::size_t, double>> row;
+                for (std::size_t i = 0; i < npops; ++i)
+                    {
+                        if (indptr[i + 1] < indptr[i] || indptr[i + 1] > indices.size())
+                            {
+                                throw std::invalid_argument(
+                                    "invalid sparse migration matrix");
+                            }
+                        row.clear();
+                        for (std::size_t j = indptr[i]; j < indptr[i + 1]; ++j)
+                            {
+                                if (indices[j] >= npops)
+                                    {
+                                        throw std::invalid_argument(
+                                            "sparse migration matrix column index "
+                                            "out of range");
+                                    }
+                                row.emplace_back(indices[j], data[j]);
+                            }
+                        std::sort(begin(row), end(row),
+                                  [](const std::pair<std::size_t, double>& a,
+                                     const std::pair<std::size_t, double>& b) {
+                                      return a.first < b.first;
+                                  });
+                        for (std::size_t j = 0; j < row.size();)
+                            {
+                                auto k = j;
+                                double v = 0.0;
+                                for (; k < row.size() && row[k].first == row[j].first;
+                                     ++k)
+                                    {
+                                        v += row[k].second;
+                                    }
+                                if (v != 0.0)
+                                    {
+                                        new_columns.push_back(row[j].first);
+                                        new_values.push_back(v);
+                                    }
+                                j = k;
+                            }
+                        new_row_offsets.push_back(new_columns.size());
+                    }
+                row_offsets.swap(new_row_offsets);
+                columns.swap(new_columns);
+                values.swap(new_values);
+            }
+
+            void
+            assign_row(std::size_t dest, const std::vector<double>& rates)
+            {
+                std::vector<std::size_t> new_columns;
+                std::vector<double> new_values;
+                for (std::size_t j = 0; j < rates.size(); ++j)
+                    {
+                        if (rates[j] != 0.0)
+                            {
+                                new_columns.push_back(j);
+                                new_values.push_back(rates[j]);
+                            }
+                    }
+                replace_row(dest, new_columns, new_values);
+            }
+
+            void
+            assign_row(std::size_t dest, const std::vector<std::size_t>& indices,
+                       const std::vector<double>& data)
+            // As for assign_sparse, the input need not be sorted
+            // and duplicate entries are summed.
+            {
+                if (indices.size() != data.size())
+                    {
+                        throw std::invalid_argument("invalid sparse migration rates");
+                    }
+                std::vector<std::pair<std::size_t, double>> row;
+                for (std::size_t j = 0; j < indices.size(); ++j)
+                    {
+                        if (indices[j] >= npops)
+                            {
+                                throw std::invalid_argument(
+                                    "sparse migration matrix column index "
+                                    "out of range");
+                            }
+                        row.emplace_back(indices[j], data[j]);
+                    }
+                std::sort(begin(row), end(row),
+                          [](const std::pair<std::size_t, double>& a,
+                             const std::pair<std::size_t, double>& b) {
+                              return a.first < b.first;
+                          });
+                std::vector<std::size_t> new_columns;
+                std::vector<double> new_values;
+                for (std::size_t j = 0; j < row.size();)
+                    {
+                        auto k = j;
+                        double v = 0.0;
+                        for (; k < row.size() && row[k].first == row[j].first; ++k)
+                            {
+                                v += row[k].second;
+                            }
+                        if (v != 0.0)
+                            {
+                                new_columns.push_back(row[j].first);
+                                new_values.push_back(v);
+                            }
+                        j = k;
+                    }
+                replace_row(dest, new_columns, new_values);
+            }
+
+            void
+            replace_row(std::size_t dest, const std::vector<std::size_t>& new_columns,
+                        const std::vector<double>& new_values)
+            {
+                auto first = row_offsets[dest], last = row_offsets[dest + 1];
+                columns.erase(columns.begin() + first, columns.begin() + last);
+                values.erase(values.begin() + first, values.begin() + last);
+                columns.insert(columns.begin() + first, begin(new_columns),
+                               end(new_columns));
+                values.insert(values.begin() + first, begin(new_values),
+                              end(new_values));
+                auto old_degree = last - first;
+                for (std::size_t i = dest + 1; i < row_offsets.size(); ++i)
+                    {
+                        row_offsets[i] = row_offsets[i] - old_degree + new_columns.size();
+                    }
+            }
+
           public:
-            std::vector<double> M;
             const std::size_t npops;
             const bool scaled;
+            std::vector<std::size_t> row_offsets, columns;
+            std::vector<double> values;
 
             template <typename T>
-            MigrationMatrix(T&& matrix, std::size_t nrows,
-                            const bool scaled_rates)
-                : M(std::forward<T>(matrix)), npops(nrows),
-                  scaled(scaled_rates)
+            MigrationMatrix(T&& matrix, std::size_t nrows, const bool scaled_rates)
+                : npops(nrows), scaled(scaled_rates), row_offsets{}, columns{},
+                  values{}
+            // Construct from a dense, row-major, matrix
             {
-                if (M.size() % nrows != 0.0)
+                std::vector<double> dense(std::forward<T>(matrix));
+                assign_dense(dense);
+                validate_all_row_sums();
+            }
+
+            MigrationMatrix(const std::vector<std::size_t>& indptr,
+                            const std::vector<std::size_t>& indices,
+                            const std::vector<double>& data, const bool scaled_rates)
+                : npops(indptr.empty() ? 0 : indptr.size() - 1), scaled(scaled_rates),
+                  row_offsets{}, columns{}, values{}
+            // Construct from CSR arrays, as used by scipy.sparse
+            {
+                if (npops == 0)
                     {
-                        throw std::invalid_argument(
-                            "MigrationMatrix must be square");
+                        throw std::invalid_argument("empty sparse migration matrix");
                     }
+                assign_sparse(indptr, indices, data);
                 validate_all_row_sums();
             }
 
             std::unique_ptr<MigrationMatrix>
             clone() const
             {
-                return std::unique_ptr<MigrationMatrix>(
-                    new MigrationMatrix(*this));
+                return std::unique_ptr<MigrationMatrix>(new MigrationMatrix(*this));
+            }
+
+            std::size_t
+            nnz() const
+            {
+                return values.size();
+            }
+
+            double
+            rate(std::size_t dest, std::size_t source) const
+            {
+                auto first = columns.begin() + row_offsets[dest];
+                auto last = columns.begin() + row_offsets[dest + 1];
+                auto itr = std::lower_bound(first, last, source);
+                if (itr == last || *itr != source)
+                    {
+                        return 0.0;
+                    }
+                return values[static_cast<std::size_t>(itr - columns.begin())];
+            }
+
+            std::vector<double>
+            dense() const
+            {
+                std::vector<double> rv(npops * npops, 0.0);
+                for (std::size_t i = 0; i < npops; ++i)
+                    {
+                        for (std::size_t j = row_offsets[i]; j < row_offsets[i + 1];
+                             ++j)
+                            {
+                                rv[i * npops + columns[j]] = values[j];
+                            }
+                    }
+                return rv;
             }
 
             void
             set_migration_rates(std::int32_t source,
                                 const std::vector<double>& migrates)
             {
-                if (source != NULLDEME
-                    && static_cast<std::size_t>(source) >= npops)
+                if (source != NULLDEME && static_cast<std::size_t>(source) >= npops)
                     {
-                        throw std::invalid_argument(
-                            "source pop index out of range");
+                        throw std::invalid_argument("source pop index out of range");
                     }
                 if (source != NULLDEME && migrates.size() != npops)
                     {
-                        throw std::invalid_argument(
-                            "invalid number of migration rates");
+                        throw std::invalid_argument("invalid number of migration rates");
                     }
-                else if (source == NULLDEME && migrates.size() != M.size())
+                else if (source == NULLDEME && migrates.size() != npops * npops)
                     {
-                        throw std::invalid_argument(
-                            "migration matrix size mismatch");
+                        throw std::invalid_argument("migration matrix size mismatch");
                     }
                 if (source != NULLDEME)
                     {
-                        std::copy(begin(migrates), end(migrates),
-                                  M.begin() + npops * source);
+                        assign_row(static_cast<std::size_t>(source), migrates);
                     }
                 else
                     {
-                        std::copy(begin(migrates), end(migrates), M.begin());
+                        assign_dense(migrates);
                     }
             }
+
+            void
+            set_migration_rates(std::int32_t source,
+                                const std::vector<std::size_t>& indices,
+                                const std::vector<double>& data)
+            // Replace one row with sparse rates
+            {
+                if (source < 0 || static_cast<std::size_t>(source) >= npops)
+                    {
+                        throw std::invalid_argument("source pop index out of range");
+                    }
+                assign_row(static_cast<std::size_t>(source), indices, data);
+            }
+
+            void
+            set_migration_rates(const std::vector<std::size_t>& indptr,
+                                const std::vector<std::size_t>& indices,
+                                const std::vector<double>& data)
+            // Replace the entire matrix with a sparse one
+            {
+                assign_sparse(indptr, indices, data);
+            }
         };
     } // namespace discrete_demography
 } // namespace fwdpy11
@@ -38,6 +38,12 @@ namespace fwdpy11
             std::uint32_t when;
             std::int32_t deme; // source deme
             std::vector<double> migrates;
+            // If not empty, the new rates are sparse.
+            // indptr and indices are in CSR format and
+            // migrates holds the non-zero rates.
+            // When deme is not NULLDEME, there is a single
+            // row and indptr is {0, migrates.size()}.
+            std::vector<std::size_t> indptr, indices;
 
             void
             validate_sum(double sum)
@@ -55,7 +61,7 @@ namespace fwdpy11
             }
 
             SetMigrationRates(std::uint32_t w, std::int32_t d, std::vector<double> r)
-                : when(w), deme(d), migrates(std::move(r))
+                : when(w), deme(d), migrates(std::move(r)), indptr{}, indices{}
             {
                 if (deme < 0)
                     {
@@ -88,8 +94,45 @@ namespace fwdpy11
                 validate_sum(sum);
             }
 
+            SetMigrationRates(std::uint32_t w, std::int32_t d,
+                              std::vector<std::size_t> row_indices,
+                              std::vector<double> data)
+                : when(w), deme(d), migrates(std::move(data)), indptr{},
+                  indices(std::move(row_indices))
+            // Replace the rates into deme with a sparse row.
+            // indices are the source demes of the non-zero rates.
+            {
+                if (deme < 0)
+                    {
+                        throw std::invalid_argument(
+                            "SetMigrationRates: deme label must be "
+                            "non-negative");
+                    }
+                if (indices.size() != migrates.size())
+                    {
+                        throw std::invalid_argument("invalid sparse migration rates");
+                    }
+                for (auto r : migrates)
+                    {
+                        if (r < 0.0)
+                            {
+                                throw std::invalid_argument(
+                                    "SetMigrationRates: rates must be "
+                                    "non-negative");
+                            }
+                        if (!std::isfinite(r))
+                            {
+                                throw std::invalid_argument(
+                                    "SetMigrationRates: rates must be finite");
+                            }
+                    }
+                validate_sum(std::accumulate(begin(migrates), end(migrates), 0.0));
+                indptr = {0, indices.size()};
+            }
+
             SetMigrationRates(std::uint32_t w, std::vector<double> migmatrix)
-                : when(w), deme(NULLDEME), migrates(std::move(migmatrix))
+                : when(w), deme(NULLDEME), migrates(std::move(migmatrix)), indptr{},
+                  indices{}
             {
                 if (migrates.empty())
                     {
@@ -127,6 +170,61 @@ namespace fwdpy11
                         validate_sum(sum);
                     }
             }
+
+            SetMigrationRates(std::uint32_t w, std::vector<std::size_t> csr_indptr,
+                              std::vector<std::size_t> csr_indices,
+                              std::vector<double> data)
+                : when(w), deme(NULLDEME), migrates(std::move(data)),
+                  indptr(std::move(csr_indptr)), indices(std::move(csr_indices))
+            // Replace the entire migration matrix with a sparse matrix
+            {
+                if (indptr.size() < 2)
+                    {
+                        throw std::invalid_argument("empty migration matrix");
+                    }
+                if (indptr.front() != 0 || indptr.back() != indices.size()
+                    || indices.size() != migrates.size())
+                    {
+                        throw std::invalid_argument("invalid sparse migration matrix");
+                    }
+                for (std::size_t r = 0; r + 1 < indptr.size(); ++r)
+                    {
+                        if (indptr[r + 1] < indptr[r] || indptr[r + 1] > indices.size())
+                            {
+                                throw std::invalid_argument(
+                                    "invalid sparse migration matrix");
+                            }
+                        double sum = 0.0;
+                        for (std::size_t i = indptr[r]; i < indptr[r + 1]; ++i)
+                            {
+                                auto v = migrates[i];
+                                if (v < 0)
+                                    {
+                                        throw std::invalid_argument(
+                                            "migration rates must be non-negative");
+                                    }
+                                if (!std::isfinite(v))
+                                    {
+                                        throw std::invalid_argument(
+                                            "migration rates must be finite");
+                                    }
+                                sum += v;
+                            }
+                        validate_sum(sum);
+                    }
+            }
+
+            bool
+            sparse() const
+            {
+                return !indptr.empty();
+            }
+
+            bool
+            sparse_row() const
+            {
+                return sparse() && deme != NULLDEME;
+            }
         };
 
         inline bool
@@ -19,11 +19,12 @@
 #ifndef FWDPY11_APPLY_MOVE_OR_COPY_HPP
 #define FWDPY11_APPLY_MOVE_OR_COPY_HPP
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
-#include <stack>
-#include <unordered_map>
 #include <sstream>
 #include <gsl/gsl_randist.h>
 #include "../../rng.hpp"
@@ -38,13 +39,37 @@ namespace fwdpy11
     {
         namespace detail
         {
-            using deme_map_t
-                = std::unordered_map<std::int32_t, std::vector<std::size_t>>;
+            struct deme_partition
+            /// Indexes of individuals grouped by deme.
+            /// The members of deme d are
+            /// individuals[offsets[d]:offsets[d+1]].
+            /// The first moved[d] of those have been chosen
+            /// to move by earlier events at the same time point.
+            {
+                std::vector<std::size_t> offsets, individuals, moved;
+
+                std::size_t
+                size(std::int32_t deme) const
+                {
+                    return offsets[deme + 1] - offsets[deme];
+                }
+
+                std::size_t*
+                begin(std::int32_t deme)
+                {
+                    return individuals.data() + offsets[deme];
+                }
+            };
+
             template <typename METADATATYPE>
-            inline deme_map_t
-            build_deme_map(const std::vector<METADATATYPE>& metadata)
+            inline deme_partition
+            build_deme_partition(const std::vector<METADATATYPE>& metadata,
+                                 std::size_t ndemes)
+            // Counting sort of individuals by deme
             {
-                deme_map_t rv;
+                deme_partition rv;
+                rv.offsets.resize(ndemes + 1, 0);
+                rv.moved.resize(ndemes, 0);
                 for (std::size_t i = 0; i < metadata.size(); ++i)
                     {
                         if (i != metadata[i].label)
@@ -52,269 +77,194 @@ namespace fwdpy11
                                 throw std::runtime_error(
                                     "metadata label does not equal index");
                             }
-                        rv[metadata[i].deme].push_back(i);
+                        rv.offsets[metadata[i].deme + 1]++;
+                    }
+                for (std::size_t i = 1; i < rv.offsets.size(); ++i)
+                    {
+                        rv.offsets[i] += rv.offsets[i - 1];
+                    }
+                rv.individuals.resize(metadata.size());
+                std::vector<std::size_t> next(rv.offsets.begin(),
+                                              rv.offsets.end() - 1);
+                for (std::size_t i = 0; i < metadata.size(); ++i)
+                    {
+                        rv.individuals[next[metadata[i].deme]++] = i;
                     }
                 return rv;
             }
 
-            //using move_stack = std::stack<std::size_t, std::vector<std::size_t>>;
-            using vector_backed_move_stack
-                = std::stack<std::size_t, std::vector<std::size_t>>;
-
-            struct move_stack
-            {
-                std::size_t initial_N;
-                vector_backed_move_stack ms;
-                template <typename T>
-                move_stack(std::size_t N, T&& t)
-                    : initial_N(N), ms(std::forward<T>(t))
-                {
-                }
-            };
-
-            using move_map_t = std::unordered_map<std::int32_t, move_stack>;
-
-            inline move_map_t
-            build_move_sources(const GSLrng_t& rng, const deme_map_t& deme_map)
+            inline void
+            partial_shuffle(const GSLrng_t& rng, std::size_t* first,
+                            std::size_t navailable, std::size_t n)
+            // Fisher-Yates, stopped once the first n elements
+            // are a uniform sample, without replacement, of all
+            // navailable elements.
             {
-                move_map_t rv;
-
-                for (auto&& m : deme_map)
+                for (std::size_t i = 0; i < n; ++i)
                     {
-                        auto indexes(m.second);
-                        if (indexes.empty())
-                            {
-                                throw std::runtime_error(
-                                    "empty vector of individuals");
-                            }
-                        gsl_ran_shuffle(rng.get(), indexes.data(),
-                                        indexes.size(), sizeof(std::size_t));
-                        rv.emplace(m.first, move_stack(indexes.size(),
-                                                       std::move(indexes)));
+                        auto j = i + gsl_rng_uniform_int(rng.get(), navailable - i);
+                        std::swap(first[i], first[j]);
                     }
-
-                return rv;
             }
 
-            template <typename METADATATYPE>
-            inline void
-            copy_individuals(const std::vector<std::size_t>& buffer,
-                             std::int32_t destination,
-                             std::vector<METADATATYPE>& metadata)
-            // NOTE: the "label" field does not change, in case
-            // someone is tracking parents during a simulation.
+            inline std::size_t
+            number_to_sample(const MassMigration& mm, std::size_t deme_size)
             {
-                for (auto i : buffer)
+                if (mm.fraction < 1.)
                     {
-                        metadata.push_back(metadata[i]);
-                        metadata.back().deme = destination;
+                        return std::min(deme_size,
+                                        static_cast<std::size_t>(std::round(
+                                            static_cast<double>(deme_size)
+                                            * mm.fraction)));
                     }
+                return deme_size;
             }
 
             template <typename METADATATYPE>
             inline void
             apply_copies(const GSLrng_t& rng, const MassMigration& mm,
-                         const deme_map_t& deme_map,
-                         uint32_t t,
-                         std::vector<std::size_t>& buffer,
+                         std::uint32_t t, deme_partition& partition,
+                         std::vector<std::size_t>& deme_sizes,
                          std::vector<METADATATYPE>& metadata)
+            // NOTE: the "label" field does not change, in case
+            // someone is tracking parents during a simulation.
             {
-                auto deme_itr = deme_map.find(mm.source);
-                if (deme_itr == end(deme_map))
+                auto source_size = partition.size(mm.source);
+                if (source_size == 0)
                     {
                         std::ostringstream o;
                         o << "copies from empty deme " << mm.source
                           << " at time " << t << " attempted";
                         throw DemographyError(o.str());
                     }
-                if (mm.fraction < 1.)
-                    {
-                        std::size_t destination_size = std::round(
-                            static_cast<double>(deme_itr->second.size())
-                            * mm.fraction);
-                        buffer.resize(destination_size);
-                        // Cannot choose an individual 2x to copy to
-                        // the same destination.
-                        int rv = gsl_ran_choose(
-                            rng.get(), buffer.data(), destination_size,
-                            const_cast<std::size_t*>(deme_itr->second.data()),
-                            deme_itr->second.size(), sizeof(std::size_t));
-                        if (rv != GSL_SUCCESS)
-                            {
-                                throw std::runtime_error(
-                                    "MassMigration error: gsl_ran_choose "
-                                    "returned "
-                                    "failure");
-                            }
-                        copy_individuals(buffer, mm.destination, metadata);
-                    }
-                else // entire deme is copied.
-                    {
-                        copy_individuals(deme_itr->second, mm.destination,
-                                         metadata);
-                    }
-            }
-
-            inline void
-            move_from_stack(std::int32_t destination, std::size_t n,
-                            std::vector<std::int32_t>& moves, move_stack& ms)
-            {
-                for (std::size_t i = 0; i < n && !ms.ms.empty(); ++i)
+                auto n = number_to_sample(mm, source_size);
+                auto first = partition.begin(mm.source);
+                // Cannot choose an individual 2x to copy to
+                // the same destination.
+                partial_shuffle(rng, first, source_size, n);
+                // Copies are added in the order of their
+                // parents in metadata.
+                std::sort(first, first + n);
+                metadata.reserve(metadata.size() + n);
+                for (std::size_t i = 0; i < n; ++i)
                     {
-                        auto val = ms.ms.top();
-                        if (moves[val] != -1)
-                            {
-                                throw std::runtime_error(
-                                    "MassMigration error: individual has "
-                                    "already "
-                                    "moved");
-                            }
-                        moves[val] = destination;
-                        ms.ms.pop();
+                        metadata.push_back(metadata[first[i]]);
+                        metadata.back().deme = mm.destination;
                     }
+                deme_sizes[mm.destination] += n;
             }
 
+            template <typename METADATATYPE>
             inline void
-            apply_moves(const MassMigration& mm,
-                        std::uint32_t t, std::vector<std::int32_t>& moves,
-                        move_map_t& move_source)
+            apply_moves(const GSLrng_t& rng, const MassMigration& mm,
+                        std::uint32_t t, deme_partition& partition,
+                        std::vector<std::size_t>& deme_sizes,
+                        std::vector<METADATATYPE>& metadata)
+            // The fraction moved is with respect to the deme size
+            // before any moves at time t.  Individuals can only
+            // move once, so later events may move fewer individuals
+            // than requested.
             {
-                auto deme_itr = move_source.find(mm.source);
-                if (deme_itr == end(move_source))
+                auto source_size = partition.size(mm.source);
+                if (source_size == 0)
                     {
                         std::ostringstream o;
                         o << "moves from empty deme " << mm.source
                           << " at time " << t << " attempted";
                         throw DemographyError(o.str());
                     }
-                if (mm.fraction < 1.0)
-                    {
-                        std::size_t destination_size = std::round(
-                            static_cast<double>(deme_itr->second.initial_N)
-                            * mm.fraction);
-                        move_from_stack(mm.destination, destination_size,
-                                        moves, deme_itr->second);
-                    }
-                else // entire deme moves
+                auto& moved = partition.moved[mm.source];
+                auto n = std::min(number_to_sample(mm, source_size),
+                                  source_size - moved);
+                auto first = partition.begin(mm.source) + moved;
+                partial_shuffle(rng, first, source_size - moved, n);
+                for (std::size_t i = 0; i < n; ++i)
                     {
-                        move_from_stack(mm.destination,
-                                        deme_itr->second.initial_N, moves,
-                                        deme_itr->second);
+                        metadata[first[i]].deme = mm.destination;
                     }
+                moved += n;
+                deme_sizes[mm.source] -= n;
+                deme_sizes[mm.destination] += n;
             }
 
+            enum class growth_change : std::int8_t
+            {
+                none,
+                changed,
+                reset
+            };
+
             inline void
-            update_changed_and_reset(
-                const MassMigration& mm,
-                std::unordered_map<std::int32_t, bool>& changed_and_reset)
+            update_changed_and_reset(const MassMigration& mm,
+                                     std::vector<growth_change>& changed_and_reset)
             {
-                if (mm.resets_growth_rate == true)
+                for (auto deme : {mm.source, mm.destination})
                     {
-                        changed_and_reset[mm.source] = true;
-                        changed_and_reset[mm.destination] = true;
-                    }
-                else
-                    {
-                        auto itr = changed_and_reset.find(mm.source);
-                        if (itr == end(changed_and_reset))
+                        if (mm.resets_growth_rate == true)
                             {
-                                changed_and_reset[mm.source] = false;
+                                changed_and_reset[deme] = growth_change::reset;
                             }
-                        itr = changed_and_reset.find(mm.destination);
-                        if (itr == end(changed_and_reset))
+                        else if (changed_and_reset[deme] == growth_change::none)
                             {
-                                changed_and_reset[mm.destination] = false;
+                                changed_and_reset[deme] = growth_change::changed;
                             }
                     }
             }
 
-            inline std::unordered_map<std::int32_t, std::size_t>
-            get_deme_sizes(const deme_map_t& deme_map)
-            {
-                std::unordered_map<std::int32_t, std::size_t> rv;
-                for (auto&& i : deme_map)
-                    {
-                        rv.emplace(i.first, i.second.size());
-                    }
-                return rv;
-            }
-
-            template <typename METADATATYPE>
-            inline std::unordered_map<std::int32_t, std::size_t>
-            update_metadata_due_to_moves_and_copies(
-                const std::size_t initial_N, const deme_map_t& deme_map,
-                const std::vector<std::int32_t>& moves,
-                std::vector<METADATATYPE>& metadata)
+            template <typename METADATATYPE, typename ITERATOR>
+            inline std::size_t
+            number_of_demes(const std::vector<METADATATYPE>& metadata,
+                            std::uint32_t t, ITERATOR beg, const ITERATOR end)
+            // One more than the largest deme index in metadata
+            // or in the events at time t.
             {
-                auto deme_sizes = detail::get_deme_sizes(deme_map);
-                // If there are moves, update the metadata and the deme sizes
-                for (std::size_t m = 0; m < moves.size(); ++m)
+                std::int32_t max_deme = 0;
+                for (auto& md : metadata)
                     {
-                        if (moves[m] != -1)
+                        if (md.deme < 0)
                             {
-                                auto itr = deme_sizes.find(metadata[m].deme);
-                                if (itr == deme_sizes.end())
-                                    {
-                                        throw std::runtime_error(
-                                            "MassMigration error: deme not in "
-                                            "lookup "
-                                            "table");
-                                    }
-                                if (itr->second == 0)
-                                    {
-                                        throw std::runtime_error(
-                                            "MassMigration error: deme size "
-                                            "in "
-                                            "lookup "
-                                            "table is zero during moves");
-                                    }
-                                itr->second--;
-                                metadata[m].deme = moves[m];
-                                deme_sizes[moves[m]]++;
+                                throw std::runtime_error(
+                                    "MassMigration error: negative deme "
+                                    "in metadata");
                             }
+                        max_deme = std::max(max_deme, md.deme);
                     }
-                for (std::size_t i = initial_N; i < metadata.size(); ++i)
+                for (; beg < end && beg->when == t; ++beg)
                     {
-                        deme_sizes[metadata[i].deme]++;
+                        max_deme = std::max(max_deme,
+                                            std::max(beg->source, beg->destination));
                     }
-                return deme_sizes;
+                return static_cast<std::size_t>(max_deme) + 1;
             }
 
             inline void
             update_growth_parameters(
-                std::uint32_t t,
-                const std::unordered_map<std::int32_t, std::size_t>&
-                    final_deme_sizes,
-                const std::unordered_map<std::int32_t, bool>&
-                    changed_and_reset,
+                std::uint32_t t, const std::vector<std::size_t>& final_deme_sizes,
+                const std::vector<growth_change>& changed_and_reset,
                 growth_rates_vector& growth_rates,
                 growth_rates_onset_times_vector& growth_rate_onset_times,
                 growth_initial_size_vector& growth_initial_sizes)
             {
-                for (auto&& cr : changed_and_reset)
+                for (std::size_t deme = 0; deme < changed_and_reset.size(); ++deme)
                     {
-                        auto fds = final_deme_sizes.find(cr.first);
-                        if (fds == final_deme_sizes.end())
+                        if (changed_and_reset[deme] == growth_change::none)
                             {
-                                throw std::runtime_error(
-                                    "MassMigration error: changed_and_reset "
-                                    "key "
-                                    "not found in final_deme_sizes");
+                                continue;
                             }
-                        // NOTE: fds->second is size_t, but deme sizes
-                        // are uint32_t so we have to check for overflow
-                        if (fds->second
+                        // NOTE: deme sizes are size_t here, but are uint32_t
+                        // elsewhere, so we have to check for overflow
+                        if (final_deme_sizes[deme]
                             >= std::numeric_limits<std::uint32_t>::max())
                             {
                                 throw std::runtime_error(
                                     "MassMigration error: deme size overflow");
                             }
-                        if (cr.second == true)
+                        if (changed_and_reset[deme] == growth_change::reset)
                             {
-                                growth_rates.get()[cr.first] = NOGROWTH;
+                                growth_rates.get()[deme] = NOGROWTH;
                             }
-                        growth_rate_onset_times.get()[fds->first] = t;
-                        growth_initial_sizes.get()[fds->first] = fds->second;
+                        growth_rate_onset_times.get()[deme] = t;
+                        growth_initial_sizes.get()[deme] = final_deme_sizes[deme];
                     }
             }
         } // namespace detail
@@ -328,7 +278,14 @@ namespace fwdpy11
             growth_initial_size_vector& growth_initial_sizes,
             std::vector<METADATATYPE>& metadata)
         // Simultaneous application of all mass migration events
-        // occurring at time t
+        // occurring at time t.
+        //
+        // Individuals are partitioned by deme once, with a counting
+        // sort.  Each event then samples only the individuals that it
+        // copies or moves, via a partial Fisher-Yates shuffle of the
+        // source deme's partition.  The cost is linear in the number
+        // of individuals plus the number sampled, and does not depend
+        // on the number of demes that are not involved in an event.
         {
             if (beg < end && beg->when != t)
                 {
@@ -336,16 +293,17 @@ namespace fwdpy11
                     // or is not necessary at all?
                     return beg;
                 }
-            std::vector<METADATATYPE> copies;
-            const std::size_t initial_N = metadata.size();
-            std::vector<std::int32_t> moves;
-            auto deme_map = detail::build_deme_map(metadata);
-            std::vector<std::size_t> buffer;
-            detail::move_map_t move_source;
+            const auto ndemes = detail::number_of_demes(metadata, t, beg, end);
+            auto partition = detail::build_deme_partition(metadata, ndemes);
+            std::vector<std::size_t> deme_sizes(ndemes);
+            for (std::size_t deme = 0; deme < ndemes; ++deme)
+                {
+                    deme_sizes[deme] = partition.size(deme);
+                }
+            std::vector<detail::growth_change> changed_and_reset(
+                ndemes, detail::growth_change::none);
             bool initialized_moves = false;
             ITERATOR i = beg;
-
-            std::unordered_map<std::int32_t, bool> changed_and_reset;
             for (; i < end && i->when == t; ++i)
                 {
                     if (i->move_individuals == false) //copy
@@ -357,32 +315,20 @@ namespace fwdpy11
                                         "MassMigration error: copies after "
                                         "moves");
                                 }
-                            detail::apply_copies(rng, *i, deme_map, t, buffer,
+                            detail::apply_copies(rng, *i, t, partition, deme_sizes,
                                                  metadata);
-                            detail::update_changed_and_reset(
-                                *i, changed_and_reset);
                         }
                     else //move
                         {
-                            if (initialized_moves == false)
-                                {
-                                    moves.resize(initial_N, -1);
-                                    move_source = detail::build_move_sources(
-                                        rng, deme_map);
-                                    initialized_moves = true;
-                                }
-                            detail::apply_moves(*i, t, moves,
-                                                move_source);
-                            detail::update_changed_and_reset(
-                                *i, changed_and_reset);
+                            initialized_moves = true;
+                            detail::apply_moves(rng, *i, t, partition, deme_sizes,
+                                                metadata);
                         }
+                    detail::update_changed_and_reset(*i, changed_and_reset);
                 }
-            auto final_deme_sizes
-                = detail::update_metadata_due_to_moves_and_copies(
-                    initial_N, deme_map, moves, metadata);
-            detail::update_growth_parameters(
-                t, final_deme_sizes, changed_and_reset, growth_rates,
-                growth_rate_onset_times, growth_initial_sizes);
+            detail::update_growth_parameters(t, deme_sizes, changed_and_reset,
+                                             growth_rates, growth_rate_onset_times,
+                                             growth_initial_sizes);
             return i;
         }
     } // namespace discrete_demography
@@ -33,23 +33,64 @@ namespace fwdpy11
 {
     namespace discrete_demography
     {
+        namespace detail
+        {
+            inline bool
+            row_inputs_changed(const MigrationMatrix& M, std::size_t dest,
+                               const std::vector<std::uint32_t>& sizes,
+                               const std::vector<std::uint32_t>& built_sizes)
+            // Scaled rates depend on the source deme sizes.
+            // Otherwise, only whether a deme is empty matters.
+            {
+                if ((sizes[dest] == 0) != (built_sizes[dest] == 0))
+                    {
+                        return true;
+                    }
+                for (std::size_t j = M.row_offsets[dest]; j < M.row_offsets[dest + 1];
+                     ++j)
+                    {
+                        auto source = M.columns[j];
+                        if (M.scaled ? sizes[source] != built_sizes[source]
+                                     : (sizes[source] == 0)
+                                           != (built_sizes[source] == 0))
+                            {
+                                return true;
+                            }
+                    }
+                return false;
+            }
+        } // namespace detail
+
         inline void
         build_migration_lookup(
             const std::unique_ptr<MigrationMatrix>& M,
             const current_deme_sizes_vector& current_deme_sizes,
             migration_lookup& ml)
+        // Only the non-zero entries of each row of M
+        // are visited, so the cost is O(number of non-zero
+        // rates) rather than O(npops^2).  Rows whose rates
+        // and source deme sizes are unchanged since the last
+        // call are skipped.
         {
             if (M != nullptr)
                 {
                     std::vector<double> temp;
                     std::size_t npops = ml.lookups.size();
-                    temp.reserve(npops);
                     const auto& ref = current_deme_sizes.get();
                     for (std::size_t dest = 0; dest < npops; ++dest)
                         {
-                            for (std::size_t source = 0; source < npops;
-                                 ++source)
+                            if (!ml.stale[dest]
+                                && !detail::row_inputs_changed(*M, dest, ref,
+                                                               ml.built_sizes))
+                                {
+                                    continue;
+                                }
+                            auto& sources = ml.sources[dest];
+                            sources.clear();
+                            for (std::size_t j = M->row_offsets[dest];
+                                 j < M->row_offsets[dest + 1]; ++j)
                                 {
+                                    auto source = M->columns[j];
                                     // By default, input migration rates are
                                     // weighted by the current deme size...
                                     double scaling_factor
@@ -62,8 +103,7 @@ namespace fwdpy11
                                         {
                                             scaling_factor = 1.0;
                                         }
-                                    double rate_in
-                                        = M->M[dest * npops + source];
+                                    double rate_in = M->values[j];
                                     if (rate_in > 0.
                                         && (ref[source] == 0
                                             || ref[dest] == 0))
@@ -92,11 +132,14 @@ namespace fwdpy11
                                                         "destination deme");
                                                 }
                                         }
-                                    temp.push_back(scaling_factor * rate_in);
+                                    if (scaling_factor * rate_in != 0.)
+                                        {
+                                            temp.push_back(scaling_factor * rate_in);
+                                            sources.push_back(
+                                                static_cast<std::int32_t>(source));
+                                        }
                                 }
-                            if (std::find_if(begin(temp), end(temp),
-                                             [](double d) { return d != 0.; })
-                                != end(temp))
+                            if (!temp.empty())
                                 {
                                     ml.lookups[dest].reset(
                                         gsl_ran_discrete_preproc(temp.size(),
@@ -107,7 +150,9 @@ namespace fwdpy11
                                     ml.lookups[dest].reset(nullptr);
                                 }
                             temp.clear();
+                            ml.stale[dest] = 0;
                         }
+                    std::copy(begin(ref), end(ref), begin(ml.built_sizes));
                 }
         }
     } // namespace discrete_demography
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <cstdint>
+#include <limits>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include "get_max_number_of_demes.hpp"
 #include "multideme_fitness_lookups.hpp"
@@ -51,6 +52,21 @@ namespace fwdpy11
             std::uint32_t next_global_N;
 
           public:
+            // These members let a generation without events skip
+            // the work of applying them.  They are not part of
+            // the pickled state.
+            //
+            // next_event_time is the earliest time of a pending event.
+            // next_sizes_generation is the generation when
+            // next_deme_sizes were last calculated, or max() if never.
+            // sizes_carried_over is true if current_deme_sizes
+            // were set from next_deme_sizes rather than counted.
+            // sizes_changing is true if any deme has a growth rate or
+            // if next_deme_sizes differ from current_deme_sizes.
+            std::uint32_t next_event_time;
+            std::uint32_t next_sizes_generation;
+            bool sizes_carried_over;
+            bool sizes_changing;
             const std::int32_t maxdemes;
             multideme_fitness_lookups<std::uint32_t> fitnesses;
             deme_properties sizes_rates;
@@ -62,7 +78,9 @@ namespace fwdpy11
             template <typename METADATATYPE>
             demographic_model_state(const std::vector<METADATATYPE>& metadata,
                                     DiscreteDemography& demography)
-                : next_global_N(0),
+                : next_global_N(0), next_event_time(0),
+                  next_sizes_generation(std::numeric_limits<std::uint32_t>::max()),
+                  sizes_carried_over(false), sizes_changing(true),
                   maxdemes(get_max_number_of_demes()(metadata, demography)),
                   fitnesses(maxdemes), sizes_rates(maxdemes, metadata),
                   M(init_migmatrix(demography.migmatrix)),
@@ -75,7 +93,10 @@ namespace fwdpy11
             // instance.
             demographic_model_state(std::int32_t maxdemes_, deme_properties sizes_rates_,
                                     std::unique_ptr<MigrationMatrix> M_)
-                : next_global_N(0), maxdemes(maxdemes_), fitnesses(maxdemes),
+                : next_global_N(0), next_event_time(0),
+                  next_sizes_generation(std::numeric_limits<std::uint32_t>::max()),
+                  sizes_carried_over(false), sizes_changing(true), maxdemes(maxdemes_),
+                  fitnesses(maxdemes),
                   sizes_rates(std::move(sizes_rates_)), M(std::move(M_)),
                   miglookup(maxdemes, M == nullptr)
             {
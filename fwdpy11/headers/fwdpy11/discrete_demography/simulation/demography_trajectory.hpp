@@ -0,0 +1,366 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_DISCRETE_DEMOGRAPHY_DEMOGRAPHY_TRAJECTORY_HPP
+#define FWDPY11_DISCRETE_DEMOGRAPHY_DEMOGRAPHY_TRAJECTORY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <fwdpy11/rng.hpp>
+#include "../DiscreteDemography.hpp"
+#include "deme_properties.hpp"
+#include "migration_lookup.hpp"
+#include "build_migration_lookup.hpp"
+#include "get_max_number_of_demes.hpp"
+#include "apply_mass_migrations.hpp"
+#include "functions.hpp"
+#include "update_demographic_model_state.hpp"
+
+namespace fwdpy11
+{
+    namespace discrete_demography
+    {
+        struct DemographyTrajectory
+        /// The state of a demographic model at each time
+        /// point when events happen.
+        ///
+        /// Per-deme values are stored row-major, with one row per
+        /// element of times and one column per deme.
+        /// parental_deme_sizes are the numbers of parents in
+        /// each deme, after any mass migrations at that time, and
+        /// offspring_deme_sizes are the sizes of the demes in
+        /// the next generation.  The migration matrix is stored,
+        /// dense, at the first time point and whenever it changes.
+        {
+            std::int32_t maxdemes;
+            std::vector<std::uint32_t> times;
+            std::vector<std::uint32_t> parental_deme_sizes;
+            std::vector<std::uint32_t> offspring_deme_sizes;
+            std::vector<double> growth_rates;
+            std::vector<std::uint32_t> growth_onset_times;
+            std::vector<std::uint32_t> growth_initial_sizes;
+            std::vector<double> selfing_rates;
+            std::vector<std::uint32_t> migration_times;
+            std::vector<double> migration_matrices;
+            // The generation t whose offspring are all extinct,
+            // meaning that deme_sizes(t) has a positive total and
+            // deme_sizes(t + 1) is all zeros.  This is one generation
+            // before the first one with no individuals.
+            // It is max() if the model does not go extinct.
+            std::uint32_t global_extinction_time;
+
+            explicit DemographyTrajectory(std::int32_t maxdemes_)
+                : maxdemes(maxdemes_), times{}, parental_deme_sizes{},
+                  offspring_deme_sizes{}, growth_rates{}, growth_onset_times{},
+                  growth_initial_sizes{}, selfing_rates{}, migration_times{},
+                  migration_matrices{},
+                  global_extinction_time(std::numeric_limits<std::uint32_t>::max())
+            {
+            }
+
+            void
+            record(std::uint32_t t, const std::vector<std::uint32_t>& parents,
+                   const deme_properties& sizes_rates)
+            {
+                times.push_back(t);
+                auto append = [](const auto& from, auto& to) {
+                    to.insert(end(to), begin(from), end(from));
+                };
+                append(parents, parental_deme_sizes);
+                append(sizes_rates.next_deme_sizes.get(), offspring_deme_sizes);
+                append(sizes_rates.growth_rates.get(), growth_rates);
+                append(sizes_rates.growth_rate_onset_times.get(), growth_onset_times);
+                append(sizes_rates.growth_initial_sizes.get(), growth_initial_sizes);
+                append(sizes_rates.selfing_rates.get(), selfing_rates);
+            }
+
+            deme_properties
+            state(std::size_t row) const
+            {
+                auto first = row * static_cast<std::size_t>(maxdemes);
+                auto last = first + maxdemes;
+                auto slice = [first, last](const auto& v) {
+                    return typename std::decay<decltype(v)>::type(begin(v) + first,
+                                                                  begin(v) + last);
+                };
+                return deme_properties(
+                    current_deme_sizes_vector(slice(parental_deme_sizes)),
+                    next_deme_sizes_vector(slice(offspring_deme_sizes)),
+                    growth_rates_onset_times_vector(slice(growth_onset_times)),
+                    growth_initial_size_vector(slice(growth_initial_sizes)),
+                    growth_rates_vector(slice(growth_rates)),
+                    selfing_rates_vector(slice(selfing_rates)));
+            }
+
+            std::vector<std::uint32_t> deme_sizes(std::uint32_t generation) const;
+        };
+
+        namespace detail
+        {
+            struct trajectory_metadata
+            // The fields of DiploidMetadata used by mass migrations.
+            {
+                std::int32_t deme;
+                std::size_t label;
+            };
+
+            inline std::uint32_t
+            grow_without_events(std::uint32_t t, deme_properties& sizes_rates)
+            // Given next_deme_sizes for some generation before t, and
+            // no events in between, set next_deme_sizes to their values
+            // at t.  Growth is a function of the onset time and initial
+            // size, so this does not have to visit each generation.
+            {
+                auto& Ncurr = sizes_rates.current_deme_sizes.get();
+                auto& Nnext = sizes_rates.next_deme_sizes.get();
+                std::copy(begin(Nnext), end(Nnext), begin(Ncurr));
+                return apply_growth_rates_get_next_global_N(t, sizes_rates);
+            }
+
+            inline std::uint32_t
+            first_extinct_generation(std::uint32_t first, std::uint32_t last,
+                                     const deme_properties& sizes_rates)
+            // The total size is positive after first - 1 and zero
+            // after last.  Sizes only reach zero by declining, so
+            // bisect for the first generation where the total is zero.
+            {
+                while (first < last)
+                    {
+                        auto mid = first + (last - first) / 2;
+                        auto temp(sizes_rates);
+                        if (grow_without_events(mid, temp) == 0)
+                            {
+                                last = mid;
+                            }
+                        else
+                            {
+                                first = mid + 1;
+                            }
+                    }
+                return first;
+            }
+
+            inline void
+            validate_parents(std::uint32_t t,
+                             const std::vector<std::uint32_t>& parental_deme_sizes,
+                             const deme_properties& sizes_rates,
+                             const std::unique_ptr<MigrationMatrix>& M)
+            // As validate_parental_state, with non-empty demes
+            // assumed to contain individuals with non-zero fitness.
+            // The parental deme sizes are those before SetDemeSize
+            // events are applied.
+            {
+                const auto& Nnext = sizes_rates.next_deme_sizes.get();
+                for (std::size_t i = 0; i < Nnext.size(); ++i)
+                    {
+                        if (Nnext[i] > 0 && parental_deme_sizes[i] == 0)
+                            {
+                                if (M == nullptr)
+                                    {
+                                        no_valid_parents(i, t, Nnext[i]);
+                                    }
+                                else
+                                    {
+                                        check_migration_in(i, t, M);
+                                    }
+                            }
+                    }
+            }
+        } // namespace detail
+
+        inline std::vector<std::uint32_t>
+        DemographyTrajectory::deme_sizes(std::uint32_t generation) const
+        // The parental deme sizes at a generation,
+        // which need not be one of the elements of times.
+        {
+            if (times.empty() || generation < times.front())
+                {
+                    throw std::invalid_argument(
+                        "generation is before the start of the trajectory");
+                }
+            auto row = static_cast<std::size_t>(
+                std::distance(begin(times),
+                              std::upper_bound(begin(times), end(times), generation))
+                - 1);
+            auto sizes_rates = state(row);
+            if (times[row] == generation)
+                {
+                    return sizes_rates.current_deme_sizes.get();
+                }
+            if (generation - 1 > times[row])
+                {
+                    detail::grow_without_events(generation - 1, sizes_rates);
+                }
+            return sizes_rates.next_deme_sizes.get();
+        }
+
+        inline DemographyTrajectory
+        evaluate_demography(const std::vector<std::uint32_t>& initial_deme_sizes,
+                            const DiscreteDemography& input_demography,
+                            std::uint32_t start, std::uint32_t last)
+        // Apply the events in a demographic model to deme sizes
+        // rather than to individuals, for the generations in
+        // [start, last].  Only the generations when events happen
+        // are visited.  Errors are reported via the same exceptions,
+        // and from the same code, as during a simulation.
+        {
+            if (initial_deme_sizes.empty())
+                {
+                    throw std::invalid_argument("initial deme sizes are empty");
+                }
+            if (last < start)
+                {
+                    throw std::invalid_argument("last generation is before start");
+                }
+            // Work on a copy so that the iterators of the input
+            // model are not affected.
+            std::unique_ptr<MigrationMatrix> Minput(nullptr);
+            if (input_demography.migmatrix != nullptr)
+                {
+                    Minput.reset(new MigrationMatrix(*input_demography.migmatrix));
+                }
+            DiscreteDemography demography(
+                input_demography.mass_migrations, input_demography.set_growth_rates,
+                input_demography.set_deme_sizes, input_demography.set_selfing_rates,
+                std::move(Minput), input_demography.set_migration_rates);
+            demography.update_event_times(start);
+
+            std::vector<detail::trajectory_metadata> metadata;
+            for (std::size_t i = 0; i < initial_deme_sizes.size(); ++i)
+                {
+                    metadata.push_back({static_cast<std::int32_t>(i), i});
+                }
+            const auto maxdemes = get_max_number_of_demes()(metadata, demography);
+            current_deme_sizes_vector::value_type N(maxdemes, 0);
+            std::copy(begin(initial_deme_sizes), end(initial_deme_sizes), begin(N));
+            deme_properties sizes_rates(
+                current_deme_sizes_vector(N),
+                next_deme_sizes_vector(next_deme_sizes_vector::value_type(maxdemes, 0)),
+                growth_rates_onset_times_vector(
+                    growth_rates_onset_times_vector::value_type(maxdemes, 0)),
+                growth_initial_size_vector(N),
+                growth_rates_vector(growth_rates_vector::value_type(maxdemes, NOGROWTH)),
+                selfing_rates_vector(selfing_rates_vector::value_type(maxdemes, 0.)));
+            std::unique_ptr<MigrationMatrix> M(nullptr);
+            if (demography.migmatrix != nullptr)
+                {
+                    M.reset(new MigrationMatrix(*demography.migmatrix));
+                }
+            migration_lookup miglookup(maxdemes, M == nullptr);
+            // Mass migrations sample individuals at random, but the
+            // numbers moved and copied do not depend on the seed.
+            GSLrng_t rng(42);
+
+            DemographyTrajectory rv(maxdemes);
+            auto t = start;
+            auto previous = start;
+            while (true)
+                {
+                    if (t != start)
+                        {
+                            if (t - 1 > previous)
+                                {
+                                    auto at_previous(sizes_rates);
+                                    if (detail::grow_without_events(t - 1, sizes_rates)
+                                        == 0)
+                                        {
+                                            rv.global_extinction_time
+                                                = detail::first_extinct_generation(
+                                                    previous + 1, t - 1, at_previous);
+                                            break;
+                                        }
+                                }
+                            auto& Nnext = sizes_rates.next_deme_sizes.get();
+                            std::copy(begin(Nnext), end(Nnext),
+                                      begin(sizes_rates.current_deme_sizes.get()));
+                        }
+                    auto migration_changes
+                        = t == start
+                          || (demography.migration_rate_change_tracker.get().first
+                                  < demography.migration_rate_change_tracker.get().second
+                              && demography.migration_rate_change_tracker.get()
+                                         .first->when
+                                     == t);
+                    const auto& mm = demography.mass_migration_tracker.get();
+                    if (mm.first < mm.second && mm.first->when == t)
+                        {
+                            metadata.clear();
+                            const auto& Ncurr = sizes_rates.current_deme_sizes.get();
+                            for (std::size_t deme = 0; deme < Ncurr.size(); ++deme)
+                                {
+                                    for (std::uint32_t i = 0; i < Ncurr[deme]; ++i)
+                                        {
+                                            metadata.push_back(
+                                                {static_cast<std::int32_t>(deme),
+                                                 metadata.size()});
+                                        }
+                                }
+                            mass_migration(rng, t, demography.mass_migration_tracker,
+                                           sizes_rates.growth_rates,
+                                           sizes_rates.growth_rate_onset_times,
+                                           sizes_rates.growth_initial_sizes, metadata);
+                            get_current_deme_sizes(metadata,
+                                                   sizes_rates.current_deme_sizes);
+                        }
+                    auto parental_deme_sizes = sizes_rates.current_deme_sizes.get();
+                    auto next_global_N = apply_demographic_events(t, demography, M,
+                                                                  miglookup, sizes_rates);
+                    build_migration_lookup(M, sizes_rates.current_deme_sizes, miglookup);
+                    detail::validate_parents(t, parental_deme_sizes, sizes_rates, M);
+                    rv.record(t, parental_deme_sizes, sizes_rates);
+                    if (M != nullptr && migration_changes)
+                        {
+                            auto dense = M->dense();
+                            rv.migration_times.push_back(t);
+                            rv.migration_matrices.insert(end(rv.migration_matrices),
+                                                         begin(dense), end(dense));
+                        }
+                    if (next_global_N == 0)
+                        {
+                            rv.global_extinction_time = t;
+                            break;
+                        }
+                    previous = t;
+                    t = demography.next_event_time();
+                    if (t == std::numeric_limits<std::uint32_t>::max() || t > last)
+                        {
+                            // Is there extinction between the last
+                            // event and the end?
+                            if (last != std::numeric_limits<std::uint32_t>::max()
+                                && last > previous
+                                && detail::grow_without_events(last, sizes_rates) == 0)
+                                {
+                                    auto at_previous = rv.state(rv.times.size() - 1);
+                                    rv.global_extinction_time
+                                        = detail::first_extinct_generation(
+                                            previous + 1, last, at_previous);
+                                }
+                            break;
+                        }
+                }
+            return rv;
+        }
+    } // namespace discrete_demography
+} // namespace fwdpy11
+
+#endif
@@ -25,6 +25,7 @@
 #include "../MassMigration.hpp"
 #include "../DiscreteDemography.hpp"
 #include "deme_properties.hpp"
+#include "migration_lookup.hpp"
 
 namespace fwdpy11
 {
@@ -156,8 +157,9 @@ namespace fwdpy11
             update_migration_matrix(
                 const std::uint32_t t,
                 migration_rate_change_range& migration_rate_change_tracker,
-                std::unique_ptr<MigrationMatrix>& M)
-
+                std::unique_ptr<MigrationMatrix>& M, migration_lookup& miglookup)
+            // Rows that change are marked so that build_migration_lookup
+            // rebuilds their parental deme lookup tables.
             {
                 auto& range = migration_rate_change_tracker.get();
                 if (range.first < range.second && t < range.first->when)
@@ -167,8 +169,26 @@ namespace fwdpy11
                 for (; range.first < range.second && range.first->when == t;
                      ++range.first)
                     {
-                        M->set_migration_rates(range.first->deme,
-                                               range.first->migrates);
+                        if (range.first->sparse_row())
+                            {
+                                M->set_migration_rates(range.first->deme,
+                                                       range.first->indices,
+                                                       range.first->migrates);
+                                miglookup.mark_stale(range.first->deme);
+                            }
+                        else if (range.first->sparse())
+                            {
+                                M->set_migration_rates(range.first->indptr,
+                                                       range.first->indices,
+                                                       range.first->migrates);
+                                miglookup.mark_stale(NULLDEME);
+                            }
+                        else
+                            {
+                                M->set_migration_rates(range.first->deme,
+                                                       range.first->migrates);
+                                miglookup.mark_stale(range.first->deme);
+                            }
                     }
             }
 
@@ -218,6 +238,7 @@ namespace fwdpy11
         apply_demographic_events(std::uint32_t t,
                                  DiscreteDemography& demography,
                                  std::unique_ptr<MigrationMatrix>& M,
+                                 migration_lookup& miglookup,
                                  deme_properties& sizes_rates)
         {
             std::copy(begin(sizes_rates.current_deme_sizes.get()),
@@ -235,7 +256,7 @@ namespace fwdpy11
             detail::update_selfing_rates(
                 t, demography.selfing_rate_change_tracker, sizes_rates);
             detail::update_migration_matrix(
-                t, demography.migration_rate_change_tracker, M);
+                t, demography.migration_rate_change_tracker, M, miglookup);
             // Step 4: set next deme sizes and apply growth rates
             std::copy(begin(sizes_rates.current_deme_sizes.get()),
                       end(sizes_rates.current_deme_sizes.get()),
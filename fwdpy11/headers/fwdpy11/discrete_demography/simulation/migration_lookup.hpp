@@ -20,6 +20,7 @@
 #ifndef FWDPY11_MIGRATION_LOOKUP_HPP
 #define FWDPY11_MIGRATION_LOOKUP_HPP
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 #include <fwdpp/gsl_discrete.hpp>
@@ -29,13 +30,41 @@ namespace fwdpy11
     namespace discrete_demography
     {
         struct migration_lookup
+        /// lookups[i] samples an index into sources[i],
+        /// which holds the possible parental demes of
+        /// offspring in deme i.  Both scale with the number
+        /// of non-zero migration rates into deme i.
+        ///
+        /// The table for deme i is only rebuilt when row i
+        /// of the migration matrix is marked as stale or
+        /// when the size of a deme in that row differs from
+        /// built_sizes, which records the sizes used at the
+        /// last build.
         {
             std::vector<fwdpp::gsl_ran_discrete_t_ptr> lookups;
+            std::vector<std::vector<std::int32_t>> sources;
+            std::vector<std::uint32_t> built_sizes;
+            std::vector<std::uint8_t> stale;
             const bool null_migmatrix;
             migration_lookup(std::int32_t maxdemes, bool isnull)
-                : lookups(maxdemes), null_migmatrix(isnull)
+                : lookups(maxdemes), sources(maxdemes), built_sizes(maxdemes, 0),
+                  stale(maxdemes, 1), null_migmatrix(isnull)
             {
             }
+
+            void
+            mark_stale(std::int32_t row)
+            // NULLDEME marks every row.
+            {
+                if (row < 0)
+                    {
+                        std::fill(begin(stale), end(stale), 1);
+                    }
+                else
+                    {
+                        stale[row] = 1;
+                    }
+            }
         };
         } // namespace discrete_demography
 } // namespace fwdpy11
@@ -33,23 +33,36 @@ namespace fwdpy11
     namespace discrete_demography
     {
         template <typename T> struct multideme_fitness_lookups
+        /// Individuals are grouped by deme.  The fitnesses
+        /// and labels of deme i's members are stored in
+        /// [starts[i], stops[i]).
+        ///
+        /// A deme's lookup table is only rebuilt when its
+        /// size or members' fitnesses/labels change.  When all
+        /// members of a deme have the same, positive, fitness,
+        /// parents are drawn uniformly and no table is built.
         {
             std::vector<T> starts, stops, offsets;
             std::vector<double> fitnesses;
             std::vector<std::uint32_t> individuals;
             std::vector<fwdpp::gsl_ran_discrete_t_ptr> lookups;
+            std::vector<std::uint8_t> uniform, changed;
 
             multideme_fitness_lookups(std::int32_t max_number_demes)
                 : starts(max_number_demes, 0), stops(max_number_demes, 0),
                   offsets(max_number_demes, 0), fitnesses(), individuals(),
-                  lookups(max_number_demes)
+                  lookups(max_number_demes), uniform(max_number_demes, 0),
+                  changed(max_number_demes, 0)
             {
             }
 
             template <typename METADATATYPE>
             void
             update(const current_deme_sizes_vector& deme_sizes,
-                   const std::vector<METADATATYPE>& metadata)
+                   const std::vector<METADATATYPE>& metadata,
+                   const std::vector<double>* weights = nullptr)
+            // If weights is not nullptr, the fitness of metadata[j]
+            // is multiplied by (*weights)[j].
             {
                 auto& deme_sizes_ref = deme_sizes.get();
                 fitnesses.resize(std::accumulate(begin(deme_sizes_ref),
@@ -57,22 +70,58 @@ namespace fwdpy11
                                  -1.0);
                 individuals.resize(fitnesses.size(),
                                    std::numeric_limits<std::uint32_t>::max());
-                std::fill(begin(fitnesses), end(fitnesses),
-                          -1); // TODO: remove
+                // A deme whose range moved must be rebuilt.
+                // Otherwise, the contents of the range are
+                // compared as they are overwritten.
+                std::copy(begin(stops), end(stops), begin(offsets));
                 std::partial_sum(begin(deme_sizes_ref), end(deme_sizes_ref),
                                  begin(stops));
+                for (std::size_t i = 0; i < stops.size(); ++i)
+                    {
+                        changed[i] = (stops[i] != offsets[i]);
+                    }
                 std::copy(begin(stops), end(stops) - 1, begin(starts) + 1);
+                for (std::size_t i = 1; i < starts.size(); ++i)
+                    {
+                        changed[i] |= (starts[i] != offsets[i - 1]);
+                    }
                 std::fill(begin(offsets), end(offsets), 0);
-                for (auto&& md : metadata)
+                for (std::size_t j = 0; j < metadata.size(); ++j)
                     {
+                        const auto& md = metadata[j];
                         auto i = starts[md.deme] + offsets[md.deme];
-                        fitnesses[i] = md.w;
-                        individuals[i] = md.label;
+                        auto w = (weights == nullptr) ? md.w : md.w * (*weights)[j];
+                        if (fitnesses[i] != w || individuals[i] != md.label)
+                            {
+                                changed[md.deme] = 1;
+                                fitnesses[i] = w;
+                                individuals[i] = md.label;
+                            }
                         offsets[md.deme]++;
                     }
                 for (std::size_t i = 0; i < starts.size(); ++i)
                     {
-                        if (deme_sizes_ref[i] > 0)
+                        if (deme_sizes_ref[i] == 0)
+                            {
+                                uniform[i] = 0;
+                                lookups[i].reset(nullptr);
+                                continue;
+                            }
+                        if (!changed[i])
+                            {
+                                continue;
+                            }
+                        auto first = fitnesses.begin() + starts[i];
+                        auto last = fitnesses.begin() + stops[i];
+                        uniform[i] = (*first > 0.
+                                      && std::all_of(first + 1, last, [first](double w) {
+                                             return w == *first;
+                                         }));
+                        if (uniform[i])
+                            {
+                                lookups[i].reset(nullptr);
+                            }
+                        else
                             {
                                 // NOTE: the size of the i-th deme's
                                 // fitness array is starts[i]-stops[i]
@@ -80,13 +129,15 @@ namespace fwdpy11
                                     stops[i] - starts[i],
                                     fitnesses.data() + starts[i]));
                             }
-                        else
-                            {
-                                lookups[i].reset(nullptr);
-                            }
                     }
             }
 
+            bool
+            has_parents(const std::int32_t deme) const
+            {
+                return uniform[deme] || lookups[deme] != nullptr;
+            }
+
             T
             get_parent(const GSLrng_t& rng,
                        const current_deme_sizes_vector& deme_sizes,
@@ -96,6 +147,12 @@ namespace fwdpy11
                     {
                         throw EmptyDeme("parental deme is empty");
                     }
+                if (uniform[deme])
+                    {
+                        return individuals[starts[deme]
+                                           + gsl_rng_uniform_int(
+                                               rng.get(), stops[deme] - starts[deme])];
+                    }
                 auto o = gsl_ran_discrete(rng.get(), lookups[deme].get());
                 return individuals[starts[deme] + o];
             }
@@ -45,6 +45,22 @@ namespace fwdpy11
             }
         };
 
+        inline std::int32_t
+        pick_parental_deme(const GSLrng_t& rng, const std::int32_t offspring_deme,
+                           const migration_lookup& miglookup)
+        {
+            if (miglookup.null_migmatrix) // Model has no migration
+                {
+                    return offspring_deme;
+                }
+            if (miglookup.lookups[offspring_deme] == nullptr)
+                {
+                    throw DemographyError("parental deme lookup is NULL");
+                }
+            return miglookup.sources[offspring_deme][gsl_ran_discrete(
+                rng.get(), miglookup.lookups[offspring_deme].get())];
+        }
+
         inline parent_data
         pick_parents(const GSLrng_t& rng, const std::int32_t offspring_deme,
                      const migration_lookup& miglookup,
@@ -68,12 +84,7 @@ namespace fwdpy11
                     return { p1, p2, offspring_deme, offspring_deme,
                              mating_event_type::outcrossing };
                 }
-            if (miglookup.lookups[offspring_deme] == nullptr)
-                {
-                    throw DemographyError("parental deme lookup is NULL");
-                }
-            std::int32_t pdeme = static_cast<std::int32_t>(gsl_ran_discrete(
-                rng.get(), miglookup.lookups[offspring_deme].get()));
+            std::int32_t pdeme = pick_parental_deme(rng, offspring_deme, miglookup);
 
             auto p1 = wlookups.get_parent(rng, current_deme_sizes, pdeme);
             if (selfing_rates.get()[pdeme] > 0.
@@ -19,6 +19,8 @@
 #ifndef FWDPY11_UPDATE_DEMOGRAPHY_MANAGER_HPP
 #define FWDPY11_UPDATE_DEMOGRAPHY_MANAGER_HPP
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <fwdpy11/rng.hpp>
@@ -44,7 +46,7 @@ namespace fwdpy11
             check_migration_in(std::size_t i, std::uint32_t generation,
                                const std::unique_ptr<MigrationMatrix> &M)
             {
-                if (M->M[i * M->npops + i] > 0)
+                if (M->rate(i, i) > 0)
                     {
                         std::ostringstream o;
                         o << "deme " << i << " at time " << generation
@@ -67,7 +69,7 @@ namespace fwdpy11
                 for (std::size_t i = 0; i < next_N_deme.size(); ++i)
                     {
                         if (next_N_deme[i] > 0
-                            && current_demographic_state.fitnesses.lookups[i] == nullptr)
+                            && !current_demographic_state.fitnesses.has_parents(i))
                             {
                                 if (current_demographic_state.M == nullptr)
                                     {
@@ -82,6 +84,18 @@ namespace fwdpy11
                     }
             }
 
+            inline bool
+            sizes_changing(const deme_properties &sizes_rates)
+            // If false, the next generation will have the
+            // same deme sizes as the current one, and so will
+            // the generations after it until the next event.
+            {
+                const auto &G = sizes_rates.growth_rates.get();
+                return std::any_of(begin(G), end(G),
+                                   [](double g) { return g != NOGROWTH; })
+                       || sizes_rates.next_deme_sizes.get()
+                              != sizes_rates.current_deme_sizes.get();
+            }
         } // namespace detail
 
         template <typename METADATATYPE>
@@ -90,14 +104,29 @@ namespace fwdpy11
             const GSLrng_t &rng, const std::uint32_t generation,
             std::vector<METADATATYPE> &metadata, DiscreteDemography &demography,
             demographic_model_state &current_demographic_state)
+        // If there are no mass migrations, and metadata are the
+        // offspring generated from the deme sizes calculated
+        // at the previous generation, then the deme sizes are
+        // copied rather than counted.
         {
+            auto &sizes_rates = current_demographic_state.sizes_rates;
+            const auto &mm = demography.mass_migration_tracker.get();
+            if ((mm.first == mm.second || mm.first->when != generation)
+                && current_demographic_state.next_sizes_generation
+                       != std::numeric_limits<std::uint32_t>::max()
+                && current_demographic_state.next_sizes_generation + 1 == generation)
+                {
+                    std::copy(begin(sizes_rates.next_deme_sizes.get()),
+                              end(sizes_rates.next_deme_sizes.get()),
+                              begin(sizes_rates.current_deme_sizes.get()));
+                    current_demographic_state.sizes_carried_over = true;
+                    return;
+                }
             mass_migration(rng, generation, demography.mass_migration_tracker,
-                           current_demographic_state.sizes_rates.growth_rates,
-                           current_demographic_state.sizes_rates.growth_rate_onset_times,
-                           current_demographic_state.sizes_rates.growth_initial_sizes,
-                           metadata);
-            get_current_deme_sizes(
-                metadata, current_demographic_state.sizes_rates.current_deme_sizes);
+                           sizes_rates.growth_rates, sizes_rates.growth_rate_onset_times,
+                           sizes_rates.growth_initial_sizes, metadata);
+            get_current_deme_sizes(metadata, sizes_rates.current_deme_sizes);
+            current_demographic_state.sizes_carried_over = false;
         }
 
         template <typename METADATATYPE>
@@ -105,19 +134,46 @@ namespace fwdpy11
         finalize_demographic_state(const std::uint32_t generation,
                                    std::vector<METADATATYPE> &metadata,
                                    DiscreteDemography &demography,
-                                   demographic_model_state &current_demographic_state)
+                                   demographic_model_state &current_demographic_state,
+                                   const std::vector<double> *fitness_weights = nullptr)
+        // Between events, deme sizes only change due to growth,
+        // so the event ranges are not checked and only the growth
+        // rates are applied.  When the sizes are not changing, the
+        // deme sizes, rates, and migration lookup tables are the same
+        // as in the previous generation, and only the fitness lookups
+        // and the check for valid parents are updated.
+        // If fitness_weights is not nullptr, parents are chosen with
+        // probability proportional to metadata[j].w * (*fitness_weights)[j].
         {
-            current_demographic_state.fitnesses.update(
-                current_demographic_state.sizes_rates.current_deme_sizes, metadata);
-            auto next_global_N = apply_demographic_events(
-                generation, demography, current_demographic_state.M,
-                current_demographic_state.sizes_rates);
-            current_demographic_state.set_next_global_N(next_global_N);
-            build_migration_lookup(
-                current_demographic_state.M,
-                current_demographic_state.sizes_rates.current_deme_sizes,
-                current_demographic_state.miglookup);
-            detail::validate_parental_state(generation, current_demographic_state);
+            auto &state = current_demographic_state;
+            state.fitnesses.update(state.sizes_rates.current_deme_sizes, metadata,
+                                   fitness_weights);
+            if (state.sizes_carried_over && generation < state.next_event_time)
+                {
+                    if (state.sizes_changing)
+                        {
+                            state.set_next_global_N(
+                                detail::apply_growth_rates_get_next_global_N(
+                                    generation, state.sizes_rates));
+                            state.sizes_changing = detail::sizes_changing(state.sizes_rates);
+                            build_migration_lookup(state.M,
+                                                   state.sizes_rates.current_deme_sizes,
+                                                   state.miglookup);
+                        }
+                }
+            else
+                {
+                    auto next_global_N
+                        = apply_demographic_events(generation, demography, state.M,
+                                                   state.miglookup, state.sizes_rates);
+                    state.set_next_global_N(next_global_N);
+                    state.next_event_time = demography.next_event_time();
+                    state.sizes_changing = detail::sizes_changing(state.sizes_rates);
+                    build_migration_lookup(state.M, state.sizes_rates.current_deme_sizes,
+                                           state.miglookup);
+                }
+            state.next_sizes_generation = generation;
+            detail::validate_parental_state(generation, state);
         }
 
         template <typename METADATATYPE>
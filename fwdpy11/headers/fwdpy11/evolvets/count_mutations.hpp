@@ -0,0 +1,337 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_COUNT_MUTATIONS_HPP
+#define FWDPY11_EVOLVETS_COUNT_MUTATIONS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+
+namespace fwdpy11
+{
+    namespace detail
+    {
+        enum class sample_type : std::uint8_t
+        {
+            none = 0,
+            alive = 1,
+            preserved = 2
+        };
+
+        template <typename TableCollectionType>
+        class chunked_mutation_counter
+        /// Counts the samples descending from each mutation
+        /// in a contiguous range of the (sorted) mutation table.
+        ///
+        /// The marginal tree at the first mutation's position
+        /// is built directly from the edges overlapping it.
+        /// Later trees are reached by applying the edge
+        /// insertions and removals given by the table indexes.
+        /// Sample counts are updated along the path to the root
+        /// for each edge, so the order in which edges with the
+        /// same breakpoint are applied does not matter.
+        {
+          private:
+            const TableCollectionType& tables;
+            std::vector<fwdpp::ts::table_index_t> parent;
+            std::vector<std::uint32_t> alive, preserved;
+            std::size_t next_insertion, next_removal;
+
+            double
+            mutation_position(std::size_t m) const
+            {
+                return tables.sites[tables.mutations[m].site].position;
+            }
+
+            void
+            update_path(fwdpp::ts::table_index_t node, std::uint32_t nalive,
+                        std::uint32_t npreserved, bool add)
+            {
+                for (; node != fwdpp::ts::NULL_INDEX; node = parent[node])
+                    {
+                        if (add)
+                            {
+                                alive[node] += nalive;
+                                preserved[node] += npreserved;
+                            }
+                        else
+                            {
+                                alive[node] -= nalive;
+                                preserved[node] -= npreserved;
+                            }
+                    }
+            }
+
+            template <typename Edge>
+            void
+            insert(const Edge& e)
+            {
+                parent[e.child] = e.parent;
+                update_path(e.parent, alive[e.child], preserved[e.child], true);
+            }
+
+            template <typename Edge>
+            void
+            remove(const Edge& e)
+            {
+                update_path(e.parent, alive[e.child], preserved[e.child], false);
+                parent[e.child] = fwdpp::ts::NULL_INDEX;
+            }
+
+            double
+            tree_right() const
+            {
+                auto right = tables.genome_length();
+                if (next_insertion < tables.input_left.size())
+                    {
+                        right = std::min(
+                            right, tables.edges[tables.input_left[next_insertion]].left);
+                    }
+                if (next_removal < tables.output_right.size())
+                    {
+                        right = std::min(
+                            right, tables.edges[tables.output_right[next_removal]].right);
+                    }
+                return right;
+            }
+
+            void
+            seek(double x)
+            // Build the tree containing position x
+            {
+                const auto& edges = tables.edges;
+                for (next_insertion = 0; next_insertion < tables.input_left.size()
+                                         && edges[tables.input_left[next_insertion]].left <= x;
+                     ++next_insertion)
+                    {
+                        const auto& e = edges[tables.input_left[next_insertion]];
+                        if (e.right > x)
+                            {
+                                insert(e);
+                            }
+                    }
+                next_removal = static_cast<std::size_t>(std::distance(
+                    tables.output_right.begin(),
+                    std::partition_point(
+                        tables.output_right.begin(), tables.output_right.end(),
+                        [&edges, x](const auto e) {
+                            return edges[e].right <= x;
+                        })));
+            }
+
+            void
+            advance(double x)
+            // Move to the tree whose left end is x
+            {
+                const auto& edges = tables.edges;
+                for (; next_removal < tables.output_right.size()
+                       && edges[tables.output_right[next_removal]].right <= x;
+                     ++next_removal)
+                    {
+                        remove(edges[tables.output_right[next_removal]]);
+                    }
+                for (; next_insertion < tables.input_left.size()
+                       && edges[tables.input_left[next_insertion]].left <= x;
+                     ++next_insertion)
+                    {
+                        insert(edges[tables.input_left[next_insertion]]);
+                    }
+            }
+
+          public:
+            chunked_mutation_counter(const TableCollectionType& t,
+                                     const std::vector<sample_type>& samples)
+                : tables(t), parent(t.nodes.size(), fwdpp::ts::NULL_INDEX),
+                  alive(t.nodes.size(), 0), preserved(t.nodes.size(), 0),
+                  next_insertion{0}, next_removal{0}
+            {
+                for (std::size_t i = 0; i < samples.size(); ++i)
+                    {
+                        alive[i] = (samples[i] == sample_type::alive);
+                        preserved[i] = (samples[i] == sample_type::preserved);
+                    }
+            }
+
+            void
+            operator()(std::size_t first_mutation, std::size_t last_mutation,
+                       std::vector<std::uint32_t>& mcounts,
+                       std::vector<std::uint32_t>* preserved_counts)
+            {
+                if (first_mutation == last_mutation)
+                    {
+                        return;
+                    }
+                seek(mutation_position(first_mutation));
+                auto right = tree_right();
+                for (auto m = first_mutation; m < last_mutation; ++m)
+                    {
+                        auto pos = mutation_position(m);
+                        while (pos >= right)
+                            {
+                                advance(right);
+                                right = tree_right();
+                            }
+                        const auto& mr = tables.mutations[m];
+                        mcounts[mr.key] = alive[mr.node];
+                        if (preserved_counts != nullptr)
+                            {
+                                (*preserved_counts)[mr.key] = preserved[mr.node];
+                            }
+                    }
+            }
+        };
+
+        template <typename TableCollectionType, typename MutationContainer>
+        void
+        count_mutations_chunked(
+            const TableCollectionType& tables, const MutationContainer& mutations,
+            const std::vector<fwdpp::ts::table_index_t>& samples,
+            const std::vector<fwdpp::ts::table_index_t>* preserved_nodes,
+            std::vector<std::uint32_t>& mcounts,
+            std::vector<std::uint32_t>* preserved_counts, unsigned nthreads)
+        {
+            if (!tables.edges.empty()
+                && (tables.input_left.size() != tables.edges.size()
+                    || tables.output_right.size() != tables.edges.size()))
+                {
+                    throw std::runtime_error(
+                        "count_mutations: edge table indexes are not built");
+                }
+            std::vector<sample_type> sample_types(tables.nodes.size(), sample_type::none);
+            auto label = [&sample_types](fwdpp::ts::table_index_t u, sample_type t) {
+                if (u < 0 || static_cast<std::size_t>(u) >= sample_types.size())
+                    {
+                        throw std::invalid_argument(
+                            "count_mutations: sample node index out of range");
+                    }
+                if (sample_types[u] != sample_type::none)
+                    {
+                        throw std::invalid_argument(
+                            "count_mutations: sample nodes must be unique");
+                    }
+                sample_types[u] = t;
+            };
+            for (auto u : samples)
+                {
+                    label(u, sample_type::alive);
+                }
+            if (preserved_nodes != nullptr)
+                {
+                    for (auto u : *preserved_nodes)
+                        {
+                            label(u, sample_type::preserved);
+                        }
+                }
+            mcounts.resize(mutations.size(), 0);
+            std::fill(mcounts.begin(), mcounts.end(), 0);
+            if (preserved_counts != nullptr)
+                {
+                    preserved_counts->resize(mutations.size(), 0);
+                    std::fill(preserved_counts->begin(), preserved_counts->end(), 0);
+                }
+            for (const auto& mr : tables.mutations)
+                {
+                    if (mr.key >= mutations.size())
+                        {
+                            throw std::runtime_error(
+                                "count_mutations: mutation key out of range");
+                        }
+                }
+
+            // Each thread builds its first tree from scratch,
+            // which costs a pass over the edges, so we only
+            // split the work when there are many mutations.
+            constexpr std::size_t min_mutations_per_chunk = 1 << 15;
+            const auto nmutations = tables.mutations.size();
+            if (nthreads == 0)
+                {
+                    nthreads = std::max(1u, std::thread::hardware_concurrency());
+                }
+            auto nchunks = std::max<std::size_t>(
+                1, std::min<std::size_t>(nthreads,
+                                         nmutations / min_mutations_per_chunk));
+            if (nchunks == 1)
+                {
+                    chunked_mutation_counter<TableCollectionType>(tables, sample_types)(
+                        0, nmutations, mcounts, preserved_counts);
+                    return;
+                }
+            // Chunks hold disjoint sets of mutation keys,
+            // so threads write to different elements of
+            // the output.
+            std::vector<std::thread> threads;
+            threads.reserve(nchunks);
+            for (std::size_t c = 0; c < nchunks; ++c)
+                {
+                    auto first = c * nmutations / nchunks;
+                    auto last = (c + 1) * nmutations / nchunks;
+                    threads.emplace_back([&tables, &sample_types, &mcounts,
+                                          preserved_counts, first, last]() {
+                        chunked_mutation_counter<TableCollectionType>(
+                            tables, sample_types)(first, last, mcounts,
+                                                  preserved_counts);
+                    });
+                }
+            for (auto& t : threads)
+                {
+                    t.join();
+                }
+        }
+    } // namespace detail
+
+    template <typename TableCollectionType, typename MutationContainer>
+    void
+    count_mutations(const TableCollectionType& tables, const MutationContainer& mutations,
+                    const std::vector<fwdpp::ts::table_index_t>& samples,
+                    std::vector<std::uint32_t>& mcounts, unsigned nthreads = 1)
+    /// Drop-in replacement for fwdpp::ts::count_mutations.
+    ///
+    /// The mutation table is split into chunks that may be counted in
+    /// parallel.  The default is a single thread, which is what
+    /// simulations use.  A value of zero for nthreads uses one thread
+    /// per hardware core and is meant for explicit calls from Python.
+    /// The edge table must be indexed and the mutation table sorted
+    /// by position.
+    {
+        detail::count_mutations_chunked(tables, mutations, samples, nullptr, mcounts,
+                                        nullptr, nthreads);
+    }
+
+    template <typename TableCollectionType, typename MutationContainer>
+    void
+    count_mutations(const TableCollectionType& tables, const MutationContainer& mutations,
+                    const std::vector<fwdpp::ts::table_index_t>& samples,
+                    const std::vector<fwdpp::ts::table_index_t>& preserved_nodes,
+                    std::vector<std::uint32_t>& mcounts,
+                    std::vector<std::uint32_t>& preserved_counts,
+                    unsigned nthreads = 1)
+    /// Counts in the alive samples and in preserved nodes
+    /// are obtained from the same traversal.
+    {
+        detail::count_mutations_chunked(tables, mutations, samples, &preserved_nodes,
+                                        mcounts, &preserved_counts, nthreads);
+    }
+} // namespace fwdpy11
+
+#endif
@@ -0,0 +1,164 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_DISCRETE_GENOME_HPP
+#define FWDPY11_EVOLVETS_DISCRETE_GENOME_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <fwdpp/ts/table_collection_functions.hpp>
+#include <fwdpy11/types/MutationPositionLookup.hpp>
+
+namespace fwdpy11
+{
+    class scoped_discrete_genome
+    /// Puts a lookup table in discrete genome mode for the
+    /// lifetime of this object.  The lookup table returns to
+    /// continuous positions on destruction, including when an
+    /// exception is thrown, so the mode never outlives the call
+    /// that set it.  A length of 0 means continuous positions.
+    {
+      private:
+        MutationPositionLookup &lookup;
+
+      public:
+        scoped_discrete_genome(MutationPositionLookup &lookup_table,
+                               const std::uint64_t length)
+            : lookup{lookup_table}
+        {
+            // Throws if existing positions are not valid sites
+            lookup.set_discrete_genome_length(length);
+        }
+
+        ~scoped_discrete_genome()
+        {
+            lookup.set_discrete_genome_length(0);
+        }
+
+        scoped_discrete_genome(const scoped_discrete_genome &) = delete;
+        scoped_discrete_genome &operator=(const scoped_discrete_genome &) = delete;
+    };
+
+    inline void
+    discretize_breakpoints(std::vector<double> &breakpoints)
+    // Map sorted breakpoints onto integer sites.
+    // The last element must be std::numeric_limits<double>::max().
+    // A breakpoint at position x means that the offspring genome
+    // switches parental genomes at site floor(x).
+    // Because the parental genome that is copied first is chosen
+    // at random, a switch at site zero has no effect on the
+    // distribution of offspring genomes, and is removed.
+    // Two crossovers at the same site cancel, so breakpoints that
+    // occur an even number of times are removed.
+    {
+        if (breakpoints.empty())
+            {
+                return;
+            }
+        auto last = breakpoints.size() - 1;
+        for (std::size_t i = 0; i < last; ++i)
+            {
+                breakpoints[i] = std::floor(breakpoints[i]);
+            }
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < last;)
+            {
+                std::size_t j = i + 1;
+                while (j < last && breakpoints[j] == breakpoints[i])
+                    {
+                        ++j;
+                    }
+                if ((j - i) % 2 == 1 && breakpoints[i] != 0.0)
+                    {
+                        breakpoints[next++] = breakpoints[i];
+                    }
+                i = j;
+            }
+        if (next == 0)
+            {
+                breakpoints.clear();
+                return;
+            }
+        breakpoints[next++] = std::numeric_limits<double>::max();
+        breakpoints.resize(next);
+    }
+
+    template <typename TableCollectionType>
+    void
+    sort_mutation_table_discrete(TableCollectionType &tables)
+    // Sort the mutation table by site position using an LSD
+    // radix sort on integer positions.  If any site position
+    // is not a non-negative integer, we fall back to
+    // fwdpp::ts::sort_mutation_table.
+    {
+        auto &mutations = tables.mutations;
+        if (mutations.size() < 2)
+            {
+                return;
+            }
+        std::vector<std::uint64_t> positions(mutations.size());
+        std::uint64_t max_position = 0;
+        for (std::size_t i = 0; i < mutations.size(); ++i)
+            {
+                auto p = tables.sites[mutations[i].site].position;
+                if (!(p >= 0.0) || std::floor(p) != p)
+                    {
+                        fwdpp::ts::sort_mutation_table(tables);
+                        return;
+                    }
+                positions[i] = static_cast<std::uint64_t>(p);
+                max_position = std::max(max_position, positions[i]);
+            }
+        std::vector<std::size_t> order(mutations.size()), buffer(mutations.size());
+        std::iota(begin(order), end(order), 0);
+        std::vector<std::size_t> counts(1 << 16);
+        for (unsigned shift = 0; shift < 64 && (max_position >> shift) > 0; shift += 16)
+            {
+                std::fill(begin(counts), end(counts), 0);
+                for (auto i : order)
+                    {
+                        ++counts[(positions[i] >> shift) & 0xffff];
+                    }
+                std::size_t total = 0;
+                for (auto &c : counts)
+                    {
+                        auto t = c;
+                        c = total;
+                        total += t;
+                    }
+                for (auto i : order)
+                    {
+                        buffer[counts[(positions[i] >> shift) & 0xffff]++] = i;
+                    }
+                order.swap(buffer);
+            }
+        typename std::remove_reference<decltype(mutations)>::type sorted;
+        sorted.reserve(mutations.size());
+        for (auto i : order)
+            {
+                sorted.emplace_back(std::move(mutations[i]));
+            }
+        mutations.swap(sorted);
+    }
+} // namespace fwdpy11
+
+#endif
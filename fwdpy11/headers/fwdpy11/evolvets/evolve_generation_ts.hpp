@@ -36,6 +36,8 @@
 #include <fwdpp/ts/recording/edge_buffer.hpp>
 #include <fwdpp/ts/recording/mutations.hpp>
 #include <fwdpy11/discrete_demography/simulation.hpp>
+#include <fwdpy11/spatial/SpatialMating.hpp>
+#include "meiosis_buffers.hpp"
 
 namespace fwdpy11
 {
@@ -90,7 +92,10 @@ namespace fwdpy11
         fwdpp::ts::edge_buffer & new_edge_buffer,
         std::vector<fwdpy11::DiploidGenotype>& offspring,
         std::vector<fwdpy11::DiploidMetadata>& offspring_metadata,
-        std::int32_t next_index)
+        MeiosisBuffers& meiosis_buffers, SpatialMating* spatial,
+        fwdpp::ts::table_index_t next_index)
+    // If spatial is not nullptr, it chooses the second
+    // parent and places each offspring in space.
     {
         fwdpp::debug::all_haploid_genomes_extant(pop);
 
@@ -114,11 +119,22 @@ namespace fwdpy11
                     {
                         // Get the parents
                         auto pdata
-                            = fwdpy11::discrete_demography::pick_parents(
-                                rng, deme, current_demographic_state.miglookup,
-                                current_demographic_state.sizes_rates.current_deme_sizes,
-                                current_demographic_state.sizes_rates.selfing_rates,
-                                current_demographic_state.fitnesses);
+                            = (spatial == nullptr)
+                                  ? fwdpy11::discrete_demography::pick_parents(
+                                      rng, deme, current_demographic_state.miglookup,
+                                      current_demographic_state.sizes_rates
+                                          .current_deme_sizes,
+                                      current_demographic_state.sizes_rates
+                                          .selfing_rates,
+                                      current_demographic_state.fitnesses)
+                                  : spatial->pick_parents(
+                                      rng, deme, current_demographic_state.miglookup,
+                                      current_demographic_state.sizes_rates
+                                          .current_deme_sizes,
+                                      current_demographic_state.sizes_rates
+                                          .selfing_rates,
+                                      current_demographic_state.fitnesses,
+                                      pop.diploid_metadata);
                         fwdpy11::DiploidGenotype dip{
                             std::numeric_limits<std::size_t>::max(),
                             std::numeric_limits<std::size_t>::max()
@@ -148,6 +164,8 @@ namespace fwdpy11
                         fwdpp::ts::record_mutations_infinite_sites(
                             offspring_node_2, pop.mutations,
                             offspring_data.second.mutation_keys, *pop.tables);
+                        meiosis_buffers.recycle(offspring_data.first);
+                        meiosis_buffers.recycle(offspring_data.second);
 
                         // Add metadata for the offspring
                         offspring_metadata.emplace_back(
@@ -161,6 +179,12 @@ namespace fwdpy11
                                 deme,
                                 0,
                                 { offspring_node_1, offspring_node_2 } });
+                        if (spatial != nullptr)
+                            {
+                                spatial->disperse(rng,
+                                                  pop.diploid_metadata[pdata.parent1],
+                                                  offspring_metadata.back());
+                            }
                         offspring.emplace_back(std::move(dip));
 
                         next_index_local = offspring_node_2;
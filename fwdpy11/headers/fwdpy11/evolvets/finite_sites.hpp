@@ -0,0 +1,299 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_FINITE_SITES_HPP
+#define FWDPY11_EVOLVETS_FINITE_SITES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <gsl/gsl_randist.h>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpy11/rng.hpp>
+
+namespace fwdpy11
+{
+    struct nucleotide_model
+    /// A substitution model for the states 0, 1, 2, 3,
+    /// which are A, C, G, T.
+    ///
+    /// The transition matrix is that of a uniformized
+    /// rate matrix: row i gives the probability of each
+    /// state after a mutation event at a site in state i.
+    /// The diagonal is the probability of a silent event.
+    {
+        std::array<double, 4> stationary;
+        std::array<std::array<double, 4>, 4> transitions;
+    };
+
+    struct finite_sites_mutations
+    /// The columns of new site and mutation tables.
+    /// Sites are sorted by position and mutations are
+    /// sorted by site and then by time, so that parent
+    /// mutations come before their children.  Times
+    /// are forwards in time, as for the node table.
+    {
+        std::vector<double> site_position;
+        std::vector<std::int8_t> site_ancestral_state;
+        std::vector<fwdpp::ts::table_index_t> mutation_site;
+        std::vector<fwdpp::ts::table_index_t> mutation_node;
+        std::vector<double> mutation_time;
+        std::vector<std::int8_t> mutation_derived_state;
+        std::vector<fwdpp::ts::table_index_t> mutation_parent;
+    };
+
+    namespace detail
+    {
+        struct finite_sites_event
+        {
+            std::int64_t site;
+            double time;
+            fwdpp::ts::table_index_t node;
+        };
+
+        inline void
+        validate_nucleotide_model(const nucleotide_model& model)
+        {
+            const auto valid_distribution = [](const std::array<double, 4>& p) {
+                double sum = 0.0;
+                for (auto x : p)
+                    {
+                        if (!std::isfinite(x) || x < 0.0)
+                            {
+                                return false;
+                            }
+                        sum += x;
+                    }
+                return std::abs(sum - 1.0) < 1e-8;
+            };
+            if (!valid_distribution(model.stationary))
+                {
+                    throw std::invalid_argument(
+                        "stationary frequencies must be non-negative and sum to 1");
+                }
+            for (const auto& row : model.transitions)
+                {
+                    if (!valid_distribution(row))
+                        {
+                            throw std::invalid_argument(
+                                "rows of the transition matrix must be non-negative "
+                                "and sum to 1");
+                        }
+                }
+        }
+
+        inline std::int8_t
+        draw_nucleotide(const GSLrng_t& rng, const std::array<double, 4>& p)
+        {
+            auto u = gsl_rng_uniform(rng.get());
+            double sum = 0.0;
+            for (std::int8_t i = 0; i < 3; ++i)
+                {
+                    sum += p[i];
+                    if (u < sum)
+                        {
+                            return i;
+                        }
+                }
+            return 3;
+        }
+
+        template <typename TableCollectionType>
+        std::vector<finite_sites_event>
+        finite_sites_events(const GSLrng_t& rng, const TableCollectionType& tables,
+                            const double mu)
+        // Events are placed on each edge at rate mu per genome
+        // per unit of time.  The sites on an edge are the
+        // integers in [left, right), so no position is ever
+        // redrawn.  The output is sorted by site and then by time.
+        {
+            std::vector<finite_sites_event> rv;
+            const auto L = tables.genome_length();
+            for (const auto& e : tables.edges)
+                {
+                    auto first = static_cast<std::int64_t>(std::ceil(e.left));
+                    auto nsites = static_cast<std::int64_t>(std::ceil(e.right)) - first;
+                    auto tparent = tables.nodes[e.parent].time;
+                    auto tchild = tables.nodes[e.child].time;
+                    if (nsites < 1 || !(tchild > tparent))
+                        {
+                            continue;
+                        }
+                    auto n = gsl_ran_poisson(rng.get(), mu * (tchild - tparent)
+                                                            * static_cast<double>(nsites)
+                                                            / L);
+                    for (unsigned k = 0; k < n; ++k)
+                        {
+                            auto site = first
+                                        + static_cast<std::int64_t>(gsl_rng_uniform_int(
+                                            rng.get(), static_cast<unsigned long>(nsites)));
+                            rv.push_back(finite_sites_event{
+                                site, gsl_ran_flat(rng.get(), tparent, tchild), e.child});
+                        }
+                }
+            std::sort(rv.begin(), rv.end(),
+                      [](const finite_sites_event& a, const finite_sites_event& b) {
+                          return a.site < b.site || (a.site == b.site && a.time < b.time);
+                      });
+            return rv;
+        }
+    } // namespace detail
+
+    template <typename TableCollectionType>
+    finite_sites_mutations
+    finite_sites(const GSLrng_t& rng, const TableCollectionType& tables, const double mu,
+                 const nucleotide_model& model)
+    /// Generate neutral mutations under a finite-sites model.
+    ///
+    /// The sites are the integers in [0, genome length).  A site
+    /// may mutate many times.  Each mutation's parent is the
+    /// most recent earlier mutation at the same site on the path
+    /// to the root of the marginal tree, and its derived state is
+    /// drawn from the row of the transition matrix given by the
+    /// state that it inherits.  Silent events are discarded.
+    /// Sites that are already in the site table are skipped.
+    ///
+    /// The tables are not modified and must be indexed.
+    {
+        if (!std::isfinite(mu) || mu < 0.0)
+            {
+                throw std::invalid_argument("mutation rate must be non-negative");
+            }
+        const auto L = tables.genome_length();
+        if (!std::isfinite(L) || std::floor(L) != L)
+            {
+                throw std::invalid_argument(
+                    "finite-sites mutations require an integer genome length");
+            }
+        if (tables.input_left.size() != tables.edges.size()
+            || tables.output_right.size() != tables.edges.size())
+            {
+                throw std::invalid_argument("table collection is not indexed");
+            }
+        detail::validate_nucleotide_model(model);
+
+        finite_sites_mutations rv;
+        if (mu == 0.0)
+            {
+                return rv;
+            }
+        auto events = detail::finite_sites_events(rng, tables, mu);
+
+        std::unordered_set<double> occupied;
+        for (const auto& s : tables.sites)
+            {
+                occupied.insert(s.position);
+            }
+
+        // Trees are visited from left to right.  Edges whose
+        // intervals end before the current site are never inserted.
+        const auto& edges = tables.edges;
+        std::vector<fwdpp::ts::table_index_t> parent(tables.nodes.size(),
+                                                     fwdpp::ts::NULL_INDEX);
+        std::size_t next_insertion = 0, next_removal = 0;
+        const auto advance = [&](double x) {
+            for (; next_removal < tables.output_right.size()
+                   && edges[tables.output_right[next_removal]].right <= x;
+                 ++next_removal)
+                {
+                    parent[edges[tables.output_right[next_removal]].child]
+                        = fwdpp::ts::NULL_INDEX;
+                }
+            for (; next_insertion < tables.input_left.size()
+                   && edges[tables.input_left[next_insertion]].left <= x;
+                 ++next_insertion)
+                {
+                    const auto& e = edges[tables.input_left[next_insertion]];
+                    if (e.right > x)
+                        {
+                            parent[e.child] = e.parent;
+                        }
+                }
+        };
+
+        // The most recent mutation on each node at the current site
+        std::unordered_map<fwdpp::ts::table_index_t, fwdpp::ts::table_index_t>
+            latest_mutation;
+        for (std::size_t first = 0; first < events.size();)
+            {
+                auto last = first + 1;
+                while (last < events.size() && events[last].site == events[first].site)
+                    {
+                        ++last;
+                    }
+                const auto position = static_cast<double>(events[first].site);
+                if (occupied.count(position))
+                    {
+                        first = last;
+                        continue;
+                    }
+                advance(position);
+                latest_mutation.clear();
+                auto ancestral_state = detail::draw_nucleotide(rng, model.stationary);
+                auto site = static_cast<fwdpp::ts::table_index_t>(rv.site_position.size());
+                // Events are in time order, so all mutations
+                // ancestral to an event have been processed.
+                for (auto i = first; i < last; ++i)
+                    {
+                        auto mutation_parent = fwdpp::ts::NULL_INDEX;
+                        for (auto u = events[i].node; u != fwdpp::ts::NULL_INDEX;
+                             u = parent[u])
+                            {
+                                auto m = latest_mutation.find(u);
+                                if (m != latest_mutation.end())
+                                    {
+                                        mutation_parent = m->second;
+                                        break;
+                                    }
+                            }
+                        auto inherited = mutation_parent == fwdpp::ts::NULL_INDEX
+                                             ? ancestral_state
+                                             : rv.mutation_derived_state[mutation_parent];
+                        auto derived = detail::draw_nucleotide(
+                            rng, model.transitions[static_cast<std::size_t>(inherited)]);
+                        if (derived == inherited)
+                            {
+                                continue;
+                            }
+                        if (site == static_cast<fwdpp::ts::table_index_t>(
+                                rv.site_position.size()))
+                            {
+                                rv.site_position.push_back(position);
+                                rv.site_ancestral_state.push_back(ancestral_state);
+                            }
+                        latest_mutation[events[i].node] = static_cast<fwdpp::ts::table_index_t>(
+                            rv.mutation_site.size());
+                        rv.mutation_site.push_back(site);
+                        rv.mutation_node.push_back(events[i].node);
+                        rv.mutation_time.push_back(events[i].time);
+                        rv.mutation_derived_state.push_back(derived);
+                        rv.mutation_parent.push_back(mutation_parent);
+                    }
+                first = last;
+            }
+        return rv;
+    }
+} // namespace fwdpy11
+
+#endif
@@ -0,0 +1,152 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_INCREMENTAL_MUTATION_COUNTS_HPP
+#define FWDPY11_EVOLVETS_INCREMENTAL_MUTATION_COUNTS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace fwdpy11
+{
+    class IncrementalMutationCounts
+    /// Mutation counts obtained from the contents of haploid
+    /// genomes, updated from the changes in genome counts
+    /// rather than by recounting every genome.
+    ///
+    /// During a generation, the contents of parental genomes
+    /// do not change: new genomes are either appended or
+    /// overwrite genomes that were already extinct.  Thus,
+    /// if each genome's count is recorded before offspring are
+    /// generated, the new mutation counts are the old counts plus
+    /// (new count - old count) times the contents of each genome
+    /// whose count changed.
+    ///
+    /// Anything else that edits genomes, such as removing
+    /// fixations after simplification, must call invalidate().
+    /// The next call to update() then recounts from scratch.
+    {
+      private:
+        std::vector<std::uint32_t> previous_n;
+        bool valid;
+
+        template <typename GenomeContainer>
+        void
+        recount(const GenomeContainer& haploid_genomes)
+        {
+            std::fill(counts.begin(), counts.end(), 0);
+            for (const auto& g : haploid_genomes)
+                {
+                    if (g.n)
+                        {
+                            for (auto k : g.mutations)
+                                {
+                                    counts[k] += g.n;
+                                }
+                            for (auto k : g.smutations)
+                                {
+                                    counts[k] += g.n;
+                                }
+                        }
+                }
+        }
+
+      public:
+        std::vector<std::uint32_t> counts;
+
+        IncrementalMutationCounts() : previous_n{}, valid{false}, counts{}
+        {
+        }
+
+        void
+        invalidate()
+        {
+            valid = false;
+        }
+
+        template <typename GenomeContainer>
+        void
+        record_parental_genomes(const GenomeContainer& haploid_genomes)
+        // Must be called before the offspring generation starts.
+        {
+            if (!valid)
+                {
+                    return;
+                }
+            previous_n.resize(haploid_genomes.size());
+            for (std::size_t i = 0; i < haploid_genomes.size(); ++i)
+                {
+                    previous_n[i] = haploid_genomes[i].n;
+                }
+        }
+
+        template <typename GenomeContainer>
+        void
+        update(const GenomeContainer& haploid_genomes, std::size_t nmutations)
+        // Bring counts up to date with the offspring generation.
+        {
+            counts.resize(nmutations, 0);
+            if (!valid)
+                {
+                    recount(haploid_genomes);
+                    valid = true;
+                    return;
+                }
+            if (haploid_genomes.size() < previous_n.size())
+                {
+                    throw std::runtime_error(
+                        "IncrementalMutationCounts: haploid genomes were removed");
+                }
+            for (std::size_t i = 0; i < haploid_genomes.size(); ++i)
+                {
+                    const auto& g = haploid_genomes[i];
+                    auto old_n = i < previous_n.size() ? previous_n[i] : 0u;
+                    if (g.n == old_n)
+                        {
+                            continue;
+                        }
+                    // Unsigned arithmetic wraps, so adding
+                    // the difference also handles decreases.
+                    std::uint32_t delta = g.n - old_n;
+                    for (auto k : g.mutations)
+                        {
+                            counts[k] += delta;
+                        }
+                    for (auto k : g.smutations)
+                        {
+                            counts[k] += delta;
+                        }
+                }
+#ifndef NDEBUG
+            auto incremental = counts;
+            recount(haploid_genomes);
+            if (incremental != counts)
+                {
+                    throw std::runtime_error(
+                        "IncrementalMutationCounts: incremental counts differ from a "
+                        "full recount");
+                }
+#endif
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -0,0 +1,383 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_INFINITE_SITES_HPP
+#define FWDPY11_EVOLVETS_INFINITE_SITES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+#include <gsl/gsl_randist.h>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/table_collection_functions.hpp>
+#include <fwdpy11/rng.hpp>
+#include "count_mutations.hpp"
+
+namespace fwdpy11
+{
+    namespace detail
+    {
+        struct new_neutral_mutation
+        {
+            double position;
+            std::int32_t origin_time;
+            fwdpp::ts::table_index_t node;
+        };
+
+        // The genome is split into this many intervals, each
+        // with its own random number stream.  The number does
+        // not depend on the number of threads, so that the
+        // output only depends on the state of the input rng.
+        constexpr std::size_t infinite_sites_intervals = 64;
+
+        template <typename TableCollectionType, typename LookupTable>
+        std::vector<new_neutral_mutation>
+        neutral_mutations_in_interval(const GSLrng_t& rng,
+                                      const TableCollectionType& tables,
+                                      const std::vector<std::size_t>& edges,
+                                      const LookupTable& lookup, const double mu,
+                                      const double left, const double right)
+        // Mutations are placed on each edge, over the part of it
+        // that overlaps [left, right), at rate mu per genome per
+        // unit of time.  The output is sorted by position.
+        // Unlike fwdpp::ts::mutate_tables, nothing is placed above
+        // the roots of trees that have not coalesced.
+        {
+            std::vector<new_neutral_mutation> rv;
+            std::unordered_set<double> positions;
+            const auto L = tables.genome_length();
+            for (auto i : edges)
+                {
+                    const auto& e = tables.edges[i];
+                    auto l = std::max(e.left, left);
+                    auto r = std::min(e.right, right);
+                    auto tparent = tables.nodes[e.parent].time;
+                    auto tchild = tables.nodes[e.child].time;
+                    if (!(r > l) || !(tchild > tparent))
+                        {
+                            continue;
+                        }
+                    auto n = gsl_ran_poisson(rng.get(),
+                                             mu * (tchild - tparent) * (r - l) / L);
+                    for (unsigned k = 0; k < n; ++k)
+                        {
+                            unsigned attempts = 0;
+                            double pos;
+                            do
+                                {
+                                    if (++attempts > 1000)
+                                        {
+                                            throw std::runtime_error(
+                                                "unable to find an unoccupied site for "
+                                                "a new mutation");
+                                        }
+                                    pos = lookup.canonical_position(
+                                        gsl_ran_flat(rng.get(), l, r));
+                                }
+                            while (lookup.find(pos) != lookup.end()
+                                   || positions.find(pos) != positions.end());
+                            positions.insert(pos);
+                            auto origin = gsl_ran_flat(rng.get(), tparent, tchild);
+                            rv.push_back(new_neutral_mutation{
+                                pos, static_cast<std::int32_t>(std::ceil(origin)),
+                                e.child});
+                        }
+                }
+            std::sort(rv.begin(), rv.end(),
+                      [](const new_neutral_mutation& a, const new_neutral_mutation& b) {
+                          return a.position < b.position;
+                      });
+            return rv;
+        }
+
+        template <typename TableCollectionType, typename LookupTable>
+        std::vector<new_neutral_mutation>
+        generate_neutral_mutations(const GSLrng_t& rng,
+                                   const TableCollectionType& tables,
+                                   const LookupTable& lookup, const double mu,
+                                   unsigned nthreads)
+        // The genome is split into intervals that are mutated in
+        // parallel.  The lookup table is only read.  For discrete
+        // genomes, the interval boundaries are integers so that
+        // positions, which are rounded down, stay in their interval.
+        // The output is sorted by position.
+        {
+            const auto L = tables.genome_length();
+            std::vector<double> boundaries;
+            for (std::size_t i = 0; i <= infinite_sites_intervals; ++i)
+                {
+                    auto x = L * static_cast<double>(i)
+                             / static_cast<double>(infinite_sites_intervals);
+                    if (lookup.discrete())
+                        {
+                            x = std::floor(x);
+                        }
+                    if (boundaries.empty() || x > boundaries.back())
+                        {
+                            boundaries.push_back(x);
+                        }
+                }
+            boundaries.back() = L;
+            const auto nintervals = boundaries.size() - 1;
+
+            // Assign edges to each interval that they overlap
+            std::vector<std::vector<std::size_t>> interval_edges(nintervals);
+            for (std::size_t i = 0; i < tables.edges.size(); ++i)
+                {
+                    const auto& e = tables.edges[i];
+                    auto first = static_cast<std::size_t>(
+                        std::upper_bound(boundaries.begin(), boundaries.end(), e.left)
+                        - boundaries.begin() - 1);
+                    for (auto j = first; j < nintervals && boundaries[j] < e.right; ++j)
+                        {
+                            interval_edges[j].push_back(i);
+                        }
+                }
+
+            std::vector<unsigned long> seeds(nintervals);
+            for (auto& s : seeds)
+                {
+                    s = gsl_rng_uniform_int(rng.get(),
+                                            std::numeric_limits<std::uint32_t>::max());
+                }
+            std::vector<std::vector<new_neutral_mutation>> mutations(nintervals);
+            auto mutate = [&](std::size_t j) {
+                GSLrng_t interval_rng(static_cast<unsigned>(seeds[j]));
+                mutations[j] = neutral_mutations_in_interval(
+                    interval_rng, tables, interval_edges[j], lookup, mu, boundaries[j],
+                    boundaries[j + 1]);
+            };
+
+            if (nthreads == 0)
+                {
+                    nthreads = std::max(1u, std::thread::hardware_concurrency());
+                }
+            nthreads = static_cast<unsigned>(
+                std::min<std::size_t>(nthreads, nintervals));
+            if (nthreads == 1)
+                {
+                    for (std::size_t j = 0; j < nintervals; ++j)
+                        {
+                            mutate(j);
+                        }
+                }
+            else
+                {
+                    std::vector<std::thread> threads;
+                    std::vector<std::exception_ptr> errors(nthreads);
+                    for (unsigned t = 0; t < nthreads; ++t)
+                        {
+                            threads.emplace_back([&mutate, &errors, t, nthreads,
+                                                  nintervals]() {
+                                try
+                                    {
+                                        for (std::size_t j = t; j < nintervals;
+                                             j += nthreads)
+                                            {
+                                                mutate(j);
+                                            }
+                                    }
+                                catch (...)
+                                    {
+                                        errors[t] = std::current_exception();
+                                    }
+                            });
+                        }
+                    for (auto& t : threads)
+                        {
+                            t.join();
+                        }
+                    for (auto& e : errors)
+                        {
+                            if (e)
+                                {
+                                    std::rethrow_exception(e);
+                                }
+                        }
+                }
+
+            // Intervals are disjoint and in order, so
+            // concatenation gives sorted output.
+            std::vector<new_neutral_mutation> rv;
+            for (auto& m : mutations)
+                {
+                    rv.insert(rv.end(), m.begin(), m.end());
+                }
+            return rv;
+        }
+
+        template <typename TableCollectionType>
+        bool
+        site_and_mutation_tables_sorted(const TableCollectionType& tables)
+        {
+            for (std::size_t i = 1; i < tables.sites.size(); ++i)
+                {
+                    if (!(tables.sites[i - 1].position < tables.sites[i].position))
+                        {
+                            return false;
+                        }
+                }
+            for (std::size_t i = 1; i < tables.mutations.size(); ++i)
+                {
+                    if (tables.mutations[i].site < tables.mutations[i - 1].site)
+                        {
+                            return false;
+                        }
+                }
+            return true;
+        }
+    } // namespace detail
+
+    template <typename PopulationType>
+    unsigned
+    infinite_sites(const GSLrng_t& rng, PopulationType& pop, const double mu,
+                   unsigned nthreads = 1)
+    /// Add neutral mutations to the tables of pop.
+    ///
+    /// New mutations may be generated in parallel.  The output
+    /// does not depend on nthreads.  The default is a single thread,
+    /// and zero means one thread per hardware core.
+    /// New mutations are stored in the slots of extinct mutations
+    /// when possible, and merged into the sorted site and mutation tables.
+    /// Counts are then updated for alive and preserved nodes.
+    /// Returns the number of new mutations.
+    {
+        if (mu <= 0.0)
+            {
+                return 0u;
+            }
+        pop.detach_tables();
+        auto& tables = *pop.tables;
+        auto new_mutations
+            = detail::generate_neutral_mutations(rng, tables, pop.mut_lookup, mu, nthreads);
+        if (new_mutations.empty())
+            {
+                return 0u;
+            }
+
+        // Keys of extinct mutations can be reused
+        std::vector<std::size_t> recyclable;
+        for (std::size_t i = 0; i < std::min(pop.mcounts.size(), pop.mutations.size());
+             ++i)
+            {
+                if (pop.mcounts[i] == 0
+                    && (pop.mcounts_from_preserved_nodes.empty()
+                        || pop.mcounts_from_preserved_nodes[i] == 0))
+                    {
+                        recyclable.push_back(i);
+                    }
+            }
+        using mutation_t = typename PopulationType::mutation_container::value_type;
+        std::vector<std::size_t> keys;
+        keys.reserve(new_mutations.size());
+        pop.mut_lookup.reserve(pop.mut_lookup.size() + new_mutations.size());
+        for (const auto& m : new_mutations)
+            {
+                mutation_t mutation(true, m.position, 0., 0., m.origin_time);
+                std::size_t key;
+                if (keys.size() < recyclable.size())
+                    {
+                        key = recyclable[keys.size()];
+                        pop.mutations[key] = std::move(mutation);
+                    }
+                else
+                    {
+                        key = pop.mutations.size();
+                        pop.mutations.emplace_back(std::move(mutation));
+                    }
+                keys.push_back(key);
+                pop.mut_lookup.emplace(m.position, static_cast<std::uint32_t>(key));
+            }
+
+        using site_t = typename std::remove_reference<decltype(tables.sites)>::type::value_type;
+        using mutation_record_t =
+            typename std::remove_reference<decltype(tables.mutations)>::type::value_type;
+        const auto new_record = [&](std::size_t i, std::size_t site) {
+            return mutation_record_t{
+                new_mutations[i].node, keys[i],
+                static_cast<decltype(mutation_record_t::site)>(site),
+                fwdpp::ts::default_derived_state, true};
+        };
+        if (!detail::site_and_mutation_tables_sorted(tables))
+            {
+                for (std::size_t i = 0; i < new_mutations.size(); ++i)
+                    {
+                        tables.sites.push_back(site_t{new_mutations[i].position,
+                                                      fwdpp::ts::default_ancestral_state});
+                        tables.mutations.push_back(new_record(i, tables.sites.size() - 1));
+                    }
+                fwdpp::ts::sort_mutation_table(tables);
+                fwdpp::ts::rebuild_site_table(tables);
+            }
+        else
+            {
+                // Merge the new sites and mutations into the existing tables
+                decltype(tables.sites) sites;
+                decltype(tables.mutations) mutations;
+                sites.reserve(tables.sites.size() + new_mutations.size());
+                mutations.reserve(tables.mutations.size() + new_mutations.size());
+                std::size_t next_new = 0, next_old = 0;
+                const auto add_new_mutations_before = [&](double position) {
+                    for (; next_new < new_mutations.size()
+                           && new_mutations[next_new].position < position;
+                         ++next_new)
+                        {
+                            sites.push_back(site_t{new_mutations[next_new].position,
+                                                   fwdpp::ts::default_ancestral_state});
+                            mutations.push_back(new_record(next_new, sites.size() - 1));
+                        }
+                };
+                for (std::size_t s = 0; s < tables.sites.size(); ++s)
+                    {
+                        add_new_mutations_before(tables.sites[s].position);
+                        sites.push_back(tables.sites[s]);
+                        for (; next_old < tables.mutations.size()
+                               && static_cast<std::size_t>(tables.mutations[next_old].site)
+                                      == s;
+                             ++next_old)
+                            {
+                                mutations.push_back(tables.mutations[next_old]);
+                                mutations.back().site
+                                    = static_cast<decltype(mutations.back().site)>(
+                                        sites.size() - 1);
+                            }
+                    }
+                add_new_mutations_before(std::numeric_limits<double>::infinity());
+                tables.sites.swap(sites);
+                tables.mutations.swap(mutations);
+            }
+
+        pop.fill_alive_nodes();
+        pop.fill_preserved_nodes();
+        count_mutations(tables, pop.mutations, pop.alive_nodes, pop.preserved_sample_nodes,
+                        pop.mcounts, pop.mcounts_from_preserved_nodes, nthreads);
+        pop.alive_nodes.clear();
+        pop.preserved_sample_nodes.clear();
+        return static_cast<unsigned>(new_mutations.size());
+    }
+} // namespace fwdpy11
+
+#endif
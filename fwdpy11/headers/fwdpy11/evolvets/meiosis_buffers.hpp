@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_EVOLVETS_MEIOSIS_BUFFERS_HPP
+#define FWDPY11_EVOLVETS_MEIOSIS_BUFFERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fwdpy11
+{
+    template <typename T> class vector_pool
+    /// A stack of cleared vectors whose storage is reused.
+    ///
+    /// fwdpp's genetic parameter callbacks return vectors
+    /// by value.  Taking a vector from the pool and returning
+    /// it once the offspring is recorded means that, after a
+    /// few generations, no heap allocation happens in the
+    /// meiosis hot loop.
+    ///
+    /// allocations() counts the number of times a caller
+    /// reported that a vector's capacity had to grow, which
+    /// is when the heap is touched.  In steady state, it
+    /// stops increasing.
+    {
+      private:
+        std::vector<std::vector<T>> pool_;
+        std::size_t allocations_;
+
+      public:
+        vector_pool() : pool_{}, allocations_{0}
+        {
+        }
+
+        std::vector<T>
+        acquire()
+        {
+            if (pool_.empty())
+                {
+                    return {};
+                }
+            auto rv = std::move(pool_.back());
+            pool_.pop_back();
+            rv.clear();
+            return rv;
+        }
+
+        void
+        release(std::vector<T>& v)
+        // Empty vectors hold no storage and are not kept.
+        {
+            if (v.capacity() > 0)
+                {
+                    pool_.emplace_back(std::move(v));
+                    v.clear();
+                }
+        }
+
+        void
+        record_growth(std::size_t capacity_before, const std::vector<T>& v)
+        {
+            if (v.capacity() != capacity_before)
+                {
+                    ++allocations_;
+                }
+        }
+
+        std::size_t
+        allocations() const
+        {
+            return allocations_;
+        }
+
+        std::size_t
+        size() const
+        {
+            return pool_.size();
+        }
+
+        std::size_t
+        capacity() const
+        // Total number of elements that pooled vectors can hold.
+        {
+            std::size_t rv = 0;
+            for (const auto& v : pool_)
+                {
+                    rv += v.capacity();
+                }
+            return rv;
+        }
+    };
+
+    struct MeiosisBuffers
+    /// Scratch storage for the breakpoints and new mutation
+    /// keys generated for each offspring genome.
+    {
+        vector_pool<double> breakpoints;
+        vector_pool<std::uint32_t> mutation_keys;
+
+        MeiosisBuffers() : breakpoints{}, mutation_keys{}
+        {
+        }
+
+        template <typename MutRecIntermediates>
+        void
+        recycle(MutRecIntermediates& intermediates)
+        // Return the storage held by fwdpp::ts::mut_rec_intermediates
+        {
+            breakpoints.release(intermediates.breakpoints);
+            mutation_keys.release(intermediates.mutation_keys);
+        }
+
+        std::size_t
+        allocations() const
+        {
+            return breakpoints.allocations() + mutation_keys.allocations();
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -27,10 +27,11 @@
 #include <fwdpp/ts/table_collection_functions.hpp>
 #include <fwdpp/ts/recording/edge_buffer.hpp>
 #include <fwdpp/ts/simplify_tables.hpp>
-#include <fwdpp/ts/count_mutations.hpp>
+#include "count_mutations.hpp"
 #include <fwdpp/ts/recycling.hpp>
 #include <fwdpp/ts/remove_fixations_from_gametes.hpp>
 #include <fwdpp/internal/sample_diploid_helpers.hpp>
+#include "discrete_genome.hpp"
 //#include "confirm_mutation_counts.hpp"
 
 namespace fwdpy11
@@ -49,7 +50,14 @@ namespace fwdpy11
         const bool simulating_neutral_variants, const bool suppress_edge_table_indexing)
     {
         // As of 0.8.0, we do not need to sort edges!
-        fwdpp::ts::sort_mutation_table(tables);
+        if (pop.mut_lookup.discrete())
+            {
+                sort_mutation_table_discrete(tables);
+            }
+        else
+            {
+                fwdpp::ts::sort_mutation_table(tables);
+            }
         pop.fill_alive_nodes();
         pop.fill_preserved_nodes();
         auto samples(pop.alive_nodes);
@@ -72,14 +80,9 @@ namespace fwdpy11
             {
                 preserved[p] = 1;
             }
-        for (std::size_t p = 0; p < preserved.size(); ++p)
-            {
-                if (!preserved[p])
-                    {
-                        fwdpp::ts::detail::process_mutation_index(pop.mutations,
-                                                                  pop.mut_lookup, p);
-                    }
-            }
+        pop.mut_lookup.erase_if([&preserved](const auto &entry) {
+            return preserved[entry.second] == 0;
+        });
 
         if (suppress_edge_table_indexing == true)
             {
@@ -90,9 +93,12 @@ namespace fwdpy11
         pop.tables->build_indexes();
         if (pop.ancient_sample_metadata.empty())
             {
-                fwdpp::ts::count_mutations(tables, pop.mutations, pop.alive_nodes,
-                                           pop.preserved_sample_nodes,
-                                           pop.mcounts, mcounts_from_preserved_nodes);
+                // Simulations count with a single thread so
+                // that they do not oversubscribe the CPUs when
+                // many are run at once.
+                fwdpy11::count_mutations(tables, pop.mutations, pop.alive_nodes,
+                                         pop.preserved_sample_nodes, pop.mcounts,
+                                         mcounts_from_preserved_nodes, 1);
             }
         else
             {
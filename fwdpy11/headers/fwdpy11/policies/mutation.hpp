@@ -21,12 +21,42 @@
 #define FWDPY11_POLICIES_HPP__
 
 #include <cstdint>
+#include <stdexcept>
 #include <fwdpy11/types/Population.hpp>
 #include <fwdpy11/types/Mutation.hpp>
 #include <fwdpp/simfunctions/recycling.hpp>
 
 namespace fwdpy11
 {
+    // Number of positions drawn for a new mutation before giving up.
+    // Matches the limit used when adding neutral mutations to tables.
+    constexpr unsigned max_position_attempts = 1000;
+
+    template <typename position_function>
+    double
+    new_mutation_position(const Population::lookup_table_t &lookup,
+                          const position_function &posmaker)
+    // Draw positions until one is not in lookup.
+    // The number of draws is bounded because, for a
+    // discrete genome, a region may run out of sites
+    // before the rest of the genome does.
+    {
+        if (lookup.all_sites_occupied())
+            {
+                throw std::runtime_error(
+                    "all sites in the discrete genome already have mutations");
+            }
+        for (unsigned attempt = 0; attempt < max_position_attempts; ++attempt)
+            {
+                auto pos = lookup.canonical_position(posmaker());
+                if (lookup.find(pos) == lookup.end())
+                    {
+                        return pos;
+                    }
+            }
+        throw std::runtime_error("unable to find an unoccupied site for a new mutation");
+    }
+
     template <typename position_function, typename effect_size_function,
               typename dominance_function>
     std::size_t
@@ -66,13 +96,14 @@ namespace fwdpy11
      * \note "Neutral" mutations get assigned a dominance of zero.  The xtra
      * field is not written to.
      *
+     * \note If lookup is in discrete genome mode, positions are
+     * rounded down to the nearest integer.  If no unoccupied site
+     * is found after max_position_attempts draws, which happens once
+     * every site in a region has a mutation, std::runtime_error is thrown.
+     *
      */
     {
-        auto pos = posmaker();
-        while (lookup.find(pos) != lookup.end())
-            {
-                pos = posmaker();
-            }
+        auto pos = new_mutation_position(lookup, posmaker);
         auto esize = esize_maker();
         auto dominance = hmaker(esize);
         auto idx = fwdpp::recycle_mutation_helper(recycling_bin, mutations,
@@ -124,13 +155,14 @@ namespace fwdpy11
      * \note "Neutral" mutations get assigned a dominance of zero.  The xtra
      * field is not written to.
      *
+     * \note If lookup is in discrete genome mode, positions are
+     * rounded down to the nearest integer.  If no unoccupied site
+     * is found after max_position_attempts draws, which happens once
+     * every site in a region has a mutation, std::runtime_error is thrown.
+     *
      */
     {
-        auto pos = posmaker();
-        while (lookup.find(pos) != lookup.end())
-            {
-                pos = posmaker();
-            }
+        auto pos = new_mutation_position(lookup, posmaker);
         auto esize = fixed_esize_maker();
         auto fixed_dominance = fixed_hmaker(esize);
         auto idx = fwdpp::recycle_mutation_helper(
@@ -32,7 +32,7 @@ namespace fwdpy11
         std::uint32_t
         operator()(fwdpp::flagged_mutation_queue& recycling_bin,
                    std::vector<Mutation>& mutations,
-                   std::unordered_multimap<double, std::uint32_t>& lookup_table,
+                   MutationPositionLookup& lookup_table,
                    const std::uint32_t generation, const GSLrng_t& rng) const override
         {
             return infsites_Mutation(
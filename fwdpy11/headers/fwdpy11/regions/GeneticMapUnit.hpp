@@ -33,6 +33,28 @@
 
 namespace fwdpy11
 {
+    struct GeneticMapUnitParameters
+    /// Plain description of a genetic map unit.
+    /// Used to compile many units into a single
+    /// AggregatedGeneticMap.
+    {
+        enum class unit_type
+        {
+            poisson_interval,
+            poisson_point,
+            binomial_interval,
+            binomial_point,
+            fixed_crossovers
+        };
+        unit_type type;
+        /// For point units, beg == end == the position
+        double beg, end;
+        /// The mean, probability, or number of crossovers,
+        /// depending on type.
+        double rate;
+        bool discrete;
+    };
+
     class GeneticMapUnit
     /// Base class To hold the low-level fwdpp
     /// types.  The python interface will create them,
@@ -43,10 +65,15 @@ namespace fwdpy11
 
         bool discrete_;
 
+        GeneticMapUnitParameters parameters_;
+
       public:
         using ll_ptr_t = std::unique_ptr<fwdpp::genetic_map_unit>;
-        explicit GeneticMapUnit(ll_ptr_t&& input, bool discrete)
-            : ll_map_unit(std::move(input)), discrete_(discrete)
+        explicit GeneticMapUnit(ll_ptr_t&& input, bool discrete,
+                                GeneticMapUnitParameters::unit_type type, double beg,
+                                double end, double rate)
+            : ll_map_unit(std::move(input)), discrete_(discrete),
+              parameters_{type, beg, end, rate, discrete}
         {
         }
         GeneticMapUnit(GeneticMapUnit&&)=default;
@@ -69,6 +96,12 @@ namespace fwdpy11
         {
             return discrete_;
         }
+
+        const GeneticMapUnitParameters&
+        parameters() const
+        {
+            return parameters_;
+        }
     };
 
     template <typename fwdpp_type_double, typename fwdpp_type_discrete>
@@ -101,7 +134,9 @@ namespace fwdpy11
         using trampoline_t = GeneticMapUnitInitializationTrampoline<
             fwdpp::poisson_interval, fwdpp::poisson_interval_t<std::int64_t>>;
         PoissonInterval(double begin, double end, double mean, bool discrete)
-            : GeneticMapUnit(trampoline_t()(discrete, begin, end, mean), discrete)
+            : GeneticMapUnit(trampoline_t()(discrete, begin, end, mean), discrete,
+                             GeneticMapUnitParameters::unit_type::poisson_interval,
+                             begin, end, mean)
         {
         }
     };
@@ -112,7 +147,9 @@ namespace fwdpy11
         using trampoline_t = GeneticMapUnitInitializationTrampoline<
             fwdpp::poisson_point, fwdpp::poisson_point_t<std::int64_t>>;
         PoissonPoint(double position, double mean, bool discrete)
-            : GeneticMapUnit(trampoline_t()(discrete, position, mean), discrete)
+            : GeneticMapUnit(trampoline_t()(discrete, position, mean), discrete,
+                             GeneticMapUnitParameters::unit_type::poisson_point,
+                             position, position, mean)
         {
         }
     };
@@ -122,7 +159,9 @@ namespace fwdpy11
         using trampoline_t = GeneticMapUnitInitializationTrampoline<
             fwdpp::binomial_interval, fwdpp::binomial_interval_t<std::int64_t>>;
         BinomialInterval(double begin, double end, double probability, bool discrete)
-            : GeneticMapUnit(trampoline_t()(discrete, begin, end, probability), discrete)
+            : GeneticMapUnit(trampoline_t()(discrete, begin, end, probability), discrete,
+                             GeneticMapUnitParameters::unit_type::binomial_interval,
+                             begin, end, probability)
         {
         }
     };
@@ -133,7 +172,9 @@ namespace fwdpy11
         using trampoline_t = GeneticMapUnitInitializationTrampoline<
             fwdpp::binomial_point, fwdpp::binomial_point_t<std::int64_t>>;
         BinomialPoint(double position, double probability, bool discrete)
-            : GeneticMapUnit(trampoline_t()(discrete, position, probability), discrete)
+            : GeneticMapUnit(trampoline_t()(discrete, position, probability), discrete,
+                             GeneticMapUnitParameters::unit_type::binomial_point,
+                             position, position, probability)
         {
         }
     };
@@ -144,7 +185,9 @@ namespace fwdpy11
             fwdpp::fixed_number_crossovers,
             fwdpp::fixed_number_crossovers_t<std::int64_t>>;
         FixedCrossovers(double begin, double end, int nxovers, bool discrete)
-            : GeneticMapUnit(trampoline_t()(discrete, begin, end, nxovers), discrete)
+            : GeneticMapUnit(trampoline_t()(discrete, begin, end, nxovers), discrete,
+                             GeneticMapUnitParameters::unit_type::fixed_crossovers,
+                             begin, end, nxovers)
         {
         }
     };
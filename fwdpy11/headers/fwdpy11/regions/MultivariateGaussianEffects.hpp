@@ -103,7 +103,7 @@ namespace fwdpy11
         virtual std::uint32_t
         operator()(fwdpp::flagged_mutation_queue &recycling_bin,
                    std::vector<Mutation> &mutations,
-                   std::unordered_multimap<double, std::uint32_t> &lookup_table,
+                   MutationPositionLookup &lookup_table,
                    const std::uint32_t generation, const GSLrng_t &rng) const override
         {
             int rv = gsl_ran_multivariate_gaussian(rng.get(), mu.get(), matrix.get(),
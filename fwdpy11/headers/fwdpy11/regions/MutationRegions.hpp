@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <memory>
+#include <algorithm>
 #include <fwdpp/gsl_discrete.hpp>
 #include <gsl/gsl_randist.h>
 #include "Region.hpp"
@@ -24,6 +25,30 @@ namespace fwdpy11
         {
         }
 
+        void
+        generate_mutations(const GSLrng_t& rng, const double total_mutation_rate,
+                           fwdpp::flagged_mutation_queue& recycling_bin,
+                           std::vector<Mutation>& mutations,
+                           MutationPositionLookup& mut_lookup,
+                           const fwdpp::uint_t generation,
+                           std::vector<fwdpp::uint_t>& keys) const
+        // Fill keys with the keys of new mutations, sorted
+        // by position.  The storage held by keys is reused.
+        {
+            keys.clear();
+            unsigned nmuts = gsl_ran_poisson(rng.get(), total_mutation_rate);
+            for (unsigned i = 0; i < nmuts; ++i)
+                {
+                    std::size_t x = gsl_ran_discrete(rng.get(), lookup.get());
+                    keys.push_back(regions[x]->operator()(recycling_bin, mutations,
+                                                          mut_lookup, generation, rng));
+                }
+            std::sort(begin(keys), end(keys),
+                      [&mutations](const fwdpp::uint_t a, const fwdpp::uint_t b) {
+                          return mutations[a].pos < mutations[b].pos;
+                      });
+        }
+
         inline static MutationRegions
         create(double pneutral, std::vector<double>& nweights,
                std::vector<double>& sweights,
@@ -1,15 +1,18 @@
 #ifndef FWDPY11_RECOMBINATIONREGIONS_HPP
 #define FWDPY11_RECOMBINATIONREGIONS_HPP
 
+#include <cmath>
 #include <limits>
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <stdexcept>
 #include <fwdpp/gsl_discrete.hpp>
 #include <fwdpp/genetic_map/genetic_map_unit.hpp>
 #include <gsl/gsl_randist.h>
 #include <fwdpy11/rng.hpp>
 #include "Region.hpp"
+#include "GeneticMapUnit.hpp"
 
 namespace fwdpy11
 {
@@ -22,6 +25,15 @@ namespace fwdpy11
         GeneticMap& operator=(const GeneticMap&)=delete;
         GeneticMap& operator=(GeneticMap&&)=default;
         virtual std::vector<double> operator()(const GSLrng_t& rng) const = 0;
+
+        virtual void
+        generate_breakpoints(const GSLrng_t& rng, std::vector<double>& breakpoints) const
+        // Fill breakpoints with the output of operator().
+        // Derived classes may override this to reuse the
+        // memory already held by breakpoints.
+        {
+            breakpoints = this->operator()(rng);
+        }
     };
 
     struct RecombinationRegions : public GeneticMap
@@ -53,21 +65,29 @@ namespace fwdpy11
         std::vector<double>
         operator()(const GSLrng_t& rng) const final
         {
+            std::vector<double> rv;
+            generate_breakpoints(rng, rv);
+            return rv;
+        }
+
+        void
+        generate_breakpoints(const GSLrng_t& rng,
+                             std::vector<double>& breakpoints) const final
+        {
+            breakpoints.clear();
             unsigned nbreaks = gsl_ran_poisson(rng.get(), recrate);
             if (nbreaks == 0)
                 {
-                    return {};
+                    return;
                 }
-            std::vector<double> rv;
-            rv.reserve(nbreaks + 1);
+            breakpoints.reserve(nbreaks + 1);
             for (unsigned i = 0; i < nbreaks; ++i)
                 {
                     std::size_t x = gsl_ran_discrete(rng.get(), lookup.get());
-                    rv.push_back(regions[x](rng));
+                    breakpoints.push_back(regions[x](rng));
                 }
-            std::sort(begin(rv), end(rv));
-            rv.push_back(std::numeric_limits<double>::max());
-            return rv;
+            std::sort(begin(breakpoints), end(breakpoints));
+            breakpoints.push_back(std::numeric_limits<double>::max());
         }
     };
 
@@ -84,17 +104,188 @@ namespace fwdpy11
         operator()(const GSLrng_t& rng) const final
         {
             std::vector<double> rv;
+            generate_breakpoints(rng, rv);
+            return rv;
+        }
+
+        void
+        generate_breakpoints(const GSLrng_t& rng,
+                             std::vector<double>& breakpoints) const final
+        {
+            breakpoints.clear();
             for (auto&& c : callbacks)
                 {
-                    c->operator()(rng.get(), rv);
+                    c->operator()(rng.get(), breakpoints);
+                }
+            if (!breakpoints.empty())
+                {
+                    std::sort(begin(breakpoints), end(breakpoints));
+                    breakpoints.push_back(std::numeric_limits<double>::max());
+                }
+        }
+    };
+    struct AggregatedGeneticMap : public GeneticMap
+    /// A genetic map compiled from a list of GeneticMapUnitParameters.
+    ///
+    /// Rather than visiting every unit during each meiosis,
+    /// the total number of crossover events is drawn once from
+    /// a Poisson distribution whose mean is the sum over units.
+    /// Each event is assigned to a unit via a Walker alias table.
+    ///
+    /// A binomial unit with probability p is represented as a
+    /// Poisson unit with mean -log(1 - p) that contributes at most one
+    /// breakpoint, which is exact.  Poisson points contribute a
+    /// breakpoint if they receive an odd number of events, as in fwdpp.
+    /// Fixed crossovers, and binomial units with p = 1, are applied
+    /// to every meiosis.
+    {
+        std::vector<GeneticMapUnitParameters> pooled, always;
+        std::vector<double> weights;
+        fwdpp::gsl_ran_discrete_t_ptr lookup;
+        double total_rate;
+
+        explicit AggregatedGeneticMap(const std::vector<GeneticMapUnitParameters>& units)
+            : pooled{}, always{}, weights{}, lookup(nullptr), total_rate(0.0)
+        {
+            using unit_type = GeneticMapUnitParameters::unit_type;
+            for (auto& u : units)
+                {
+                    if (!std::isfinite(u.rate) || u.rate < 0.0)
+                        {
+                            throw std::invalid_argument(
+                                "genetic map unit rates must be finite and non-negative");
+                        }
+                    if (u.rate == 0.0)
+                        {
+                            continue;
+                        }
+                    switch (u.type)
+                        {
+                        case unit_type::fixed_crossovers:
+                            always.push_back(u);
+                            break;
+                        case unit_type::binomial_interval:
+                        case unit_type::binomial_point:
+                            if (u.rate > 1.0)
+                                {
+                                    throw std::invalid_argument(
+                                        "probability must be in [0, 1]");
+                                }
+                            if (u.rate == 1.0)
+                                {
+                                    always.push_back(u);
+                                    always.back().rate = 1.0;
+                                }
+                            else
+                                {
+                                    pooled.push_back(u);
+                                    weights.push_back(-std::log1p(-u.rate));
+                                }
+                            break;
+                        default:
+                            pooled.push_back(u);
+                            weights.push_back(u.rate);
+                        }
                 }
-            if (!rv.empty())
+            for (auto w : weights)
                 {
-                    std::sort(begin(rv), end(rv));
-                    rv.push_back(std::numeric_limits<double>::max());
+                    total_rate += w;
                 }
+            if (!weights.empty())
+                {
+                    lookup.reset(gsl_ran_discrete_preproc(weights.size(),
+                                                          weights.data()));
+                }
+        }
+
+        std::vector<double>
+        operator()(const GSLrng_t& rng) const final
+        {
+            std::vector<double> rv;
+            generate_breakpoints(rng, rv);
             return rv;
         }
+
+        void
+        generate_breakpoints(const GSLrng_t& rng,
+                             std::vector<double>& breakpoints) const final
+        {
+            using unit_type = GeneticMapUnitParameters::unit_type;
+            breakpoints.clear();
+            for (auto& u : always)
+                {
+                    for (unsigned i = 0; i < static_cast<unsigned>(u.rate); ++i)
+                        {
+                            breakpoints.push_back(position(rng, u));
+                        }
+                }
+            unsigned nevents = (lookup == nullptr)
+                                   ? 0
+                                   : gsl_ran_poisson(rng.get(), total_rate);
+            if (nevents > 0)
+                {
+                    // Unit indexes are stored temporarily in the
+                    // output buffer and then replaced, in place,
+                    // by the breakpoints that they generate.
+                    // No run of k events generates more than k
+                    // breakpoints, so writes never overtake reads.
+                    auto first = breakpoints.size();
+                    for (unsigned i = 0; i < nevents; ++i)
+                        {
+                            breakpoints.push_back(static_cast<double>(
+                                gsl_ran_discrete(rng.get(), lookup.get())));
+                        }
+                    std::sort(begin(breakpoints) + first, end(breakpoints));
+                    auto out = first;
+                    for (auto i = first; i < breakpoints.size();)
+                        {
+                            auto j = i + 1;
+                            while (j < breakpoints.size()
+                                   && breakpoints[j] == breakpoints[i])
+                                {
+                                    ++j;
+                                }
+                            const auto& u
+                                = pooled[static_cast<std::size_t>(breakpoints[i])];
+                            switch (u.type)
+                                {
+                                case unit_type::poisson_interval:
+                                    for (auto k = i; k < j; ++k)
+                                        {
+                                            breakpoints[out++] = position(rng, u);
+                                        }
+                                    break;
+                                case unit_type::poisson_point:
+                                    if ((j - i) % 2 == 1)
+                                        {
+                                            breakpoints[out++] = u.beg;
+                                        }
+                                    break;
+                                default:
+                                    breakpoints[out++] = position(rng, u);
+                                }
+                            i = j;
+                        }
+                    breakpoints.resize(out);
+                }
+            if (!breakpoints.empty())
+                {
+                    std::sort(begin(breakpoints), end(breakpoints));
+                    breakpoints.push_back(std::numeric_limits<double>::max());
+                }
+        }
+
+      private:
+        static double
+        position(const GSLrng_t& rng, const GeneticMapUnitParameters& u)
+        {
+            if (u.beg == u.end)
+                {
+                    return u.beg;
+                }
+            auto x = gsl_ran_flat(rng.get(), u.beg, u.end);
+            return u.discrete ? std::floor(x) : x;
+        }
     };
 } // namespace fwdpy11
 
@@ -5,7 +5,7 @@
 #include <vector>
 #include <cmath>
 #include <cstdint>
-#include <unordered_map>
+#include <fwdpy11/types/MutationPositionLookup.hpp>
 #include <fwdpp/forward_types.hpp>
 #include <fwdpp/simfunctions/recycling.hpp>
 #include <fwdpy11/types/Mutation.hpp>
@@ -73,7 +73,7 @@ namespace fwdpy11
         virtual std::uint32_t
         operator()(fwdpp::flagged_mutation_queue& /*recycling_bin*/,
                    std::vector<Mutation>& /*mutations*/,
-                   std::unordered_multimap<double, std::uint32_t>& /*lookup_table*/,
+                   MutationPositionLookup& /*lookup_table*/,
                    const std::uint32_t /*generation*/,
                    const GSLrng_t& /*rng*/) const = 0;
         // Added in 0.7.0.  We now require that these types
@@ -30,6 +30,9 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_cdf.h>
 #include <gsl/gsl_errno.h>
 #include <limits>
 #include <locale>
@@ -51,7 +54,7 @@ namespace fwdpy11
             = std::unique_ptr<gsl_vector, std::function<void(gsl_vector *)>>;
         using callback_type = std::function<std::uint32_t(
             const mvDES *, fwdpp::flagged_mutation_queue &r, std::vector<Mutation> &,
-            std::unordered_multimap<double, std::uint32_t> &, const std::uint32_t,
+            MutationPositionLookup &, const std::uint32_t,
             const GSLrng_t &)>;
 
         struct default_callback
@@ -60,23 +63,20 @@ namespace fwdpy11
             operator()(const mvDES *outer_this,
                        fwdpp::flagged_mutation_queue &recycling_bin,
                        std::vector<Mutation> &mutations,
-                       std::unordered_multimap<double, std::uint32_t> &lookup_table,
+                       MutationPositionLookup &lookup_table,
                        const std::uint32_t generation, const GSLrng_t &rng) const
             {
-                outer_this->generate_deviates(rng);
-                for (std::size_t i = 0; i < outer_this->deviates.size(); ++i)
+                if (outer_this->block_exhausted())
                     {
-                        // Subtract means from the deviates so we
-                        // can use N(0, sigma[i]) cdf.
-                        outer_this->deviates[i]
-                            = outer_this->output_distributions[i]->from_mvnorm(
-                                outer_this->deviates[i],
-                                gsl_cdf_gaussian_P(outer_this->deviates[i]
-                                                       - outer_this->means[i],
-                                                   outer_this->stddev[i]));
-                        outer_this->dominance_values[i]
-                            = outer_this->output_distributions[i]->generate_dominance(
-                                rng, outer_this->deviates[i]);
+                        outer_this->generate_deviates(rng);
+                        for (std::size_t i = 0; i < outer_this->deviates.size(); ++i)
+                            {
+                                // Subtract means from the deviates so we
+                                // can use N(0, sigma[i]) cdf.
+                                outer_this->transform_deviates(
+                                    i, *outer_this->output_distributions[i],
+                                    outer_this->means[i], rng);
+                            }
                     }
                 return outer_this->generate_mutation(recycling_bin, mutations,
                                                      lookup_table, generation, rng);
@@ -89,35 +89,79 @@ namespace fwdpy11
             operator()(const mvDES *outer_this,
                        fwdpp::flagged_mutation_queue &recycling_bin,
                        std::vector<Mutation> &mutations,
-                       std::unordered_multimap<double, std::uint32_t> &lookup_table,
+                       MutationPositionLookup &lookup_table,
                        const std::uint32_t generation, const GSLrng_t &rng) const
             {
-                outer_this->generate_deviates(rng);
-                for (std::size_t i = 0; i < outer_this->deviates.size(); ++i)
+                if (outer_this->block_exhausted())
                     {
-                        outer_this->deviates[i]
-                            = outer_this->output_distributions[0]->from_mvnorm(
-                                outer_this->deviates[i],
-                                gsl_cdf_gaussian_P(outer_this->deviates[i],
-                                                   outer_this->stddev[i]));
-                        outer_this->dominance_values[i]
-                            = outer_this->output_distributions[0]->generate_dominance(
-                                rng, outer_this->deviates[i]);
+                        outer_this->generate_deviates(rng);
+                        for (std::size_t i = 0; i < outer_this->deviates.size(); ++i)
+                            {
+                                outer_this->transform_deviates(
+                                    i, *outer_this->output_distributions[0], 0.0, rng);
+                            }
                     }
                 return outer_this->generate_mutation(recycling_bin, mutations,
                                                      lookup_table, generation, rng);
             }
         };
 
+        // The number of mutations whose effect sizes
+        // are generated at once.
+        static constexpr std::size_t deviate_block_size = 64;
+
+        bool
+        block_exhausted() const
+        {
+            return next_block_row == deviate_block_size;
+        }
+
         void
         generate_deviates(const GSLrng_t &rng) const
+        // Fill each row of the block with a multivariate
+        // Gaussian deviate.  This is the same algorithm as
+        // gsl_ran_multivariate_gaussian, applied to all rows
+        // at once by multiplying a matrix of standard normal
+        // deviates by the transpose of the Cholesky factor.
         {
-            int rv = gsl_ran_multivariate_gaussian(rng.get(), &mu.vector, matrix.get(),
-                                                   &res.vector);
+            for (auto &z : deviate_block)
+                {
+                    z = gsl_ran_ugaussian(rng.get());
+                }
+            auto block = gsl_matrix_view_array(deviate_block.data(), deviate_block_size,
+                                               deviates.size());
+            int rv = gsl_blas_dtrmm(CblasRight, CblasLower, CblasTrans, CblasNonUnit,
+                                    1.0, matrix.get(), &block.matrix);
             if (rv != GSL_SUCCESS)
                 {
-                    throw std::runtime_error(
-                        "call to gsl_ran_multivariate_gaussian failed");
+                    throw std::runtime_error("call to gsl_blas_dtrmm failed");
+                }
+            for (std::size_t row = 0; row < deviate_block_size; ++row)
+                {
+                    auto x = deviate_block.data() + row * deviates.size();
+                    for (std::size_t i = 0; i < means.size(); ++i)
+                        {
+                            x[i] += means[i];
+                        }
+                }
+            next_block_row = 0;
+        }
+
+        void
+        transform_deviates(std::size_t column, const Sregion &odist, const double mean,
+                           const GSLrng_t &rng) const
+        // Map one column of the block, which is a marginal of
+        // the multivariate Gaussian, to the output distribution
+        // and generate the dominance of each value.
+        {
+            const auto ndim = deviates.size();
+            const auto sd = stddev[column];
+            for (std::size_t row = 0; row < deviate_block_size; ++row)
+                {
+                    auto &x = deviate_block[row * ndim + column];
+                    x = odist.from_mvnorm(x, gsl_cdf_gaussian_P(x - mean, sd));
+                    dominance_block[row * ndim + column]
+                        = odist.generate_dominance(rng, x);
                 }
         }
 
@@ -127,6 +171,14 @@ namespace fwdpy11
                           Population::lookup_table_t &lookup_table,
                           const fwdpp::uint_t &generation, const GSLrng_t &rng) const
         {
+            // Take the next row of the block
+            const auto ndim = deviates.size();
+            auto first = next_block_row * ndim;
+            std::copy(deviate_block.begin() + first,
+                      deviate_block.begin() + first + ndim, deviates.begin());
+            std::copy(dominance_block.begin() + first,
+                      dominance_block.begin() + first + ndim, dominance_values.begin());
+            ++next_block_row;
             return infsites_Mutation(
                 recycling_bin, mutations, lookup_table, false, generation,
                 [this, &rng]() { return this->region(rng); }, []() { return 0.0; },
@@ -286,10 +338,11 @@ namespace fwdpy11
         std::vector<std::unique_ptr<Sregion>> output_distributions;
         matrix_ptr vcov_copy, matrix;
         mutable std::vector<double> deviates, dominance_values, means;
-        // Stores the results of gsl_ran_multivariate_gaussian
-        mutable gsl_vector_view res;
-        // Stores the means of the mvn distribution, which are all zero
-        gsl_vector_const_view mu;
+        // Row-major blocks of deviates and dominance values
+        // for deviate_block_size mutations.  Rows are used
+        // in order, starting from next_block_row.
+        mutable std::vector<double> deviate_block, dominance_block;
+        mutable std::size_t next_block_row;
         std::vector<double> stddev;
         const bool lognormal_init, mvgaussian_init;
         const callback_type callback;
@@ -304,9 +357,9 @@ namespace fwdpy11
               vcov_copy(copy_input_matrix(vcov)), matrix(decompose()),
               deviates(vcov.size1), dominance_values(fill_dominance(odist)),
               means(std::move(gaussian_means)),
-              res(gsl_vector_view_array(deviates.data(), deviates.size())),
-              // NOTE: use of calloc to initialize mu to all zeros
-              mu(gsl_vector_const_view_array(means.data(), means.size())),
+              deviate_block(deviate_block_size * vcov.size1),
+              dominance_block(deviate_block_size * vcov.size1),
+              next_block_row(deviate_block_size),
               stddev(get_standard_deviations()), lognormal_init(false),
               mvgaussian_init(false), callback(default_callback())
         {
@@ -326,9 +379,9 @@ namespace fwdpy11
               dominance_values(gaussian_means.size(),
                                std::numeric_limits<double>::quiet_NaN()),
               means(std::move(gaussian_means)),
-              res(gsl_vector_view_array(deviates.data(), deviates.size())),
-              // NOTE: use of calloc to initialize mu to all zeros
-              mu(gsl_vector_const_view_array(means.data(), means.size())),
+              deviate_block(deviate_block_size * vcov.size1),
+              dominance_block(deviate_block_size * vcov.size1),
+              next_block_row(deviate_block_size),
               stddev(get_standard_deviations()), lognormal_init(true),
               mvgaussian_init(false), callback(specialized_callback())
         {
@@ -343,9 +396,9 @@ namespace fwdpy11
               vcov_copy(copy_input_matrix(*(odist.input_matrix_copy))),
               matrix(decompose()), deviates(odist.input_matrix_copy->size1),
               dominance_values(odist.dominance_values), means(std::move(gaussian_means)),
-              res(gsl_vector_view_array(deviates.data(), deviates.size())),
-              // NOTE: use of calloc to initialize mu to all zeros
-              mu(gsl_vector_const_view_array(means.data(), means.size())),
+              deviate_block(deviate_block_size * odist.input_matrix_copy->size1),
+              dominance_block(deviate_block_size * odist.input_matrix_copy->size1),
+              next_block_row(deviate_block_size),
               stddev(get_standard_deviations()), lognormal_init(false),
               mvgaussian_init(true), callback(specialized_callback())
         {
@@ -355,7 +408,7 @@ namespace fwdpy11
         std::uint32_t
         operator()(fwdpp::flagged_mutation_queue &recycling_bin,
                    std::vector<Mutation> &mutations,
-                   std::unordered_multimap<double, std::uint32_t> &lookup_table,
+                   MutationPositionLookup &lookup_table,
                    const std::uint32_t generation, const GSLrng_t &rng) const override
         {
             return callback(this, recycling_bin, mutations, lookup_table, generation,
@@ -0,0 +1,438 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_SPATIAL_SPATIALMATING_HPP
+#define FWDPY11_SPATIAL_SPATIALMATING_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gsl/gsl_randist.h>
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/Diploid.hpp>
+#include <fwdpy11/discrete_demography/simulation/pick_parents.hpp>
+
+namespace fwdpy11
+{
+    class SpatialMating
+    /// Mate choice, dispersal, and density regulation
+    /// in a continuous, two-dimensional, habitat.
+    ///
+    /// Positions are geography[0] and geography[1] of
+    /// DiploidMetadata and lie in [0, width] x [0, height].
+    /// The first parent is chosen as in non-spatial models.
+    /// The second is chosen from the first parent's deme with
+    /// probability proportional to fitness times a Gaussian
+    /// kernel in distance, truncated at mating_radius.
+    /// Offspring are placed at the first parent's position
+    /// plus Gaussian noise, reflected at the habitat edges.
+    ///
+    /// Density regulation does not change DiploidMetadata::w.
+    /// The factors are kept in density() and multiply fitness
+    /// only when parents are chosen.
+    ///
+    /// Neighbors are found with a uniform grid whose cells
+    /// are no smaller than mating_radius, so only the 3x3 block
+    /// of cells around an individual is searched.  The grid is
+    /// rebuilt once per generation by update().
+    ///
+    /// When individuals are clustered, a block may contain
+    /// most of the population.  If a block holds more than
+    /// max_candidates individuals, that many are sampled with
+    /// replacement from it.  Neighbor counts are then estimated
+    /// from the sample and mates are chosen among the sampled
+    /// individuals, bounding the work per individual.
+    {
+      private:
+        double cell_size;
+        std::size_t nx, ny;
+        // Labels of individuals sorted by cell.  The members of
+        // cell c are cell_members[cell_starts[c]:cell_starts[c+1]].
+        std::vector<std::size_t> cell_starts;
+        std::vector<std::size_t> cell_members;
+        std::vector<std::size_t> individual_cells;
+        std::vector<std::size_t> candidates;
+        std::vector<double> weights;
+        std::vector<std::pair<std::size_t, std::size_t>> block_ranges;
+        // Density regulation factor of each individual
+        std::vector<double> density_factors;
+
+        static double
+        reflect(double x, double upper)
+        {
+            x = std::fmod(x, 2. * upper);
+            if (x < 0.)
+                {
+                    x += 2. * upper;
+                }
+            if (x > upper)
+                {
+                    x = 2. * upper - x;
+                }
+            return x;
+        }
+
+        std::size_t
+        cell_coordinate(double x, std::size_t n) const
+        {
+            auto c = static_cast<std::size_t>(x / cell_size);
+            return c < n ? c : n - 1;
+        }
+
+        std::size_t
+        fill_block(const DiploidMetadata& focal)
+        // Records the ranges of cell_members making up the 3x3
+        // block of cells around focal and returns their total size.
+        {
+            auto cx = cell_coordinate(focal.geography[0], nx);
+            auto cy = cell_coordinate(focal.geography[1], ny);
+            block_ranges.clear();
+            std::size_t total = 0;
+            for (std::size_t x = (cx > 0 ? cx - 1 : 0); x <= std::min(cx + 1, nx - 1);
+                 ++x)
+                {
+                    for (std::size_t y = (cy > 0 ? cy - 1 : 0);
+                         y <= std::min(cy + 1, ny - 1); ++y)
+                        {
+                            auto c = x * ny + y;
+                            if (cell_starts[c + 1] > cell_starts[c])
+                                {
+                                    block_ranges.emplace_back(cell_starts[c],
+                                                              cell_starts[c + 1]);
+                                    total += cell_starts[c + 1] - cell_starts[c];
+                                }
+                        }
+                }
+            return total;
+        }
+
+        std::size_t
+        block_member(std::size_t k) const
+        // The k-th individual in the block recorded by fill_block
+        {
+            for (auto& r : block_ranges)
+                {
+                    if (k < r.second - r.first)
+                        {
+                            return cell_members[r.first + k];
+                        }
+                    k -= r.second - r.first;
+                }
+            throw std::runtime_error("block index out of range");
+        }
+
+        template <typename F>
+        std::size_t
+        for_each_neighbor(const GSLrng_t& rng,
+                          const std::vector<DiploidMetadata>& metadata,
+                          const DiploidMetadata& focal, F f)
+        // Calls f(j, squared distance) for each individual j != focal
+        // in the same deme and within mating_radius of focal.
+        // If the block around focal holds more than max_candidates
+        // individuals, only a sample of max_candidates of them is
+        // visited.  Returns the number of individuals in the block.
+        {
+            auto r2 = mating_radius * mating_radius;
+            auto visit = [&metadata, &focal, &f, r2](std::size_t j) {
+                const auto& md = metadata[j];
+                if (md.label == focal.label || md.deme != focal.deme)
+                    {
+                        return;
+                    }
+                auto dx = md.geography[0] - focal.geography[0];
+                auto dy = md.geography[1] - focal.geography[1];
+                auto d2 = dx * dx + dy * dy;
+                if (d2 <= r2)
+                    {
+                        f(j, d2);
+                    }
+            };
+            auto total = fill_block(focal);
+            if (total <= max_candidates)
+                {
+                    for (auto& r : block_ranges)
+                        {
+                            for (auto k = r.first; k < r.second; ++k)
+                                {
+                                    visit(cell_members[k]);
+                                }
+                        }
+                }
+            else
+                {
+                    for (std::size_t i = 0; i < max_candidates; ++i)
+                        {
+                            visit(block_member(gsl_rng_uniform_int(rng.get(), total)));
+                        }
+                }
+            return total;
+        }
+
+      public:
+        const double width, height, mating_sigma, mating_radius, dispersal_sigma,
+            local_capacity;
+        const std::size_t max_candidates;
+
+        SpatialMating(double width_, double height_, double mating_sigma_,
+                      double dispersal_sigma_, double local_capacity_,
+                      std::size_t max_candidates_)
+            : cell_size{}, nx{}, ny{}, cell_starts{}, cell_members{},
+              individual_cells{}, candidates{}, weights{}, block_ranges{},
+              density_factors{},
+              width(width_), height(height_), mating_sigma(mating_sigma_),
+              mating_radius(3. * mating_sigma_), dispersal_sigma(dispersal_sigma_),
+              local_capacity(local_capacity_), max_candidates(max_candidates_)
+        {
+            if (max_candidates == 0)
+                {
+                    throw std::invalid_argument("max_candidates must be positive");
+                }
+            for (auto v : {width, height, mating_sigma})
+                {
+                    if (!std::isfinite(v) || !(v > 0.))
+                        {
+                            throw std::invalid_argument(
+                                "habitat dimensions and mating_sigma must be "
+                                "positive and finite");
+                        }
+                }
+            for (auto v : {dispersal_sigma, local_capacity})
+                {
+                    if (!std::isfinite(v) || v < 0.)
+                        {
+                            throw std::invalid_argument(
+                                "dispersal_sigma and local_capacity must be "
+                                "non-negative and finite");
+                        }
+                }
+        }
+
+        virtual ~SpatialMating() = default;
+        SpatialMating(const SpatialMating&) = default;
+        SpatialMating& operator=(const SpatialMating&) = delete;
+
+        virtual double
+        density_regulation(const DiploidMetadata& /*individual*/,
+                           std::size_t num_neighbors) const
+        // Returns the factor by which an individual's fitness is
+        // multiplied, given the number of individuals in the same
+        // deme within mating_radius.  The default is Beverton-Holt
+        // regulation towards local_capacity.  A value of zero for
+        // local_capacity disables regulation.
+        {
+            if (local_capacity == 0.)
+                {
+                    return 1.;
+                }
+            return 1. / (1. + static_cast<double>(num_neighbors) / local_capacity);
+        }
+
+        void
+        build_index(const std::vector<DiploidMetadata>& metadata)
+        {
+            // Cells are at least mating_radius wide, and we allow
+            // no more than about 4 cells per individual.
+            auto n = static_cast<double>(std::max<std::size_t>(metadata.size(), 1));
+            double min_cell = std::sqrt(width * height / (4. * n));
+            cell_size = std::max(mating_radius, min_cell);
+            nx = std::max<std::size_t>(
+                1, static_cast<std::size_t>(std::ceil(width / cell_size)));
+            ny = std::max<std::size_t>(
+                1, static_cast<std::size_t>(std::ceil(height / cell_size)));
+            cell_starts.assign(nx * ny + 1, 0);
+            individual_cells.resize(metadata.size());
+            for (std::size_t i = 0; i < metadata.size(); ++i)
+                {
+                    const auto& g = metadata[i].geography;
+                    if (!(g[0] >= 0. && g[0] <= width && g[1] >= 0. && g[1] <= height))
+                        {
+                            throw std::runtime_error(
+                                "individual position is outside of the habitat");
+                        }
+                    individual_cells[i]
+                        = cell_coordinate(g[0], nx) * ny + cell_coordinate(g[1], ny);
+                    ++cell_starts[individual_cells[i] + 1];
+                }
+            for (std::size_t c = 1; c < cell_starts.size(); ++c)
+                {
+                    cell_starts[c] += cell_starts[c - 1];
+                }
+            // Counting sort of labels by cell
+            cell_members.resize(metadata.size());
+            std::vector<std::size_t> next(cell_starts.begin(), cell_starts.end() - 1);
+            for (std::size_t i = 0; i < metadata.size(); ++i)
+                {
+                    cell_members[next[individual_cells[i]]++] = i;
+                }
+        }
+
+        void
+        validate_positions(const std::vector<DiploidMetadata>& metadata) const
+        // Called before a simulation starts.  Throws if any position
+        // is outside of the habitat, or if every individual is still at
+        // the origin, which is where DiploidMetadata places them by default.
+        {
+            bool all_at_origin = metadata.size() > 1;
+            for (const auto& md : metadata)
+                {
+                    const auto& g = md.geography;
+                    if (!(g[0] >= 0. && g[0] <= width && g[1] >= 0. && g[1] <= height))
+                        {
+                            throw std::invalid_argument(
+                                "individual position is outside of the habitat");
+                        }
+                    if (g[0] != 0. || g[1] != 0.)
+                        {
+                            all_at_origin = false;
+                        }
+                }
+            if (all_at_origin)
+                {
+                    throw std::invalid_argument(
+                        "all individuals are at the origin; positions must be "
+                        "assigned before the simulation starts");
+                }
+        }
+
+        void
+        update(const GSLrng_t& rng, const std::vector<DiploidMetadata>& metadata)
+        // Build the index over the individuals that will be the
+        // parents of the next generation and find their density
+        // regulation factors.
+        {
+            build_index(metadata);
+            auto& factors = density_factors;
+            factors.assign(metadata.size(), 1.);
+            for (std::size_t i = 0; i < metadata.size(); ++i)
+                {
+                    std::size_t n = 0;
+                    auto total = for_each_neighbor(rng, metadata, metadata[i],
+                                                   [&n](std::size_t, double) { ++n; });
+                    if (total > max_candidates)
+                        // Scale the count in the sample up to the block.
+                        {
+                            n = static_cast<std::size_t>(std::llround(
+                                static_cast<double>(n) * static_cast<double>(total)
+                                / static_cast<double>(max_candidates)));
+                        }
+                    factors[i] = density_regulation(metadata[i], n);
+                    if (!std::isfinite(factors[i]) || factors[i] < 0.)
+                        {
+                            throw std::runtime_error(
+                                "density regulation must return a non-negative, "
+                                "finite, value");
+                        }
+                }
+        }
+
+        const std::vector<double>&
+        density() const
+        // The density regulation factors found by the last call
+        // to update(), indexed in the same order as the metadata.
+        // Parents are chosen with weights w * density()[i].
+        {
+            return density_factors;
+        }
+
+        std::size_t
+        pick_mate(const GSLrng_t& rng, std::size_t parent1,
+                  const std::vector<DiploidMetadata>& metadata)
+        // Returns std::numeric_limits<std::size_t>::max()
+        // if there is no candidate mate.  When the block around
+        // parent1 is larger than max_candidates, the mate is
+        // chosen among a sample of that size.
+        {
+            candidates.clear();
+            weights.clear();
+            double total = 0.0;
+            auto denom = 2. * mating_sigma * mating_sigma;
+            for_each_neighbor(rng, metadata, metadata[parent1],
+                              [this, &total, &metadata, denom](std::size_t j, double d2) {
+                                  auto w = metadata[j].w * density_factors[j]
+                                           * std::exp(-d2 / denom);
+                                  if (w > 0.)
+                                      {
+                                          total += w;
+                                          candidates.push_back(j);
+                                          weights.push_back(total);
+                                      }
+                              });
+            if (candidates.empty())
+                {
+                    return std::numeric_limits<std::size_t>::max();
+                }
+            auto u = gsl_rng_uniform(rng.get()) * total;
+            auto itr = std::upper_bound(begin(weights), end(weights), u);
+            if (itr == end(weights))
+                {
+                    --itr;
+                }
+            return candidates[std::distance(begin(weights), itr)];
+        }
+
+        discrete_demography::parent_data
+        pick_parents(const GSLrng_t& rng, const std::int32_t offspring_deme,
+                     const discrete_demography::migration_lookup& miglookup,
+                     const discrete_demography::current_deme_sizes_vector&
+                         current_deme_sizes,
+                     const discrete_demography::selfing_rates_vector& selfing_rates,
+                     const discrete_demography::multideme_fitness_lookups<std::uint32_t>&
+                         wlookups,
+                     const std::vector<DiploidMetadata>& metadata)
+        // Analogous to discrete_demography::pick_parents.
+        // If the first parent has no candidate mates, the second
+        // parent is chosen from its deme without regard to space.
+        {
+            auto pdeme
+                = discrete_demography::pick_parental_deme(rng, offspring_deme, miglookup);
+            std::size_t p1 = wlookups.get_parent(rng, current_deme_sizes, pdeme);
+            if (selfing_rates.get()[pdeme] > 0.
+                && gsl_rng_uniform(rng.get()) <= selfing_rates.get()[pdeme])
+                {
+                    return {p1, p1, pdeme, pdeme,
+                            discrete_demography::mating_event_type::selfing};
+                }
+            auto p2 = pick_mate(rng, p1, metadata);
+            if (p2 == std::numeric_limits<std::size_t>::max())
+                {
+                    p2 = wlookups.get_parent(rng, current_deme_sizes, pdeme);
+                }
+            return {p1, p2, pdeme, pdeme,
+                    discrete_demography::mating_event_type::outcrossing};
+        }
+
+        void
+        disperse(const GSLrng_t& rng, const DiploidMetadata& parent,
+                 DiploidMetadata& offspring) const
+        {
+            offspring.geography[0] = reflect(
+                parent.geography[0] + gsl_ran_gaussian(rng.get(), dispersal_sigma),
+                width);
+            offspring.geography[1] = reflect(
+                parent.geography[1] + gsl_ran_gaussian(rng.get(), dispersal_sigma),
+                height);
+            offspring.geography[2] = parent.geography[2];
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -0,0 +1,694 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_TYPES_MUTATION_POSITION_LOOKUP_HPP
+#define FWDPY11_TYPES_MUTATION_POSITION_LOOKUP_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <vector>
+#include <limits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+
+namespace fwdpy11
+{
+    class MutationPositionLookup
+    /*!
+     * Maps mutation positions to mutation keys.
+     *
+     * This type replaces std::unordered_multimap<double, std::uint32_t>
+     * as the lookup table used to enforce the infinitely-many sites
+     * model.  Storage is a single open-addressing table using linear
+     * probing, so that lookups touch contiguous memory and no per-entry
+     * heap allocations are made.
+     *
+     * The subset of the unordered_multimap API used by fwdpp and
+     * fwdpy11 is supported.  In addition, there are batched
+     * operations (erase_if, remap, insertion of ranges) that
+     * avoid rebuilding the table from scratch after simplification
+     * or after mutation keys are compacted.
+     *
+     * For discrete genomes, set_discrete_genome_length enables
+     * a bitmap of occupied sites.  Queries for unoccupied sites
+     * are then answered without touching the hash table, and
+     * positions are required to be integer-valued.
+     *
+     * \note Iterators are invalidated by any insertion.
+     * Erasure only invalidates iterators to the erased entry.
+     */
+    {
+      public:
+        using key_type = double;
+        using mapped_type = std::uint32_t;
+        using value_type = std::pair<double, std::uint32_t>;
+        using size_type = std::size_t;
+
+      private:
+        enum slot_state : std::uint8_t
+        {
+            EMPTY = 0,
+            FULL = 1,
+            DELETED = 2
+        };
+
+        static constexpr std::size_t min_capacity = 16;
+
+        std::vector<value_type> slots_;
+        std::vector<std::uint8_t> states_;
+        std::size_t size_, ndeleted_;
+        // Only used for discrete genomes
+        std::vector<std::uint64_t> occupied_;
+        std::uint64_t discrete_length_, noccupied_;
+
+        static std::uint64_t
+        hash_position(double x)
+        {
+            // -0.0 and 0.0 compare equal, so they must hash equal.
+            if (x == 0.0)
+                {
+                    x = 0.0;
+                }
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(double));
+            // splitmix64 finalizer
+            bits ^= bits >> 30;
+            bits *= 0xbf58476d1ce4e5b9ULL;
+            bits ^= bits >> 27;
+            bits *= 0x94d049bb133111ebULL;
+            bits ^= bits >> 31;
+            return bits;
+        }
+
+        std::size_t
+        mask() const
+        {
+            return slots_.size() - 1;
+        }
+
+        std::size_t
+        home_slot(const double pos) const
+        {
+            return static_cast<std::size_t>(hash_position(pos)) & mask();
+        }
+
+        bool
+        needs_rehash(std::size_t additional) const
+        // Keep occupancy (including tombstones) at or below 1/2
+        {
+            return 2 * (size_ + ndeleted_ + additional) > slots_.size();
+        }
+
+        bool
+        valid_site(const double pos) const
+        {
+            return pos >= 0.0 && pos < static_cast<double>(discrete_length_)
+                   && std::floor(pos) == pos;
+        }
+
+        bool
+        site_is_occupied(const double pos) const
+        {
+            auto site = static_cast<std::uint64_t>(pos);
+            return (occupied_[site >> 6] >> (site & 63)) & 1ULL;
+        }
+
+        void
+        set_site(const double pos)
+        {
+            auto site = static_cast<std::uint64_t>(pos);
+            auto bit = 1ULL << (site & 63);
+            if (!(occupied_[site >> 6] & bit))
+                {
+                    occupied_[site >> 6] |= bit;
+                    ++noccupied_;
+                }
+        }
+
+        void
+        clear_site_if_unused(const double pos)
+        {
+            if (discrete_length_ && first_match(pos) == slots_.size())
+                {
+                    auto site = static_cast<std::uint64_t>(pos);
+                    auto bit = 1ULL << (site & 63);
+                    if (occupied_[site >> 6] & bit)
+                        {
+                            occupied_[site >> 6] &= ~bit;
+                            --noccupied_;
+                        }
+                }
+        }
+
+        void
+        rebuild_occupancy()
+        {
+            if (!discrete_length_)
+                {
+                    return;
+                }
+            std::fill(occupied_.begin(), occupied_.end(), 0);
+            noccupied_ = 0;
+            for (std::size_t i = 0; i < slots_.size(); ++i)
+                {
+                    if (states_[i] == FULL)
+                        {
+                            set_site(slots_[i].first);
+                        }
+                }
+        }
+
+        void
+        validate_position(const double pos) const
+        {
+            if (discrete_length_ && !valid_site(pos))
+                {
+                    throw std::invalid_argument(
+                        "MutationPositionLookup: position is not a valid site for "
+                        "a discrete genome");
+                }
+        }
+
+        std::size_t
+        first_match(const double pos) const
+        {
+            if (size_ == 0)
+                {
+                    return slots_.size();
+                }
+            if (discrete_length_ && (!valid_site(pos) || !site_is_occupied(pos)))
+                {
+                    return slots_.size();
+                }
+            for (auto i = home_slot(pos); states_[i] != EMPTY; i = (i + 1) & mask())
+                {
+                    if (states_[i] == FULL && slots_[i].first == pos)
+                        {
+                            return i;
+                        }
+                }
+            return slots_.size();
+        }
+
+        std::size_t
+        next_match(std::size_t i) const
+        // Continue along the probe sequence of slots_[i].first.
+        // Because occupancy never exceeds 1/2, the sequence
+        // always terminates at an empty slot.
+        {
+            const auto pos = slots_[i].first;
+            for (i = (i + 1) & mask(); states_[i] != EMPTY; i = (i + 1) & mask())
+                {
+                    if (states_[i] == FULL && slots_[i].first == pos)
+                        {
+                            return i;
+                        }
+                }
+            return slots_.size();
+        }
+
+        std::size_t
+        next_full(std::size_t i) const
+        {
+            for (; i < slots_.size(); ++i)
+                {
+                    if (states_[i] == FULL)
+                        {
+                            return i;
+                        }
+                }
+            return slots_.size();
+        }
+
+        std::size_t
+        insert_no_rehash(const double pos, const std::uint32_t key)
+        {
+            auto i = home_slot(pos);
+            while (states_[i] == FULL)
+                {
+                    i = (i + 1) & mask();
+                }
+            if (states_[i] == DELETED)
+                {
+                    --ndeleted_;
+                }
+            slots_[i] = value_type{pos, key};
+            states_[i] = FULL;
+            ++size_;
+            if (discrete_length_)
+                {
+                    set_site(pos);
+                }
+            return i;
+        }
+
+        void
+        rehash(std::size_t new_capacity)
+        {
+            std::vector<value_type> old_slots(new_capacity);
+            std::vector<std::uint8_t> old_states(new_capacity, EMPTY);
+            old_slots.swap(slots_);
+            old_states.swap(states_);
+            size_ = ndeleted_ = 0;
+            for (std::size_t i = 0; i < old_slots.size(); ++i)
+                {
+                    if (old_states[i] == FULL)
+                        {
+                            insert_no_rehash(old_slots[i].first, old_slots[i].second);
+                        }
+                }
+        }
+
+        static std::size_t
+        capacity_for(std::size_t n)
+        {
+            std::size_t c = min_capacity;
+            while (c < 2 * n)
+                {
+                    c <<= 1;
+                }
+            return c;
+        }
+
+        void
+        make_room(std::size_t additional)
+        {
+            if (!needs_rehash(additional))
+                {
+                    return;
+                }
+            // If removing tombstones is enough, keep the current capacity.
+            rehash(std::max(capacity_for(size_ + additional), slots_.size()));
+        }
+
+        void
+        mark_deleted(std::size_t i)
+        {
+            states_[i] = DELETED;
+            --size_;
+            ++ndeleted_;
+        }
+
+        template <typename Table, typename Value> class iterator_base
+        // Forward iterator.  If probing is true, the iterator
+        // only visits entries whose position equals the position
+        // of the entry that it was constructed from.  This is how
+        // equal_range is implemented.
+        {
+          private:
+            Table *table;
+            std::size_t index;
+            bool probing;
+            friend class MutationPositionLookup;
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = MutationPositionLookup::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value *;
+            using reference = Value &;
+
+            iterator_base() : table{nullptr}, index{0}, probing{false}
+            {
+            }
+
+            iterator_base(Table *t, std::size_t i, bool p)
+                : table{t}, index{i}, probing{p}
+            {
+            }
+
+            reference operator*() const
+            {
+                return table->slots_[index];
+            }
+
+            pointer operator->() const
+            {
+                return &table->slots_[index];
+            }
+
+            iterator_base &
+            operator++()
+            {
+                index = probing ? table->next_match(index)
+                                : table->next_full(index + 1);
+                return *this;
+            }
+
+            iterator_base
+            operator++(int)
+            {
+                auto rv = *this;
+                ++(*this);
+                return rv;
+            }
+
+            bool
+            operator==(const iterator_base &rhs) const
+            {
+                return index == rhs.index;
+            }
+
+            bool
+            operator!=(const iterator_base &rhs) const
+            {
+                return !(*this == rhs);
+            }
+        };
+
+      public:
+        // Entries are not editable through iterators: keys
+        // determine storage location and values are updated
+        // in bulk via remap.
+        using iterator = iterator_base<const MutationPositionLookup, const value_type>;
+        using const_iterator = iterator;
+
+        MutationPositionLookup()
+            : slots_{}, states_{}, size_{0}, ndeleted_{0}, occupied_{},
+              discrete_length_{0}, noccupied_{0}
+        {
+        }
+
+        void
+        set_discrete_genome_length(const std::uint64_t length)
+        // Treat positions as integers in [0, length).
+        // Passing 0 returns to continuous positions.
+        {
+            if (length == 0)
+                {
+                    std::vector<std::uint64_t>().swap(occupied_);
+                    discrete_length_ = noccupied_ = 0;
+                    return;
+                }
+            for (auto &e : *this)
+                {
+                    if (!(e.first >= 0.0 && e.first < static_cast<double>(length)
+                          && std::floor(e.first) == e.first))
+                        {
+                            throw std::invalid_argument(
+                                "MutationPositionLookup: existing position is not a "
+                                "valid site for a discrete genome");
+                        }
+                }
+            occupied_.assign(length / 64 + (length % 64 != 0), 0);
+            discrete_length_ = length;
+            rebuild_occupancy();
+        }
+
+        std::uint64_t
+        discrete_genome_length() const
+        {
+            return discrete_length_;
+        }
+
+        bool
+        discrete() const
+        {
+            return discrete_length_ > 0;
+        }
+
+        bool
+        all_sites_occupied() const
+        {
+            return discrete_length_ > 0 && noccupied_ == discrete_length_;
+        }
+
+        double
+        canonical_position(const double pos) const
+        // Map a continuous position onto the site containing it.
+        // For a uniform deviate on [beg, end) with integer beg and
+        // end, the result is uniform on {beg, ..., end - 1}.
+        {
+            return discrete_length_ ? std::floor(pos) : pos;
+        }
+
+        std::size_t
+        size() const
+        {
+            return size_;
+        }
+
+        bool
+        empty() const
+        {
+            return size_ == 0;
+        }
+
+        std::size_t
+        capacity() const
+        {
+            return slots_.size();
+        }
+
+        std::size_t
+        bytes() const
+        // Memory used by the entries and the site bitmap
+        {
+            return size_ * (sizeof(value_type) + sizeof(std::uint8_t))
+                   + occupied_.size() * sizeof(std::uint64_t);
+        }
+
+        std::size_t
+        capacity_bytes() const
+        // Memory allocated by the table
+        {
+            return slots_.capacity() * sizeof(value_type)
+                   + states_.capacity() * sizeof(std::uint8_t)
+                   + occupied_.capacity() * sizeof(std::uint64_t);
+        }
+
+        void
+        clear()
+        {
+            std::fill(states_.begin(), states_.end(), EMPTY);
+            std::fill(occupied_.begin(), occupied_.end(), 0);
+            size_ = ndeleted_ = noccupied_ = 0;
+        }
+
+        void
+        reserve(std::size_t n)
+        {
+            if (n > size_)
+                {
+                    make_room(n - size_);
+                }
+        }
+
+        void
+        shrink_to_fit()
+        // Release memory after many erasures.
+        {
+            auto c = capacity_for(size_);
+            if (size_ == 0)
+                {
+                    std::vector<value_type>().swap(slots_);
+                    std::vector<std::uint8_t>().swap(states_);
+                    ndeleted_ = 0;
+                    return;
+                }
+            if (c < slots_.size() || ndeleted_)
+                {
+                    rehash(c);
+                }
+        }
+
+        const_iterator
+        begin() const
+        {
+            return const_iterator(this, next_full(0), false);
+        }
+
+        const_iterator
+        end() const
+        {
+            return const_iterator(this, slots_.size(), false);
+        }
+
+        const_iterator
+        find(const double pos) const
+        {
+            return const_iterator(this, first_match(pos), true);
+        }
+
+        std::pair<const_iterator, const_iterator>
+        equal_range(const double pos) const
+        {
+            return std::make_pair(find(pos), end());
+        }
+
+        std::size_t
+        count(const double pos) const
+        {
+            auto r = equal_range(pos);
+            return static_cast<std::size_t>(std::distance(r.first, r.second));
+        }
+
+        iterator
+        emplace(const double pos, const std::uint32_t key)
+        {
+            validate_position(pos);
+            make_room(1);
+            return iterator(this, insert_no_rehash(pos, key), false);
+        }
+
+        iterator
+        insert(const value_type &value)
+        {
+            return emplace(value.first, value.second);
+        }
+
+        template <typename Iterator>
+        void
+        insert(Iterator first, Iterator last)
+        // Batched insertion.  The table is resized at most once.
+        {
+            make_room(static_cast<std::size_t>(std::distance(first, last)));
+            for (; first != last; ++first)
+                {
+                    validate_position(first->first);
+                    insert_no_rehash(first->first, first->second);
+                }
+        }
+
+        iterator
+        erase(const_iterator itr)
+        {
+            if (itr.index >= slots_.size() || states_[itr.index] != FULL)
+                {
+                    throw std::out_of_range("MutationPositionLookup: invalid iterator");
+                }
+            auto next = itr;
+            ++next;
+            mark_deleted(itr.index);
+            clear_site_if_unused(slots_[itr.index].first);
+            return next;
+        }
+
+        bool
+        erase(const double pos, const std::uint32_t key)
+        // Erase a single (position, key) pair.
+        {
+            auto r = equal_range(pos);
+            for (; r.first != r.second; ++r.first)
+                {
+                    if (r.first->second == key)
+                        {
+                            mark_deleted(r.first.index);
+                            clear_site_if_unused(pos);
+                            return true;
+                        }
+                }
+            return false;
+        }
+
+        template <typename Predicate>
+        std::size_t
+        erase_if(const Predicate &predicate)
+        // Batched erasure of all entries for which
+        // predicate(value_type) is true.
+        {
+            std::size_t nerased = 0;
+            for (std::size_t i = 0; i < slots_.size(); ++i)
+                {
+                    if (states_[i] == FULL && predicate(slots_[i]))
+                        {
+                            mark_deleted(i);
+                            ++nerased;
+                        }
+                }
+            if (ndeleted_ > size_)
+                {
+                    rehash(slots_.size());
+                }
+            if (nerased)
+                {
+                    rebuild_occupancy();
+                }
+            return nerased;
+        }
+
+        void
+        remap(const std::vector<std::uint32_t> &new_keys)
+        // Replace each key k with new_keys[k].  Entries
+        // whose new key is std::numeric_limits<std::uint32_t>::max()
+        // are erased.  Positions are unchanged, so no rehashing
+        // is needed.
+        {
+            for (std::size_t i = 0; i < slots_.size(); ++i)
+                {
+                    if (states_[i] == FULL)
+                        {
+                            if (slots_[i].second >= new_keys.size())
+                                {
+                                    throw std::out_of_range(
+                                        "MutationPositionLookup::remap: key out of range");
+                                }
+                            auto k = new_keys[slots_[i].second];
+                            if (k == std::numeric_limits<std::uint32_t>::max())
+                                {
+                                    mark_deleted(i);
+                                }
+                            else
+                                {
+                                    slots_[i].second = k;
+                                }
+                        }
+                }
+            if (ndeleted_ > size_)
+                {
+                    rehash(capacity_for(size_));
+                }
+            rebuild_occupancy();
+        }
+
+        std::size_t
+        memory_usage() const
+        // Bytes allocated for storage
+        {
+            return slots_.capacity() * sizeof(value_type)
+                   + states_.capacity() * sizeof(std::uint8_t)
+                   + occupied_.capacity() * sizeof(std::uint64_t);
+        }
+
+        bool
+        operator==(const MutationPositionLookup &rhs) const
+        // Equality is order-independent
+        {
+            if (size_ != rhs.size_)
+                {
+                    return false;
+                }
+            std::vector<value_type> a(begin(), end()), b(rhs.begin(), rhs.end());
+            std::sort(a.begin(), a.end());
+            std::sort(b.begin(), b.end());
+            return a == b;
+        }
+
+        bool
+        operator!=(const MutationPositionLookup &rhs) const
+        {
+            return !(*this == rhs);
+        }
+    };
+} // namespace fwdpy11
+
+#endif
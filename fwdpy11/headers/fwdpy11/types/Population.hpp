@@ -2,10 +2,12 @@
 #define FWDPY11_POPULATION_HPP__
 
 #include <tuple>
+#include <memory>
+#include <vector>
+#include <numeric>
 #include <algorithm>
 #include <stdexcept>
 #include <gsl/gsl_randist.h>
-#include <unordered_map>
 #include <fwdpp/forward_types.hpp>
 #include <fwdpp/fwd_functional.hpp>
 #include <fwdpp/poptypes/popbase.hpp>
@@ -13,6 +15,7 @@
 #include <fwdpp/ts/std_table_collection.hpp>
 #include "../rng.hpp"
 #include "Mutation.hpp"
+#include "MutationPositionLookup.hpp"
 
 namespace fwdpy11
 {
@@ -20,7 +23,7 @@ namespace fwdpy11
         : public fwdpp::poptypes::popbase<
               Mutation, std::vector<Mutation>, std::vector<fwdpp::haploid_genome>,
               std::vector<Mutation>, std::vector<fwdpp::uint_t>,
-              std::unordered_multimap<double, fwdpp::uint_t>>
+              MutationPositionLookup>
     // Base class for population types
     {
       private:
@@ -45,12 +48,34 @@ namespace fwdpy11
             return *tables == *rhs.tables;
         }
 
+        // Maps the positions of fixations to their origin times.
+        // Used to avoid recording the same fixation twice.
+        // It is not serialized and is rebuilt when out of sync
+        // with fixations.
+        MutationPositionLookup fixation_lookup;
+
+        // Copies of a population share its tables until
+        // one of them calls detach_tables.  The number of
+        // populations sharing the tables is the use count.
+        std::shared_ptr<const bool> table_sharers;
+
+        void
+        rebuild_fixation_lookup()
+        {
+            fixation_lookup.clear();
+            fixation_lookup.reserve(this->fixations.size());
+            for (const auto &f : this->fixations)
+                {
+                    fixation_lookup.emplace(f.pos, static_cast<std::uint32_t>(f.g));
+                }
+        }
+
       public:
         using mutation_type = Mutation;
         using mutation_vector = std::vector<mutation_type>;
         using genome_type = fwdpp::haploid_genome;
         using genome_vector = std::vector<genome_type>;
-        using mutation_position_hash = std::unordered_multimap<double, fwdpp::uint_t>;
+        using mutation_position_hash = MutationPositionLookup;
         using fwdpp_base
             = fwdpp::poptypes::popbase<mutation_type, mutation_vector, genome_vector,
                                        mutation_vector, std::vector<fwdpp::uint_t>,
@@ -69,7 +94,8 @@ namespace fwdpy11
         std::vector<double> genetic_value_matrix, ancient_sample_genetic_value_matrix;
 
         Population(fwdpp::uint_t N_, const double L)
-            : fwdpp_base{N_}, N{N_}, generation{0},
+            : fwdpp_base{N_}, fixation_lookup{},
+              table_sharers(std::make_shared<const bool>(true)), N{N_}, generation{0},
               tables(init_tables(N_, L)), alive_nodes{}, preserved_sample_nodes{},
               genetic_value_matrix{}, ancient_sample_genetic_value_matrix{}
         {
@@ -81,6 +107,28 @@ namespace fwdpy11
         Population &operator=(const Population &) = default;
         Population &operator=(Population &&) = default;
 
+        bool
+        tables_are_shared() const
+        // True if the tables are shared with copies of this population.
+        {
+            return table_sharers.use_count() > 1;
+        }
+
+        void
+        detach_tables()
+        // Copying a population does not copy its tables, which hold
+        // its history and are usually its largest component.
+        // Functions that modify the tables must call this first,
+        // so that a population copies its tables the first time it
+        // modifies them.
+        {
+            if (tables_are_shared())
+                {
+                    tables = std::make_shared<fwdpp::ts::std_table_collection>(*tables);
+                    table_sharers = std::make_shared<const bool>(true);
+                }
+        }
+
         std::int64_t
         find_mutation_by_key(const std::tuple<double, double, fwdpp::uint_t> &key,
                              const std::int64_t offset) const
@@ -111,12 +159,75 @@ namespace fwdpy11
                 std::distance(this->fixations.begin(), itr));
         }
 
+        bool
+        record_fixation(const std::size_t key)
+        // Append mutations[key] to fixations, with the current
+        // generation as the fixation time, unless a mutation with
+        // the same position and origin time is already recorded.
+        // Returns true if the mutation was appended.
+        //
+        // Fixations are stored in the order they are recorded.
+        // See sort_fixations.
+        {
+            if (fixation_lookup.size() != this->fixations.size())
+                {
+                    rebuild_fixation_lookup();
+                }
+            const auto &m = this->mutations[key];
+            auto g = static_cast<std::uint32_t>(m.g);
+            auto r = fixation_lookup.equal_range(m.pos);
+            for (auto i = r.first; i != r.second; ++i)
+                {
+                    if (i->second == g)
+                        {
+                            return false;
+                        }
+                }
+            this->fixations.push_back(m);
+            this->fixation_times.push_back(generation);
+            fixation_lookup.emplace(m.pos, g);
+            return true;
+        }
+
+        void
+        sort_fixations()
+        // Sort fixations and fixation_times by origin time and
+        // then position, which is the order exposed to Python.
+        // Cheap when the fixations are already sorted.
+        {
+            auto less = [](const mutation_type &a, const mutation_type &b) {
+                return std::tie(a.g, a.pos) < std::tie(b.g, b.pos);
+            };
+            if (std::is_sorted(this->fixations.begin(), this->fixations.end(), less))
+                {
+                    return;
+                }
+            std::vector<std::size_t> order(this->fixations.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(),
+                      [this, &less](std::size_t i, std::size_t j) {
+                          return less(this->fixations[i], this->fixations[j]);
+                      });
+            mutation_vector sorted_fixations;
+            decltype(this->fixation_times) sorted_times;
+            sorted_fixations.reserve(order.size());
+            sorted_times.reserve(order.size());
+            for (auto i : order)
+                {
+                    sorted_fixations.push_back(std::move(this->fixations[i]));
+                    sorted_times.push_back(this->fixation_times[i]);
+                }
+            this->fixations.swap(sorted_fixations);
+            this->fixation_times.swap(sorted_times);
+        }
+
         void
         rebuild_mutation_lookup(bool from_tables)
         {
             this->mut_lookup.clear();
             if (from_tables)
                 {
+                    this->mut_lookup.reserve(this->tables->mutations.size());
                     for (const auto &mr : this->tables->mutations)
                         {
                             if (mr.key >= this->mutations.size())
@@ -0,0 +1,248 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_TYPES_MEMORY_USAGE_HPP
+#define FWDPY11_TYPES_MEMORY_USAGE_HPP
+
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/std_table_collection.hpp>
+#include <fwdpp/ts/recording/edge_buffer.hpp>
+#include <fwdpp/ts/simplify_tables_output.hpp>
+#include "DiploidPopulation.hpp"
+
+namespace fwdpy11
+{
+    struct memory_usage_record
+    /// Memory used by one component of a population,
+    /// and the memory allocated for it, in bytes.
+    {
+        std::string component;
+        std::size_t bytes;
+        std::size_t capacity;
+    };
+
+    class __attribute__((visibility("default"))) MemoryLimitExceeded
+        : public std::exception
+    {
+      private:
+        std::string message_;
+
+      public:
+        explicit MemoryLimitExceeded(std::string message) : message_(std::move(message))
+        {
+        }
+        virtual const char*
+        what() const noexcept
+        {
+            return message_.c_str();
+        }
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        inline memory_usage_record
+        vector_memory_usage(std::string component, const std::vector<T>& v)
+        {
+            return memory_usage_record{std::move(component), v.size() * sizeof(T),
+                                       v.capacity() * sizeof(T)};
+        }
+
+        inline void
+        add_memory_usage(memory_usage_record& a, const memory_usage_record& b)
+        {
+            a.bytes += b.bytes;
+            a.capacity += b.capacity;
+        }
+
+        inline memory_usage_record
+        mutations_memory_usage(std::string component,
+                               const std::vector<Mutation>& mutations)
+        // Includes the effect size and dominance vectors
+        {
+            auto rv = vector_memory_usage(std::move(component), mutations);
+            for (const auto& m : mutations)
+                {
+                    add_memory_usage(rv, vector_memory_usage("", m.esizes));
+                    add_memory_usage(rv, vector_memory_usage("", m.heffects));
+                }
+            return rv;
+        }
+    } // namespace detail
+
+    inline std::vector<memory_usage_record>
+    memory_usage(const fwdpp::ts::std_table_collection& tables)
+    /// Memory used by each table and by the edge table indexes.
+    {
+        std::vector<memory_usage_record> rv;
+        rv.push_back(detail::vector_memory_usage("nodes", tables.nodes));
+        rv.push_back(detail::vector_memory_usage("edges", tables.edges));
+        rv.push_back(detail::vector_memory_usage("sites", tables.sites));
+        rv.push_back(detail::vector_memory_usage("mutations", tables.mutations));
+        rv.push_back(detail::vector_memory_usage("indexes", tables.input_left));
+        detail::add_memory_usage(rv.back(),
+                                 detail::vector_memory_usage("", tables.output_right));
+        return rv;
+    }
+
+    inline std::vector<memory_usage_record>
+    memory_usage(const DiploidPopulation& pop)
+    /// Memory used by each component of a population.
+    /// The cost is linear in the number of haploid genomes
+    /// and of mutations, which is small compared to that
+    /// of simulating a generation.
+    {
+        std::vector<memory_usage_record> rv;
+        if (pop.tables != nullptr)
+            {
+                rv = memory_usage(*pop.tables);
+                for (auto& r : rv)
+                    {
+                        r.component = "tables." + r.component;
+                    }
+            }
+        rv.push_back(detail::vector_memory_usage("haploid_genomes", pop.haploid_genomes));
+        memory_usage_record keys{"haploid_genomes.keys", 0, 0};
+        for (const auto& g : pop.haploid_genomes)
+            {
+                detail::add_memory_usage(keys,
+                                         detail::vector_memory_usage("", g.mutations));
+                detail::add_memory_usage(keys,
+                                         detail::vector_memory_usage("", g.smutations));
+            }
+        rv.push_back(std::move(keys));
+        rv.push_back(detail::mutations_memory_usage("mutations", pop.mutations));
+        rv.push_back(detail::vector_memory_usage("mcounts", pop.mcounts));
+        detail::add_memory_usage(
+            rv.back(), detail::vector_memory_usage("", pop.mcounts_from_preserved_nodes));
+        rv.push_back(memory_usage_record{"mut_lookup", pop.mut_lookup.bytes(),
+                                         pop.mut_lookup.capacity_bytes()});
+        rv.push_back(detail::mutations_memory_usage("fixations", pop.fixations));
+        detail::add_memory_usage(rv.back(),
+                                 detail::vector_memory_usage("", pop.fixation_times));
+        rv.push_back(memory_usage_record{"fixation_lookup", pop.fixation_lookup.bytes(),
+                                         pop.fixation_lookup.capacity_bytes()});
+        rv.push_back(detail::vector_memory_usage("diploids", pop.diploids));
+        rv.push_back(detail::vector_memory_usage("diploid_metadata", pop.diploid_metadata));
+        rv.push_back(detail::vector_memory_usage("ancient_sample_metadata",
+                                                 pop.ancient_sample_metadata));
+        rv.push_back(detail::vector_memory_usage("genetic_value_matrix",
+                                                 pop.genetic_value_matrix));
+        rv.push_back(detail::vector_memory_usage("ancient_sample_genetic_value_matrix",
+                                                 pop.ancient_sample_genetic_value_matrix));
+        return rv;
+    }
+
+    inline std::size_t
+    total_capacity(const std::vector<memory_usage_record>& records)
+    {
+        std::size_t rv = 0;
+        for (const auto& r : records)
+            {
+                rv += r.capacity;
+            }
+        return rv;
+    }
+
+    inline std::size_t
+    constant_time_capacity(const DiploidPopulation& pop)
+    /// The part of total_capacity(memory_usage(pop)) that can be
+    /// found without visiting each haploid genome and mutation.
+    /// It omits the mutation keys of genomes and the effect size
+    /// and dominance vectors of mutations and fixations.
+    {
+        std::size_t rv = 0;
+        if (pop.tables != nullptr)
+            {
+                rv = total_capacity(memory_usage(*pop.tables));
+            }
+        auto add = [&rv](const auto& v) {
+            rv += v.capacity() * sizeof(typename std::decay_t<decltype(v)>::value_type);
+        };
+        add(pop.haploid_genomes);
+        add(pop.mutations);
+        add(pop.mcounts);
+        add(pop.mcounts_from_preserved_nodes);
+        add(pop.fixations);
+        add(pop.fixation_times);
+        add(pop.diploids);
+        add(pop.diploid_metadata);
+        add(pop.ancient_sample_metadata);
+        add(pop.genetic_value_matrix);
+        add(pop.ancient_sample_genetic_value_matrix);
+        rv += pop.mut_lookup.capacity_bytes();
+        rv += pop.fixation_lookup.capacity_bytes();
+        return rv;
+    }
+
+    inline std::size_t
+    edge_buffer_capacity(const fwdpp::ts::edge_buffer& buffer)
+    /// Memory allocated for the edges recorded between simplifications
+    {
+        return buffer.head.capacity() * sizeof(decltype(buffer.head)::value_type)
+               + buffer.births.capacity() * sizeof(decltype(buffer.births)::value_type);
+    }
+
+    template <typename SimplificationState>
+    inline std::size_t
+    simplifier_capacity(const SimplificationState& state,
+                        const fwdpp::ts::simplify_tables_output& output)
+    /// Part of the memory kept by the simplification algorithm
+    /// between calls: the output tables that it builds before
+    /// swapping them into the input, its mutation map, and the
+    /// node id map.  The ancestry list and the segment overlapper
+    /// are not counted, although they are among the largest
+    /// buffers, so this is a lower bound.
+    {
+        auto bytes = [](const auto& v) {
+            return v.capacity()
+                   * sizeof(typename std::decay_t<decltype(v)>::value_type);
+        };
+        return bytes(state.new_edge_table) + bytes(state.temp_edge_buffer)
+               + bytes(state.new_node_table) + bytes(state.new_site_table)
+               + bytes(state.mutation_map) + bytes(output.idmap)
+               + bytes(output.preserved_mutations);
+    }
+
+    inline void
+    release_unused_memory(DiploidPopulation& pop)
+    /// Return the unused capacity of the tables
+    /// and of the mutation containers.
+    {
+        if (pop.tables != nullptr)
+            {
+                pop.tables->nodes.shrink_to_fit();
+                pop.tables->edges.shrink_to_fit();
+                pop.tables->sites.shrink_to_fit();
+                pop.tables->mutations.shrink_to_fit();
+                pop.tables->input_left.shrink_to_fit();
+                pop.tables->output_right.shrink_to_fit();
+            }
+        pop.mutations.shrink_to_fit();
+        pop.mcounts.shrink_to_fit();
+        pop.mcounts_from_preserved_nodes.shrink_to_fit();
+        pop.haploid_genomes.shrink_to_fit();
+    }
+} // namespace fwdpy11
+
+#endif
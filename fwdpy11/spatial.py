@@ -0,0 +1,114 @@
+#
+# Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+#
+# This file is part of fwdpy11.
+#
+# fwdpy11 is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# fwdpy11 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+import attr
+
+import fwdpy11._fwdpy11
+
+from .class_decorators import (attr_add_asblack, attr_class_pickle_with_super,
+                               attr_class_to_from_dict)
+
+
+@attr_add_asblack
+@attr_class_pickle_with_super
+@attr_class_to_from_dict
+@attr.s(auto_attribs=True, frozen=True, repr_ns="fwdpy11")
+class SpatialMating(fwdpy11._fwdpy11._ll_SpatialMating):
+    """
+    Mate choice, dispersal, and density regulation in continuous space.
+
+    Individuals live in the rectangle ``[0, width] x [0, height]``.
+    Their positions are the first two elements of
+    :attr:`fwdpy11.DiploidMetadata.geography`, which must be set
+    before the simulation starts.
+
+    The first parent of an offspring is chosen as in non-spatial models.
+    The second parent is chosen from the same deme with probability
+    proportional to its fitness times a Gaussian kernel with standard
+    deviation ``mating_sigma``.  Individuals more than ``3*mating_sigma``
+    away are never chosen.  If there are no such individuals, the second
+    parent is chosen without regard to space.
+
+    Offspring are placed at the position of their first parent plus
+    Gaussian noise with standard deviation ``dispersal_sigma`` along each
+    axis, reflected at the edges of the habitat.
+
+    If ``local_capacity`` is greater than zero, the fitness of an individual
+    with ``n`` neighbors within ``3*mating_sigma`` is multiplied by
+    ``1/(1 + n/local_capacity)`` when parents are chosen.
+    :attr:`fwdpy11.DiploidMetadata.w` is not changed.  The factors for
+    the current generation are in :attr:`density`, in the same order
+    as :attr:`fwdpy11.DiploidPopulation.diploid_metadata`.
+
+    Other forms of density regulation may be defined by subclassing
+    and overriding ``density_regulation(self, individual, num_neighbors)``,
+    which receives a :class:`fwdpy11.DiploidMetadata` and the number of
+    neighbors, and returns a non-negative factor.  The override is called
+    once per individual per generation, so a Python implementation is
+    much slower than the default, which is implemented in C++.
+
+    :param width: Width of the habitat
+    :type width: float
+    :param height: Height of the habitat
+    :type height: float
+    :param mating_sigma: Standard deviation of the mating kernel
+    :type mating_sigma: float
+    :param dispersal_sigma: Standard deviation of offspring dispersal
+    :type dispersal_sigma: float
+    :param local_capacity: Local carrying capacity. Zero means no
+                           density regulation.
+    :type local_capacity: float
+    :param max_candidates: Maximum number of individuals examined when
+                           counting neighbors or choosing a mate.
+    :type max_candidates: int
+
+    Positions must lie within the habitat.  It is an error to start a
+    simulation with every individual at the origin, which is where
+    :class:`fwdpy11.DiploidPopulation` places them by default.
+
+    Neighbors are found on a grid whose cells are at least
+    ``3*mating_sigma`` wide.  If the cells around an individual contain
+    more than ``max_candidates`` individuals, a random sample of
+    ``max_candidates`` of them is used instead.  Neighbor counts are
+    scaled up from the sample, and mates are chosen from among the
+    sampled individuals.  This bounds the cost of each generation
+    when individuals are clustered in space.
+
+    Instances are passed to :func:`fwdpy11.evolvets` via the
+    ``spatial_mating`` keyword argument.
+
+    .. versionadded:: 0.16.0
+    """
+
+    width: float
+    height: float
+    mating_sigma: float
+    dispersal_sigma: float
+    local_capacity: float = 0.0
+    max_candidates: int = 1000
+
+    def __attrs_post_init__(self):
+        super(SpatialMating, self).__init__(
+            width=self.width,
+            height=self.height,
+            mating_sigma=self.mating_sigma,
+            dispersal_sigma=self.dispersal_sigma,
+            local_capacity=self.local_capacity,
+            max_candidates=self.max_candidates,
+        )
@@ -22,6 +22,7 @@ void init_ts(py::module &);
 void init_evolution_functions(py::module &);
 void init_discrete_demography(py::module &m);
 void init_array_proxies(py::module &m);
+void initialize_spatial(py::module &m);
 
 PYBIND11_MODULE(_fwdpy11, m)
 {
@@ -37,6 +38,7 @@ PYBIND11_MODULE(_fwdpy11, m)
     init_evolution_functions(m);
     init_discrete_demography(m);
     init_array_proxies(m);
+    initialize_spatial(m);
 
     py::register_exception<fwdpy11::GSLError>(m, "GSLError");
 
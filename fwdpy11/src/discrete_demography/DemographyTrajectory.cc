@@ -0,0 +1,173 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include <limits>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/numpy/array.hpp>
+#include <fwdpy11/discrete_demography/simulation/demography_trajectory.hpp>
+
+namespace py = pybind11;
+namespace ddemog = fwdpy11::discrete_demography;
+
+namespace
+{
+    template <typename T>
+    py::array_t<T>
+    per_deme_array(const ddemog::DemographyTrajectory& self, const std::vector<T>& v)
+    {
+        return fwdpy11::make_2d_ndarray_readonly(v, self.times.size(),
+                                                 static_cast<std::size_t>(self.maxdemes));
+    }
+} // namespace
+
+void
+init_DemographyTrajectory(py::module& m)
+{
+    py::class_<ddemog::DemographyTrajectory>(m, "DemographyTrajectory",
+                                             R"delim(
+The state of a demographic model at each time point
+when demographic events happen.
+
+Per-deme values are 2d arrays with one row per time
+point and one column per deme.
+
+Instances are returned by :func:`fwdpy11.demography_trajectory`.
+
+.. versionadded:: 0.16.0
+)delim")
+        .def_readonly("maxdemes", &ddemog::DemographyTrajectory::maxdemes,
+                      "The number of demes in the model.")
+        .def_property_readonly(
+            "times",
+            [](const ddemog::DemographyTrajectory& self) {
+                return fwdpy11::make_1d_ndarray_readonly(self.times);
+            },
+            "The time points when events happen.")
+        .def_property_readonly(
+            "parental_deme_sizes",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.parental_deme_sizes);
+            },
+            "The number of parents in each deme, after mass migrations.")
+        .def_property_readonly(
+            "offspring_deme_sizes",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.offspring_deme_sizes);
+            },
+            "The deme sizes in the next generation.")
+        .def_property_readonly(
+            "growth_rates",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.growth_rates);
+            })
+        .def_property_readonly(
+            "growth_onset_times",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.growth_onset_times);
+            })
+        .def_property_readonly(
+            "growth_initial_sizes",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.growth_initial_sizes);
+            })
+        .def_property_readonly(
+            "selfing_rates",
+            [](const ddemog::DemographyTrajectory& self) {
+                return per_deme_array(self, self.selfing_rates);
+            })
+        .def_property_readonly(
+            "migration_times",
+            [](const ddemog::DemographyTrajectory& self) {
+                return fwdpy11::make_1d_ndarray_readonly(self.migration_times);
+            },
+            "The time points when the migration matrix is first set or changes.")
+        .def_property_readonly(
+            "migration_matrices",
+            [](const ddemog::DemographyTrajectory& self) -> py::object {
+                if (self.migration_times.empty())
+                    {
+                        return py::none();
+                    }
+                auto n = static_cast<std::size_t>(self.maxdemes);
+                return fwdpy11::make_2d_ndarray_readonly(self.migration_matrices,
+                                                         self.migration_times.size(),
+                                                         n * n)
+                    .attr("reshape")(self.migration_times.size(), n, n);
+            },
+            R"delim(
+The migration matrix at each element of migration_times,
+or None if there is no migration.
+)delim")
+        .def_property_readonly(
+            "global_extinction_time",
+            [](const ddemog::DemographyTrajectory& self) -> py::object {
+                if (self.global_extinction_time
+                    == std::numeric_limits<std::uint32_t>::max())
+                    {
+                        return py::none();
+                    }
+                return py::int_(self.global_extinction_time);
+            },
+            R"delim(
+The last generation with individuals, or None if
+the model does not go extinct.
+
+If this value is ``t``, then ``deme_sizes(t)`` has a
+positive total and ``deme_sizes(t + 1)`` is all zeros.
+In other words, ``t`` is the generation whose offspring
+are all extinct, which is one generation before the
+first generation when every deme has size zero.
+)delim")
+        .def(
+            "deme_sizes",
+            [](const ddemog::DemographyTrajectory& self, std::uint32_t generation) {
+                auto sizes = self.deme_sizes(generation);
+                return fwdpy11::make_1d_array_with_capsule(std::move(sizes));
+            },
+            py::arg("generation"),
+            R"delim(
+The number of parents in each deme at a generation.
+
+:param generation: The generation, which need not be an element of `times`.
+:type generation: int
+:rtype: numpy.ndarray
+)delim");
+
+    m.def(
+        "_evaluate_demography",
+        [](const std::vector<std::uint32_t>& initial_deme_sizes,
+           const ddemog::DiscreteDemography& demography, std::uint32_t start,
+           py::object simlen) {
+            auto last = std::numeric_limits<std::uint32_t>::max();
+            if (simlen.is_none() == false)
+                {
+                    auto s = simlen.cast<std::uint32_t>();
+                    if (s >= last - start)
+                        {
+                            throw std::invalid_argument("simlen is too large");
+                        }
+                    last = start + s;
+                }
+            return ddemog::evaluate_demography(initial_deme_sizes, demography, start,
+                                               last);
+        },
+        py::arg("initial_deme_sizes"), py::arg("demography"), py::arg("start"),
+        py::arg("simlen"));
+}
@@ -85,8 +85,10 @@ namespace
             }
         else
             {
+                // Changed in 0.16.0 to store the CSR representation
                 rv["migmatrix"] = py::make_tuple(
-                    model_state->M->M, model_state->M->npops, model_state->M->scaled);
+                    model_state->M->row_offsets, model_state->M->columns,
+                    model_state->M->values, model_state->M->scaled);
             }
         return rv;
     }
@@ -205,11 +207,22 @@ init_DiscreteDemography(py::module& m)
                     if (d["migmatrix"].is_none() == false)
                         {
                             auto t = d["migmatrix"].cast<py::tuple>();
-                            auto rates = t[0].cast<std::vector<double>>();
-                            auto npops = t[1].cast<std::size_t>();
-                            auto scaled = t[2].cast<bool>();
-                            M.reset(new ddemog::MigrationMatrix(std::move(rates), npops,
-                                                                scaled));
+                            if (t.size() == 3) // dense, from fwdpy11 < 0.16.0
+                                {
+                                    auto rates = t[0].cast<std::vector<double>>();
+                                    auto npops = t[1].cast<std::size_t>();
+                                    auto scaled = t[2].cast<bool>();
+                                    M.reset(new ddemog::MigrationMatrix(std::move(rates),
+                                                                        npops, scaled));
+                                }
+                            else
+                                {
+                                    M.reset(new ddemog::MigrationMatrix(
+                                        t[0].cast<std::vector<std::size_t>>(),
+                                        t[1].cast<std::vector<std::size_t>>(),
+                                        t[2].cast<std::vector<double>>(),
+                                        t[3].cast<bool>()));
+                                }
                         }
                     state.reset(new ddemog::demographic_model_state(
                         maxdemes, std::move(sizes_rates), std::move(M)));
@@ -38,6 +38,14 @@ init_MigrationMatrix(py::module &m)
                  std::vector<double> M(d, d + r.shape(0) * r.shape(1));
                  return ddemog::MigrationMatrix(std::move(M), r.shape(0), scaled);
              }),
-             py::arg("migmatrix"), py::arg("scaled") = false);
+             py::arg("migmatrix"), py::arg("scaled") = false)
+        .def(py::init([](std::vector<std::size_t> indptr,
+                         std::vector<std::size_t> indices, std::vector<double> data,
+                         const bool scaled) {
+                 return ddemog::MigrationMatrix(indptr, indices, data, scaled);
+             }),
+             py::arg("indptr"), py::arg("indices"), py::arg("data"),
+             py::arg("scaled") = false)
+        .def_property_readonly("_nnz", &ddemog::MigrationMatrix::nnz);
 }
 
@@ -54,5 +54,11 @@ init_SetMigrationRate(py::module& m)
                  return fwdpy11::discrete_demography::SetMigrationRates(when,
                                                                         std::move(m));
              }),
-             py::arg("when"), py::arg("migmatrix"));
+             py::arg("when"), py::arg("migmatrix"))
+        .def(py::init<std::uint32_t, std::vector<std::size_t>, std::vector<std::size_t>,
+                      std::vector<double>>(),
+             py::arg("when"), py::arg("indptr"), py::arg("indices"), py::arg("data"))
+        .def(py::init<std::uint32_t, std::int32_t, std::vector<std::size_t>,
+                      std::vector<double>>(),
+             py::arg("when"), py::arg("deme"), py::arg("indices"), py::arg("data"));
 }
@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+#include "remove_extinct_mutations.hpp"
+#include "remove_extinct_genomes.hpp"
+#include "compact_population.hpp"
+
+namespace
+{
+    std::vector<std::uint8_t>
+    mutations_in_use(const fwdpy11::DiploidPopulation &pop)
+    // A mutation is in use if it has a nonzero count,
+    // is in the mutation table, or is in an extant genome.
+    // The last two cases cover neutral mutations, which
+    // are not counted when there are ancient samples.
+    {
+        std::vector<std::uint8_t> rv(pop.mutations.size(), 0);
+        for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+            {
+                rv[i] = (pop.mcounts[i] + pop.mcounts_from_preserved_nodes[i]) != 0;
+            }
+        for (auto &m : pop.tables->mutations)
+            {
+                rv[m.key] = 1;
+            }
+        for (auto &g : pop.haploid_genomes)
+            {
+                if (g.n)
+                    {
+                        for (auto k : g.mutations)
+                            {
+                                rv[k] = 1;
+                            }
+                        for (auto k : g.smutations)
+                            {
+                                rv[k] = 1;
+                            }
+                    }
+            }
+        return rv;
+    }
+
+    bool
+    below_threshold(std::size_t live, std::size_t total, double threshold)
+    {
+        return total > 0
+               && static_cast<double>(live) < threshold * static_cast<double>(total);
+    }
+} // namespace
+
+void
+compact_population(const double compaction_threshold,
+                   std::vector<std::size_t> &preserved_mutations,
+                   std::vector<std::uint32_t> &last_preserved_generation_counts,
+                   fwdpy11::DiploidPopulation &pop)
+// Called after simplification, when the mutation counts are current.
+// Mutations that are no longer in use are only recycled by
+// the simulation, so the containers never shrink below their
+// historical peak.  When the fraction of mutations or genomes that
+// are in use falls below compaction_threshold, the unused ones are
+// removed and all keys and genome indexes are remapped.
+{
+    std::size_t live_genomes = 0;
+    for (auto &g : pop.haploid_genomes)
+        {
+            live_genomes += (g.n > 0);
+        }
+    if (below_threshold(live_genomes, pop.haploid_genomes.size(), compaction_threshold))
+        {
+            remove_extinct_genomes(pop);
+            pop.haploid_genomes.shrink_to_fit();
+        }
+
+    auto keep = mutations_in_use(pop);
+    std::size_t live_mutations = 0;
+    for (auto k : keep)
+        {
+            live_mutations += k;
+        }
+    if (!below_threshold(live_mutations, pop.mutations.size(), compaction_threshold))
+        {
+            return;
+        }
+    auto new_keys = remove_mutations(pop, keep);
+    for (auto &k : preserved_mutations)
+        {
+            if (new_keys[k] == std::numeric_limits<fwdpp::uint_t>::max())
+                {
+                    throw std::runtime_error(
+                        "bad mutation key remapping of preserved mutations");
+                }
+            k = new_keys[k];
+        }
+    if (!last_preserved_generation_counts.empty())
+        {
+            std::vector<std::uint32_t> counts(pop.mutations.size(), 0);
+            for (std::size_t i = 0; i < last_preserved_generation_counts.size(); ++i)
+                {
+                    if (new_keys[i] != std::numeric_limits<fwdpp::uint_t>::max())
+                        {
+                            counts[new_keys[i]] = last_preserved_generation_counts[i];
+                        }
+                }
+            last_preserved_generation_counts.swap(counts);
+        }
+}
@@ -0,0 +1,18 @@
+#ifndef FWDPY11_EVOLVE_COMPACT_POPULATION_HPP
+#define FWDPY11_EVOLVE_COMPACT_POPULATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fwdpy11
+{
+    class DiploidPopulation;
+}
+
+void compact_population(const double compaction_threshold,
+                        std::vector<std::size_t> &preserved_mutations,
+                        std::vector<std::uint32_t> &last_preserved_generation_counts,
+                        fwdpy11::DiploidPopulation &pop);
+
+#endif
@@ -37,3 +37,45 @@ calculate_diploid_fitness(
             throw std::runtime_error("non-finite fitnesses encountered");
         }
 }
+
+void
+assign_constant_fitness(const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
+                        std::vector<fwdpy11::DiploidGeneticValue *> &gvalue_pointers,
+                        const std::vector<std::size_t> &deme_to_gvalue_map,
+                        std::vector<fwdpy11::DiploidMetadata> &offspring_metadata,
+                        std::vector<double> &new_diploid_gvalues,
+                        const bool update_genotype_matrix,
+                        constant_fitness_values &values)
+{
+    new_diploid_gvalues.clear();
+    for (std::size_t i = 0; i < offspring_metadata.size(); ++i)
+        {
+            auto deme = offspring_metadata[i].deme;
+            if (!values.filled[deme])
+                {
+                    auto idx = deme_to_gvalue_map[deme];
+                    gvalue_pointers[idx]->operator()(fwdpy11::DiploidGeneticValueData(
+                        rng, pop, pop.diploid_metadata[offspring_metadata[i].parents[0]],
+                        pop.diploid_metadata[offspring_metadata[i].parents[1]], i,
+                        offspring_metadata[i]));
+                    if (!std::isfinite(offspring_metadata[i].w))
+                        {
+                            throw std::runtime_error("non-finite fitnesses encountered");
+                        }
+                    values.g[deme] = offspring_metadata[i].g;
+                    values.e[deme] = offspring_metadata[i].e;
+                    values.w[deme] = offspring_metadata[i].w;
+                    values.gvalues[deme] = gvalue_pointers[idx]->gvalues;
+                    values.filled[deme] = 1;
+                }
+            offspring_metadata[i].g = values.g[deme];
+            offspring_metadata[i].e = values.e[deme];
+            offspring_metadata[i].w = values.w[deme];
+            if (update_genotype_matrix == true)
+                {
+                    new_diploid_gvalues.insert(end(new_diploid_gvalues),
+                                               begin(values.gvalues[deme]),
+                                               end(values.gvalues[deme]));
+                }
+        }
+}
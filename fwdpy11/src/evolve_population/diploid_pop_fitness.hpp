@@ -1,6 +1,8 @@
 #ifndef FWDPY11_TSEVOLVE_SLOCUS_FITNESS_HPP
 #define FWDPY11_TSEVOLVE_SLOCUS_FITNESS_HPP
 
+#include <cstdint>
+#include <vector>
 #include <fwdpp/gsl_discrete.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include <fwdpy11/genetic_values/DiploidGeneticValue.hpp>
@@ -15,4 +17,29 @@ calculate_diploid_fitness(const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulati
                           std::vector<double> &new_diploid_gvalues,
                           const bool update_genotype_matrix);
 
+struct constant_fitness_values
+// Used when the genetic value objects are declared to give
+// every individual in a deme the same genetic value, noise,
+// and fitness.  The values for a deme are calculated for
+// the first individual seen in that deme and copied to the rest.
+{
+    std::vector<std::uint8_t> filled;
+    std::vector<double> g, e, w;
+    std::vector<std::vector<double>> gvalues;
+
+    explicit constant_fitness_values(std::size_t maxdemes)
+        : filled(maxdemes, 0), g(maxdemes), e(maxdemes), w(maxdemes),
+          gvalues(maxdemes)
+    {
+    }
+};
+
+void assign_constant_fitness(
+    const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
+    std::vector<fwdpy11::DiploidGeneticValue *> &gvalue_pointers,
+    const std::vector<std::size_t> &deme_to_gvalue_map,
+    std::vector<fwdpy11::DiploidMetadata> &offspring_metadata,
+    std::vector<double> &new_diploid_gvalues, const bool update_genotype_matrix,
+    constant_fitness_values &values);
+
 #endif
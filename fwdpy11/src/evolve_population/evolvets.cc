@@ -1,3 +1,5 @@
+#include <sstream>
+#include <type_traits>
 #include <fwdpp/simparams.hpp>
 #include <fwdpp/ts/simplify_tables.hpp>
 #include <fwdpp/ts/simplify_tables_output.hpp>
@@ -7,7 +9,11 @@
 #include <fwdpp/ts/recycling.hpp>
 #include <fwdpy11/gsl/gsl_error_handler_wrapper.hpp>
 #include <fwdpy11/evolvets/evolve_generation_ts.hpp>
+#include <fwdpy11/evolvets/meiosis_buffers.hpp>
+#include <fwdpy11/evolvets/incremental_mutation_counts.hpp>
 #include <fwdpy11/evolvets/simplify_tables.hpp>
+#include <fwdpy11/evolvets/discrete_genome.hpp>
+#include <fwdpy11/types/memory_usage.hpp>
 #include "util.hpp"
 #include "diploid_pop_fitness.hpp"
 #include "index_and_count_mutations.hpp"
@@ -16,6 +22,7 @@
 #include "remove_extinct_mutations.hpp"
 #include "track_ancestral_counts.hpp"
 #include "remove_extinct_genomes.hpp"
+#include "compact_population.hpp"
 #include "runtime_checks.hpp"
 
 #include "evolvets.hpp"
@@ -134,6 +141,9 @@ final_population_cleanup(
             remove_extinct_mutations(pop);
         }
     remove_extinct_genomes(pop);
+    // So that serialized populations and comparisons
+    // do not depend on when fixations were accessed.
+    pop.sort_fixations();
     if (pop.mutations.size() != pop.mcounts.size()
         || pop.mutations.size() != pop.mcounts_from_preserved_nodes.size())
         {
@@ -162,7 +172,10 @@ evolve_with_tree_sequences(
     const bool remove_extinct_mutations_at_finish,
     const bool reset_treeseqs_to_alive_nodes_after_simplification,
     const bool preserve_first_generation,
-    const fwdpy11::DiploidPopulation_temporal_sampler &post_simplification_recorder)
+    const fwdpy11::DiploidPopulation_temporal_sampler &post_simplification_recorder,
+    const bool discrete_genome, const bool constant_fitness,
+    fwdpy11::SpatialMating *spatial, const std::size_t memory_limit,
+    const double compaction_threshold)
 {
     fwdpy11::gsl_scoped_convert_error_to_exception gsl_error_scope_guard;
 
@@ -205,6 +218,42 @@ evolve_with_tree_sequences(
         {
             throw std::invalid_argument("node table is not initialized");
         }
+    std::uint64_t discrete_genome_length = 0;
+    if (discrete_genome)
+        {
+            auto L = pop.tables->genome_length();
+            if (std::floor(L) != L)
+                {
+                    throw std::invalid_argument(
+                        "genome length must be an integer for a discrete genome");
+                }
+            discrete_genome_length = static_cast<std::uint64_t>(L);
+        }
+    // The mode is set from the model for this call only.
+    // Throws if existing mutations are not at integer positions.
+    fwdpy11::scoped_discrete_genome discrete_genome_scope(pop.mut_lookup,
+                                                          discrete_genome_length);
+    if (constant_fitness)
+        {
+            if (mu_selected > 0.0)
+                {
+                    throw std::invalid_argument(
+                        "constant fitness requires a selected mutation rate of zero");
+                }
+            for (auto &g : pop.haploid_genomes)
+                {
+                    if (g.n > 0 && !g.smutations.empty())
+                        {
+                            throw std::invalid_argument(
+                                "constant fitness is incompatible with existing "
+                                "selected mutations");
+                        }
+                }
+        }
+    if (spatial != nullptr)
+        {
+            spatial->validate_positions(pop.diploid_metadata);
+        }
     const bool simulating_neutral_variants = (mu_neutral > 0.0) ? true : false;
     if (simulating_neutral_variants)
         {
@@ -237,27 +286,40 @@ evolve_with_tree_sequences(
             throw std::invalid_argument("too few genetic value objects");
         }
 
+    // A population cloned from another one gets its own
+    // copy of the tables before they are modified.
+    pop.detach_tables();
+
     double total_mutation_rate = mu_neutral + mu_selected;
-    const auto bound_mmodel = [&rng, &mmodel, &pop, total_mutation_rate](
+    // Storage for breakpoints and new mutation keys is
+    // recycled by evolve_generation_ts after each offspring
+    // is recorded.
+    fwdpy11::MeiosisBuffers meiosis_buffers;
+    static_assert(std::is_same<fwdpp::uint_t, std::uint32_t>::value,
+                  "MeiosisBuffers assumes 32-bit mutation keys");
+    const auto bound_mmodel = [&rng, &mmodel, &pop, &meiosis_buffers,
+                               total_mutation_rate](
                                   fwdpp::flagged_mutation_queue &recycling_bin,
                                   std::vector<fwdpy11::Mutation> &mutations) {
-        std::vector<fwdpp::uint_t> rv;
-        unsigned nmuts = gsl_ran_poisson(rng.get(), total_mutation_rate);
-        for (unsigned i = 0; i < nmuts; ++i)
-            {
-                std::size_t x = gsl_ran_discrete(rng.get(), mmodel.lookup.get());
-                auto key = mmodel.regions[x]->operator()(
-                    recycling_bin, mutations, pop.mut_lookup, pop.generation, rng);
-                rv.push_back(key);
-            }
-        std::sort(begin(rv), end(rv),
-                  [&mutations](const fwdpp::uint_t a, const fwdpp::uint_t b) {
-                      return mutations[a].pos < mutations[b].pos;
-                  });
+        auto rv = meiosis_buffers.mutation_keys.acquire();
+        auto capacity = rv.capacity();
+        mmodel.generate_mutations(rng, total_mutation_rate, recycling_bin, mutations,
+                                  pop.mut_lookup, pop.generation, rv);
+        meiosis_buffers.mutation_keys.record_growth(capacity, rv);
         return rv;
     };
 
-    const auto bound_rmodel = [&rng, &rmodel]() { return rmodel(rng); };
+    const auto bound_rmodel = [&rng, &rmodel, &meiosis_buffers, discrete_genome]() {
+        auto breakpoints = meiosis_buffers.breakpoints.acquire();
+        auto capacity = breakpoints.capacity();
+        rmodel.generate_breakpoints(rng, breakpoints);
+        meiosis_buffers.breakpoints.record_growth(capacity, breakpoints);
+        if (discrete_genome)
+            {
+                fwdpy11::discretize_breakpoints(breakpoints);
+            }
+        return breakpoints;
+    };
 
     auto genetics = fwdpp::make_genetic_parameters(gvalue_pointers.genetic_values,
                                                    std::move(bound_mmodel),
@@ -279,13 +341,21 @@ evolve_with_tree_sequences(
     std::vector<fwdpy11::DiploidMetadata> offspring_metadata(pop.diploid_metadata);
     std::vector<fwdpy11::DiploidGenotype> offspring;
     std::vector<double> new_diploid_gvalues;
+    constant_fitness_values constant_values(current_demographic_state->maxdemes);
     calculate_diploid_fitness(rng, pop, genetics.gvalue, deme_to_gvalue_map,
                               offspring_metadata, new_diploid_gvalues,
                               record_genotype_matrix);
     pop.genetic_value_matrix.swap(new_diploid_gvalues);
     pop.diploid_metadata.swap(offspring_metadata);
-    ddemog::update_demography_manager(rng, pop.generation, pop.diploid_metadata,
-                                      demography, *current_demographic_state);
+    ddemog::mass_migrations_and_current_sizes(rng, pop.generation, pop.diploid_metadata,
+                                              demography, *current_demographic_state);
+    if (spatial != nullptr)
+        {
+            spatial->update(rng, pop.diploid_metadata);
+        }
+    ddemog::finalize_demographic_state(
+        pop.generation, pop.diploid_metadata, demography, *current_demographic_state,
+        (spatial == nullptr) ? nullptr : &spatial->density());
     if (current_demographic_state->will_go_globally_extinct() == true)
         {
             std::ostringstream o;
@@ -375,12 +445,40 @@ evolve_with_tree_sequences(
 
     clear_edge_table_indexes(*pop.tables);
     fwdpp::ts::simplify_tables_output simplification_output;
+    // The memory limit is checked each generation without visiting
+    // every genome and mutation.  The parts of the total that need
+    // such a pass, and the buffers of the simplifier, are measured
+    // after each simplification.  The rest is added each generation.
+    std::size_t memory_measured_at_simplification = 0;
+    auto measure_memory = [&]() {
+        if (memory_limit > 0)
+            {
+                memory_measured_at_simplification
+                    = fwdpy11::total_capacity(fwdpy11::memory_usage(pop))
+                      - fwdpy11::constant_time_capacity(pop)
+                      + fwdpy11::simplifier_capacity(*simplifier_state,
+                                                     simplification_output);
+            }
+    };
+    auto current_memory = [&]() {
+        return memory_measured_at_simplification + fwdpy11::constant_time_capacity(pop)
+               + fwdpy11::edge_buffer_capacity(*new_edge_buffer);
+    };
+    measure_memory();
+    // Used by track_mutation_counts in generations
+    // where simplification does not count mutations.
+    fwdpy11::IncrementalMutationCounts incremental_counts;
     for (std::uint32_t gen = 0; gen < simlen && !stopping_criteron_met; ++gen)
         {
             ++pop.generation;
+            if (track_mutation_counts_during_sim)
+                {
+                    incremental_counts.record_parental_genomes(pop.haploid_genomes);
+                }
             fwdpy11::evolve_generation_ts(rng, pop, genetics, *current_demographic_state,
                                           pop.generation, *new_edge_buffer, offspring,
-                                          offspring_metadata, next_index);
+                                          offspring_metadata, meiosis_buffers,
+                                          spatial, next_index);
             // TODO: abstract out these steps into a "cleanup_pop" function
             // NOTE: by swapping the diploids here, it is not possible
             // for genetics.value to make use of parental genotype information.
@@ -400,24 +498,43 @@ evolve_with_tree_sequences(
             // metadata on, and that we then have the
             // metadata in the expected places for
             // calculate_diploid_fitness
-            pop.diploid_metadata.swap(offspring_metadata);
-            // TODO: deal with random effects
-            for (auto &i : genetics.gvalue)
+            if (constant_fitness)
+                // The genetic value objects are neither updated
+                // nor called for each offspring.  Parents are
+                // then sampled uniformly within demes.
                 {
-                    i->update(pop);
-                    i->gv2w->update(pop);
-                    i->noise_fxn->update(pop);
+                    assign_constant_fitness(rng, pop, genetics.gvalue,
+                                            deme_to_gvalue_map, offspring_metadata,
+                                            new_diploid_gvalues, record_genotype_matrix,
+                                            constant_values);
+                }
+            else
+                {
+                    pop.diploid_metadata.swap(offspring_metadata);
+                    // TODO: deal with random effects
+                    for (auto &i : genetics.gvalue)
+                        {
+                            i->update(pop);
+                            i->gv2w->update(pop);
+                            i->noise_fxn->update(pop);
+                        }
+                    pop.diploid_metadata.swap(offspring_metadata);
+                    calculate_diploid_fitness(rng, pop, genetics.gvalue,
+                                              deme_to_gvalue_map, offspring_metadata,
+                                              new_diploid_gvalues, record_genotype_matrix);
                 }
-            pop.diploid_metadata.swap(offspring_metadata);
-            calculate_diploid_fitness(rng, pop, genetics.gvalue, deme_to_gvalue_map,
-                                      offspring_metadata, new_diploid_gvalues,
-                                      record_genotype_matrix);
             pop.genetic_value_matrix.swap(new_diploid_gvalues);
             // TODO: abstract out these steps into a "cleanup_pop" function
             pop.diploid_metadata.swap(offspring_metadata);
+            if (spatial != nullptr)
+                {
+                    spatial->update(rng, pop.diploid_metadata);
+                }
 
-            ddemog::finalize_demographic_state(pop.generation, pop.diploid_metadata,
-                                               demography, *current_demographic_state);
+            ddemog::finalize_demographic_state(
+                pop.generation, pop.diploid_metadata, demography,
+                *current_demographic_state,
+                (spatial == nullptr) ? nullptr : &spatial->density());
 
             pop.N = static_cast<std::uint32_t>(pop.diploids.size());
             if (current_demographic_state->will_go_globally_extinct() == true)
@@ -442,7 +559,10 @@ evolve_with_tree_sequences(
                     throw ddemog::GlobalExtinction(o.str());
                 }
 
-            if (gen % simplification_interval == 0.0)
+            // Exceeding the memory limit forces simplification
+            const bool over_memory_limit
+                = memory_limit > 0 && current_memory() > memory_limit;
+            if (gen % simplification_interval == 0.0 || over_memory_limit)
                 {
                     simplification(
                         preserve_selected_fixations, simulating_neutral_variants,
@@ -452,6 +572,25 @@ evolve_with_tree_sequences(
                         simplification_output,
                         *new_edge_buffer, alive_at_last_simplification, pop);
                     simplified = true;
+                    if (over_memory_limit)
+                        {
+                            fwdpy11::release_unused_memory(pop);
+                            new_edge_buffer->births.shrink_to_fit();
+                        }
+                    measure_memory();
+                    if (over_memory_limit)
+                        {
+                            auto bytes = current_memory();
+                            if (bytes > memory_limit)
+                                {
+                                    std::ostringstream o;
+                                    o << "memory use of " << bytes
+                                      << " bytes exceeds the limit of " << memory_limit
+                                      << " bytes after simplification at time "
+                                      << pop.generation;
+                                    throw fwdpy11::MemoryLimitExceeded(o.str());
+                                }
+                        }
                 }
             else
                 {
@@ -466,7 +605,8 @@ evolve_with_tree_sequences(
             next_index = pop.tables->num_nodes();
             if (track_mutation_counts_during_sim)
                 {
-                    track_mutation_counts(pop, simplified, suppress_edge_table_indexing);
+                    track_mutation_counts(pop, simplified, suppress_edge_table_indexing,
+                                          incremental_counts);
                 }
             // The user may now analyze the pop'n and record ancient samples
             recorder(pop, sr);
@@ -508,6 +648,13 @@ evolve_with_tree_sequences(
                                             end(simplification_output.preserved_mutations),
                                             std::numeric_limits<std::size_t>::max()),
                                 end(simplification_output.preserved_mutations));
+                            if (compaction_threshold > 0.0)
+                                {
+                                    compact_population(
+                                        compaction_threshold,
+                                        simplification_output.preserved_mutations,
+                                        last_preserved_generation_counts, pop);
+                                }
                             if (simulating_neutral_variants)
                                 {
                                     genetics.mutation_recycling_bin
@@ -559,6 +706,11 @@ evolve_with_tree_sequences(
                     // Finally, clear the input
                     sr.samples.clear();
                 }
+            if (simplified)
+                {
+                    // Fixations may have been removed from genomes
+                    incremental_counts.invalidate();
+                }
             stopping_criteron_met = stopping_criteron(pop, simplified);
         }
 
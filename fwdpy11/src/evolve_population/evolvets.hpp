@@ -10,6 +10,7 @@
 #include <fwdpy11/discrete_demography/DiscreteDemography.hpp>
 #include <fwdpy11/gsl/gsl_error_handler_wrapper.hpp>
 #include <fwdpy11/samplers.hpp>
+#include <fwdpy11/spatial/SpatialMating.hpp>
 
 void evolve_with_tree_sequences(
     const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulation &pop,
@@ -30,5 +31,8 @@ void evolve_with_tree_sequences(
     const bool remove_extinct_mutations_at_finish,
     const bool reset_treeseqs_to_alive_nodes_after_simplification,
     const bool preserve_first_generation,
-    const fwdpy11::DiploidPopulation_temporal_sampler &post_simplification_recorder);
+    const fwdpy11::DiploidPopulation_temporal_sampler &post_simplification_recorder,
+    const bool discrete_genome, const bool constant_fitness,
+    fwdpy11::SpatialMating *spatial, const std::size_t memory_limit,
+    const double compaction_threshold);
 
@@ -1,7 +1,7 @@
 #include <algorithm>
 #include <fwdpy11/types/DiploidPopulation.hpp>
 #include <fwdpp/ts/table_collection_functions.hpp>
-#include <fwdpp/ts/count_mutations.hpp>
+#include <fwdpy11/evolvets/count_mutations.hpp>
 #include <fwdpp/internal/sample_diploid_helpers.hpp>
 
 void
@@ -21,9 +21,10 @@ index_and_count_mutations(bool suppress_edge_table_indexing,
             pop.tables->build_indexes();
             pop.fill_alive_nodes();
             pop.fill_preserved_nodes();
-            fwdpp::ts::count_mutations(*pop.tables, pop.mutations, pop.alive_nodes,
-                                       pop.preserved_sample_nodes, pop.mcounts,
-                                       pop.mcounts_from_preserved_nodes);
+            // Single-threaded, as in simplify_tables
+            fwdpy11::count_mutations(*pop.tables, pop.mutations, pop.alive_nodes,
+                                     pop.preserved_sample_nodes, pop.mcounts,
+                                     pop.mcounts_from_preserved_nodes, 1);
         }
     else
         {
@@ -1,7 +1,6 @@
 #include <cstdint>
 #include <vector>
 #include <algorithm>
-#include <functional>
 #include <limits>
 #include <stdexcept>
 #include <fwdpy11/types/Population.hpp>
@@ -38,24 +37,23 @@ namespace
     }
 } // namespace
 
-void
-remove_extinct_mutations(fwdpy11::Population& pop)
+std::vector<fwdpp::uint_t>
+remove_mutations(fwdpy11::Population& pop, const std::vector<std::uint8_t>& keep)
 {
-    check_mutation_table_consistency_with_count_vectors(pop, __FILE__, __LINE__);
-    std::vector<fwdpp::uint_t> summed_counts(pop.mcounts);
-    std::transform(begin(pop.mcounts_from_preserved_nodes),
-                   end(pop.mcounts_from_preserved_nodes), begin(summed_counts),
-                   begin(summed_counts), std::plus<fwdpp::uint_t>());
+    if (keep.size() != pop.mutations.size())
+        {
+            throw std::invalid_argument(
+                "keep flags must have one entry per mutation");
+        }
     std::vector<fwdpp::uint_t> new_mutation_indexes(
         pop.mutations.size(), std::numeric_limits<fwdpp::uint_t>::max());
     decltype(pop.mcounts) new_mcounts;
     decltype(pop.mcounts) new_preserved_mcounts;
 
-    //Remove extinct mutations
     fwdpp::uint_t next_mutation_index = 0;
     for (fwdpp::uint_t i = 0; i < pop.mutations.size(); ++i)
         {
-            if (summed_counts[i] != 0)
+            if (keep[i])
                 {
                     new_mutation_indexes[i] = next_mutation_index++;
                     new_mcounts.push_back(pop.mcounts[i]);
@@ -96,13 +94,43 @@ remove_extinct_mutations(fwdpy11::Population& pop)
                     reindex_container(new_mutation_indexes, g.mutations);
                     reindex_container(new_mutation_indexes, g.smutations);
                 }
+            else
+                {
+                    // Extinct genomes may hold removed keys.
+                    // Their contents are replaced when they
+                    // are recycled, so they are emptied here.
+                    g.mutations.clear();
+                    g.smutations.clear();
+                }
         }
 
-    // Easiest way to update the lookup table:
-    pop.mut_lookup.clear();
-    for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+    // Mutation positions do not change, so the lookup
+    // table only needs its keys updated.
+    pop.mut_lookup.remap(new_mutation_indexes);
+    if (pop.mut_lookup.size() != pop.mutations.size())
         {
-            pop.mut_lookup.insert(std::make_pair(pop.mutations[i].pos, i));
+            // Some extant mutations were not in the lookup
+            // table, so we fall back to a full rebuild.
+            pop.mut_lookup.clear();
+            pop.mut_lookup.reserve(pop.mutations.size());
+            for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+                {
+                    pop.mut_lookup.emplace(pop.mutations[i].pos,
+                                           static_cast<fwdpp::uint_t>(i));
+                }
         }
+    pop.mut_lookup.shrink_to_fit();
+    return new_mutation_indexes;
 }
 
+void
+remove_extinct_mutations(fwdpy11::Population& pop)
+{
+    check_mutation_table_consistency_with_count_vectors(pop, __FILE__, __LINE__);
+    std::vector<std::uint8_t> keep(pop.mutations.size(), 0);
+    for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+        {
+            keep[i] = (pop.mcounts[i] + pop.mcounts_from_preserved_nodes[i]) != 0;
+        }
+    remove_mutations(pop, keep);
+}
@@ -1,8 +1,18 @@
 #ifndef FWDPY11_TSEVOLUTION_REMOVE_EXTINCT_MUTATIONS_HPP
 #define FWDPY11_TSEVOLUTION_REMOVE_EXTINCT_MUTATIONS_HPP
 
+#include <cstdint>
+#include <vector>
 #include <fwdpy11/types/Population.hpp>
 
+std::vector<fwdpp::uint_t>
+remove_mutations(fwdpy11::Population& pop, const std::vector<std::uint8_t>& keep);
+// Removes the mutations whose entry in keep is zero and
+// remaps the keys stored in the tables, the extant genomes,
+// and the mutation lookup table.  Returns the map from old
+// to new keys.  Removed keys map to
+// std::numeric_limits<fwdpp::uint_t>::max().
+
 void
 remove_extinct_mutations(fwdpy11::Population& pop);
 
@@ -2,9 +2,11 @@
 #define FWDPY11_TSEVOLUTION_TRACK_MUTATION_COUNTS_HPP
 
 #include <fwdpy11/types/Population.hpp>
+#include <fwdpy11/evolvets/incremental_mutation_counts.hpp>
 
 void track_mutation_counts(fwdpy11::Population &pop,
                            const bool simplified,
-                           const bool suppress_edge_table_indexing);
+                           const bool suppress_edge_table_indexing,
+                           fwdpy11::IncrementalMutationCounts &incremental_counts);
 
 #endif
@@ -1,5 +1,6 @@
 #include <fwdpp/ts/std_table_collection.hpp>
 #include <fwdpy11/util/convert_lists.hpp>
+#include <fwdpy11/types/memory_usage.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -61,6 +62,20 @@ init_ts_TableCollection(py::module& m)
                  swap_with_empty(self.output_right);
              })
         .def("_build_indexes", &fwdpp::ts::std_table_collection::build_indexes)
+        .def("_is_same_object",
+             [](const fwdpp::ts::std_table_collection& self,
+                const fwdpp::ts::std_table_collection& other) {
+                 return &self == &other;
+             })
+        .def("_memory_usage",
+             [](const fwdpp::ts::std_table_collection& self) {
+                 py::dict rv;
+                 for (const auto& r : fwdpy11::memory_usage(self))
+                     {
+                         rv[py::str(r.component)] = py::make_tuple(r.bytes, r.capacity);
+                     }
+                 return rv;
+             })
         .def_property_readonly("_genome_length",
                                &fwdpp::ts::std_table_collection::genome_length)
         .def("__eq__",
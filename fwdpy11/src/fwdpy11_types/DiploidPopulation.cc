@@ -26,6 +26,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/types/memory_usage.hpp>
 #include <fwdpy11/serialization.hpp>
 #include <fwdpy11/serialization/Mutation.hpp>
 #include <fwdpy11/serialization/Diploid.hpp>
@@ -39,7 +40,16 @@ PYBIND11_MAKE_OPAQUE(std::vector<fwdpy11::DiploidMetadata>);
 PYBIND11_MAKE_OPAQUE(fwdpy11::DiploidPopulation::genome_container);
 PYBIND11_MAKE_OPAQUE(fwdpy11::DiploidPopulation::mutation_container);
 
-fwdpy11::DiploidPopulation create_DiploidPopulation_from_tree_sequence(py::object ts);
+fwdpy11::DiploidPopulation
+create_DiploidPopulation_from_tree_sequence(const py::dict& columns,
+                                            const py::object& mutation_metadata,
+                                            const py::object& individual_metadata,
+                                            bool import_mutations);
+
+fwdpy11::DiploidPopulation
+create_DiploidPopulation_from_arrays(double length, const py::dict& mutations,
+                                     const py::dict& genomes, const py::handle& diploids,
+                                     const py::object& metadata);
 
 namespace
 {
@@ -55,6 +65,8 @@ namespace
 void
 init_DiploidPopulation(py::module& m)
 {
+    py::register_exception<fwdpy11::MemoryLimitExceeded>(m, "MemoryLimitExceeded");
+
     py::class_<fwdpy11::DiploidPopulation, fwdpy11::Population>(m,
                                                                 "ll_DiploidPopulation")
         .def(py::init<fwdpp::uint_t, double>(), py::arg("N"), py::arg("length"))
@@ -63,6 +75,10 @@ init_DiploidPopulation(py::module& m)
         .def(py::init([](fwdpy11::DiploidPopulation& input) {
             return fwdpy11::DiploidPopulation(std::move(input));
         }))
+        .def("_clone",
+             [](const fwdpy11::DiploidPopulation& self) {
+                 return fwdpy11::DiploidPopulation(self);
+             })
         .def("clear", &fwdpy11::DiploidPopulation::clear, "Clears all population data.")
         .def("__eq__", [](const fwdpy11::DiploidPopulation& lhs,
                           const fwdpy11::DiploidPopulation& rhs) { return lhs == rhs; })
@@ -71,6 +87,15 @@ init_DiploidPopulation(py::module& m)
                        &fwdpy11::DiploidPopulation::diploid_metadata)
         .def_readwrite("_ancient_sample_metadata",
                        &fwdpy11::DiploidPopulation::ancient_sample_metadata)
+        .def("_memory_usage",
+             [](const fwdpy11::DiploidPopulation& self) {
+                 py::dict rv;
+                 for (const auto& r : fwdpy11::memory_usage(self))
+                     {
+                         rv[py::str(r.component)] = py::make_tuple(r.bytes, r.capacity);
+                     }
+                 return rv;
+             })
         .def("_clear_haploid_genomes",
              [](fwdpy11::DiploidPopulation& self) {
                  swap_with_empty(self.haploid_genomes);
@@ -88,7 +113,9 @@ init_DiploidPopulation(py::module& m)
                  swap_with_empty(self.ancient_sample_metadata);
              })
         .def(py::pickle(
-            [](const fwdpy11::DiploidPopulation& pop) -> py::object {
+            [](fwdpy11::DiploidPopulation& pop) -> py::object {
+                // Fixations are written in the order exposed to Python
+                pop.sort_fixations();
                 std::ostringstream o;
                 fwdpy11::serialization::serialize_details(o, &pop);
                 auto pb = py::bytes(o.str());
@@ -102,7 +129,8 @@ init_DiploidPopulation(py::module& m)
                 return pop;
             }))
         .def("_dump_to_file",
-             [](const fwdpy11::DiploidPopulation& pop, const std::string filename) {
+             [](fwdpy11::DiploidPopulation& pop, const std::string filename) {
+                 pop.sort_fixations();
                  std::ofstream out(filename.c_str(), std::ios_base::binary);
                  if (!out)
                      {
@@ -125,7 +153,8 @@ init_DiploidPopulation(py::module& m)
                 return pop;
             })
         .def("_pickle_to_file",
-             [](const fwdpy11::DiploidPopulation& self, py::object f) {
+             [](fwdpy11::DiploidPopulation& self, py::object f) {
+                 self.sort_fixations();
                  auto dump = py::module::import("pickle").attr("dump");
                  dump(py::make_tuple(self.diploids.size(), self.haploid_genomes.size(),
                                      self.mutations.size(), self.fixations.size(),
@@ -279,7 +308,10 @@ init_DiploidPopulation(py::module& m)
                     = load(f).cast<decltype(rv.ancient_sample_genetic_value_matrix)>();
                 return rv;
             })
-        .def_static("_create_from_tskit", [](py::object ts) {
-            return create_DiploidPopulation_from_tree_sequence(ts);
-        });
+        .def_static("_create_from_tskit", &create_DiploidPopulation_from_tree_sequence,
+                    py::arg("columns"), py::arg("mutation_metadata"),
+                    py::arg("individual_metadata"), py::arg("import_mutations"))
+        .def_static("_create_from_arrays", &create_DiploidPopulation_from_arrays,
+                    py::arg("length"), py::arg("mutations"), py::arg("genomes"),
+                    py::arg("diploids"), py::arg("metadata"));
 }
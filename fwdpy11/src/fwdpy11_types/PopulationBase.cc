@@ -123,8 +123,18 @@ init_PopulationBase(py::module& m)
             },
             py::arg("pos"))
         .def_readonly("_haploid_genomes", &fwdpy11::Population::haploid_genomes)
-        .def_readonly("_fixations", &fwdpy11::Population::fixations)
-        .def_readonly("_fixation_times", &fwdpy11::Population::fixation_times)
+        .def_property_readonly(
+            "_fixations",
+            [](fwdpy11::Population& self)
+                -> const fwdpy11::Population::mutation_container& {
+                self.sort_fixations();
+                return self.fixations;
+            })
+        .def_property_readonly("_fixation_times",
+                               [](fwdpy11::Population& self) {
+                                   self.sort_fixations();
+                                   return self.fixation_times;
+                               })
         .def("_find_mutation_by_key",
              [](const fwdpy11::Population& pop,
                 const std::tuple<double, double, fwdpp::uint_t>& key,
@@ -139,6 +149,8 @@ init_PopulationBase(py::module& m)
              })
         // TODO: why does readwrite fail?
         .def_readonly("_tables", &fwdpy11::Population::tables)
+        .def_property_readonly("_tables_are_shared",
+                               &fwdpy11::Population::tables_are_shared)
         .def_property_readonly("_genetic_values",
                                [](const fwdpy11::Population& self) {
                                    return fwdpy11::make_2d_ndarray_readonly(
@@ -0,0 +1,379 @@
+//
+// Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <algorithm>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/edge.hpp>
+#include <fwdpp/ts/node.hpp>
+#include <fwdpp/ts/table_collection_functions.hpp>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    template <typename T>
+    std::vector<T>
+    column_to_vector(py::handle column)
+    {
+        auto a = column.cast<py::array_t<T, py::array::c_style | py::array::forcecast>>();
+        return std::vector<T>(a.data(), a.data() + a.size());
+    }
+
+    template <typename T>
+    std::vector<T>
+    optional_column(const py::object& columns, const char* key)
+    {
+        if (columns.is_none())
+            {
+                return {};
+            }
+        return column_to_vector<T>(columns[key]);
+    }
+
+    struct population_arrays
+    // Copies of the input arrays.  The metadata
+    // columns are empty if no metadata were given.
+    {
+        double length;
+        // Mutations
+        std::vector<double> position, s, h;
+        std::vector<std::int32_t> origin;
+        std::vector<std::uint8_t> neutral;
+        std::vector<std::uint16_t> label;
+        // Genomes, as a compressed sparse row matrix
+        std::vector<std::uint64_t> genome_offsets;
+        std::vector<fwdpp::uint_t> genome_keys;
+        // Pairs of genome indexes
+        std::vector<fwdpp::uint_t> diploids;
+        // Individual metadata
+        std::vector<double> g, e, w, geography;
+        std::vector<std::uint64_t> parents;
+        std::vector<std::int32_t> deme, sex;
+
+        population_arrays(double length_, const py::dict& mutations,
+                          const py::dict& genomes, const py::handle& diploids_,
+                          const py::object& metadata)
+            : length(length_), position(column_to_vector<double>(mutations["position"])),
+              s(column_to_vector<double>(mutations["s"])),
+              h(column_to_vector<double>(mutations["h"])),
+              origin(column_to_vector<std::int32_t>(mutations["origin"])),
+              neutral(column_to_vector<std::uint8_t>(mutations["neutral"])),
+              label(column_to_vector<std::uint16_t>(mutations["label"])),
+              genome_offsets(column_to_vector<std::uint64_t>(genomes["offsets"])),
+              genome_keys(column_to_vector<fwdpp::uint_t>(genomes["keys"])),
+              diploids(column_to_vector<fwdpp::uint_t>(diploids_)),
+              g(optional_column<double>(metadata, "g")),
+              e(optional_column<double>(metadata, "e")),
+              w(optional_column<double>(metadata, "w")),
+              geography(optional_column<double>(metadata, "geography")),
+              parents(optional_column<std::uint64_t>(metadata, "parents")),
+              deme(optional_column<std::int32_t>(metadata, "deme")),
+              sex(optional_column<std::int32_t>(metadata, "sex"))
+        {
+        }
+    };
+
+    void
+    validate(const population_arrays& arrays)
+    {
+        auto nmuts = arrays.position.size();
+        if (arrays.s.size() != nmuts || arrays.h.size() != nmuts
+            || arrays.origin.size() != nmuts || arrays.neutral.size() != nmuts
+            || arrays.label.size() != nmuts)
+            {
+                throw std::invalid_argument("mutation array lengths differ");
+            }
+        for (std::size_t i = 0; i < nmuts; ++i)
+            {
+                if (!(arrays.position[i] >= 0.0 && arrays.position[i] < arrays.length))
+                    {
+                        throw std::invalid_argument(
+                            "mutation positions must be in [0, length)");
+                    }
+                if (arrays.origin[i] >= 0)
+                    {
+                        throw std::invalid_argument(
+                            "mutation origin times must be < 0");
+                    }
+            }
+        if (arrays.genome_offsets.empty() || arrays.genome_offsets.front() != 0
+            || arrays.genome_offsets.back() != arrays.genome_keys.size()
+            || !std::is_sorted(begin(arrays.genome_offsets), end(arrays.genome_offsets)))
+            {
+                throw std::invalid_argument("invalid genome offsets");
+            }
+        if (std::any_of(begin(arrays.genome_keys), end(arrays.genome_keys),
+                        [nmuts](fwdpp::uint_t k) { return k >= nmuts; }))
+            {
+                throw std::invalid_argument("genome contains invalid mutation key");
+            }
+        if (arrays.diploids.empty() || arrays.diploids.size() % 2 != 0)
+            {
+                throw std::invalid_argument(
+                    "diploids must be a non-empty array of genome pairs");
+            }
+        auto ngenomes = arrays.genome_offsets.size() - 1;
+        if (std::any_of(begin(arrays.diploids), end(arrays.diploids),
+                        [ngenomes](fwdpp::uint_t i) { return i >= ngenomes; }))
+            {
+                throw std::invalid_argument("diploid contains invalid genome index");
+            }
+        if (!arrays.g.empty())
+            {
+                auto N = arrays.diploids.size() / 2;
+                if (arrays.g.size() != N || arrays.e.size() != N || arrays.w.size() != N
+                    || arrays.geography.size() != 3 * N || arrays.parents.size() != 2 * N
+                    || arrays.deme.size() != N || arrays.sex.size() != N)
+                    {
+                        throw std::invalid_argument(
+                            "metadata length does not match number of diploids");
+                    }
+                if (std::any_of(begin(arrays.deme), end(arrays.deme),
+                                [](std::int32_t d) { return d < 0; }))
+                    {
+                        throw std::invalid_argument("deme labels must be non-negative");
+                    }
+            }
+    }
+
+    void
+    add_mutations(const population_arrays& arrays, fwdpy11::DiploidPopulation& pop)
+    // Mutations keep their input order, so that the keys
+    // in the genome arrays are valid.  Selected mutations are
+    // added to the genomes, sorted by position, and neutral
+    // mutations are only recorded in the tables, as they are
+    // during a simulation.
+    {
+        pop.mutations.reserve(arrays.position.size());
+        for (std::size_t i = 0; i < arrays.position.size(); ++i)
+            {
+                pop.mutations.emplace_back(arrays.neutral[i], arrays.position[i],
+                                           arrays.s[i], arrays.h[i], arrays.origin[i],
+                                           arrays.label[i]);
+            }
+
+        auto ngenomes = arrays.genome_offsets.size() - 1;
+        pop.haploid_genomes.clear();
+        pop.haploid_genomes.reserve(ngenomes);
+        for (std::size_t i = 0; i < ngenomes; ++i)
+            {
+                std::vector<fwdpp::uint_t> smutations;
+                for (auto j = arrays.genome_offsets[i]; j < arrays.genome_offsets[i + 1];
+                     ++j)
+                    {
+                        auto k = arrays.genome_keys[j];
+                        if (!pop.mutations[k].neutral)
+                            {
+                                smutations.push_back(k);
+                            }
+                    }
+                std::sort(begin(smutations), end(smutations),
+                          [&pop](fwdpp::uint_t a, fwdpp::uint_t b) {
+                              return pop.mutations[a].pos < pop.mutations[b].pos;
+                          });
+                pop.haploid_genomes.emplace_back(0, std::vector<fwdpp::uint_t>{},
+                                                 std::move(smutations));
+            }
+        for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+            {
+                pop.diploids[i].first = arrays.diploids[2 * i];
+                pop.diploids[i].second = arrays.diploids[2 * i + 1];
+                pop.haploid_genomes[pop.diploids[i].first].n++;
+                pop.haploid_genomes[pop.diploids[i].second].n++;
+            }
+    }
+
+    std::vector<std::vector<fwdpp::ts::table_index_t>>
+    carriers_per_mutation(const population_arrays& arrays)
+    // Returns the sorted list of alive nodes carrying
+    // each mutation.  Node 2i carries the first genome
+    // of diploid i and node 2i + 1 carries the second.
+    {
+        std::vector<std::vector<fwdpp::ts::table_index_t>> rv(arrays.position.size());
+        std::vector<std::size_t> last_node(arrays.position.size(),
+                                           std::numeric_limits<std::size_t>::max());
+        for (std::size_t node = 0; node < arrays.diploids.size(); ++node)
+            {
+                auto genome = arrays.diploids[node];
+                for (auto j = arrays.genome_offsets[genome];
+                     j < arrays.genome_offsets[genome + 1]; ++j)
+                    {
+                        auto k = arrays.genome_keys[j];
+                        if (last_node[k] == node)
+                            {
+                                throw std::invalid_argument(
+                                    "genome contains the same mutation more than once");
+                            }
+                        last_node[k] = node;
+                        rv[k].push_back(static_cast<fwdpp::ts::table_index_t>(node));
+                    }
+            }
+        for (std::size_t k = 0; k < rv.size(); ++k)
+            {
+                if (rv[k].empty())
+                    {
+                        std::ostringstream o;
+                        o << "mutation " << k << " is not present in any genome";
+                        throw std::invalid_argument(o.str());
+                    }
+            }
+        return rv;
+    }
+
+    void
+    build_tables(const population_arrays& arrays,
+                 const std::vector<std::vector<fwdpp::ts::table_index_t>>& carriers,
+                 fwdpy11::DiploidPopulation& pop)
+    // Each mutation gets an ancestral node, at its origin time,
+    // that is the parent of the mutation's carriers over the
+    // interval from the mutation's position to the next
+    // mutation's position.  The first interval starts at zero and
+    // the last one ends at the genome length.  The tables therefore
+    // give the correct count of each mutation, and no node is the
+    // parent of alive nodes anywhere else in the genome.
+    {
+        std::vector<std::size_t> order(arrays.position.size());
+        std::iota(begin(order), end(order), 0);
+        std::sort(begin(order), end(order), [&arrays](std::size_t a, std::size_t b) {
+            return arrays.position[a] < arrays.position[b];
+        });
+        for (std::size_t i = 1; i < order.size(); ++i)
+            {
+                if (arrays.position[order[i]] == arrays.position[order[i - 1]])
+                    {
+                        throw std::invalid_argument(
+                            "more than one mutation at the same position");
+                    }
+            }
+
+        auto& tables = *pop.tables;
+        auto first_ancestor = tables.nodes.size();
+        if (first_ancestor + order.size() >= static_cast<std::size_t>(
+                std::numeric_limits<fwdpp::ts::table_index_t>::max()))
+            {
+                throw std::invalid_argument("range error for node labels");
+            }
+        tables.nodes.reserve(first_ancestor + order.size());
+        tables.sites.reserve(order.size());
+        tables.mutations.reserve(order.size());
+        std::vector<fwdpp::ts::edge> edges;
+        for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                auto k = order[i];
+                auto node = static_cast<fwdpp::ts::table_index_t>(tables.nodes.size());
+                tables.nodes.push_back(fwdpp::ts::node{
+                    tables.nodes[carriers[k].front()].deme,
+                    static_cast<double>(arrays.origin[k])});
+                double left = (i == 0) ? 0.0 : arrays.position[k];
+                double right = (i + 1 == order.size()) ? arrays.length
+                                                        : arrays.position[order[i + 1]];
+                for (auto c : carriers[k])
+                    {
+                        edges.push_back(fwdpp::ts::edge{left, right, node, c});
+                    }
+                tables.sites.push_back(fwdpp::ts::site{arrays.position[k], 0});
+                tables.mutations.push_back(fwdpp::ts::mutation_record{
+                    node, k,
+                    static_cast<fwdpp::ts::table_index_t>(tables.sites.size() - 1), 1,
+                    pop.mutations[k].neutral});
+            }
+        // Edges are sorted by parent time, from the most
+        // recent, then by parent and child.
+        std::stable_sort(begin(edges), end(edges),
+                         [&tables](const fwdpp::ts::edge& a, const fwdpp::ts::edge& b) {
+                             auto ta = tables.nodes[a.parent].time;
+                             auto tb = tables.nodes[b.parent].time;
+                             return ta > tb || (ta == tb && a.parent < b.parent);
+                         });
+        tables.edges.swap(edges);
+        tables.edge_offset = static_cast<fwdpp::ts::table_index_t>(tables.num_edges());
+        if (!fwdpp::ts::edge_table_minimally_sorted(tables))
+            {
+                throw std::runtime_error("edge table is not sorted");
+            }
+        tables.build_indexes();
+
+        pop.mcounts.resize(carriers.size());
+        for (std::size_t k = 0; k < carriers.size(); ++k)
+            {
+                pop.mcounts[k] = static_cast<fwdpp::uint_t>(carriers[k].size());
+            }
+        pop.mcounts_from_preserved_nodes.assign(carriers.size(), 0);
+    }
+
+    void
+    apply_metadata(const population_arrays& arrays, fwdpy11::DiploidPopulation& pop)
+    {
+        if (arrays.g.empty())
+            {
+                return;
+            }
+        for (std::size_t i = 0; i < pop.diploid_metadata.size(); ++i)
+            {
+                auto& md = pop.diploid_metadata[i];
+                md.g = arrays.g[i];
+                md.e = arrays.e[i];
+                md.w = arrays.w[i];
+                md.sex = arrays.sex[i];
+                md.deme = arrays.deme[i];
+                for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        md.geography[j] = arrays.geography[3 * i + j];
+                    }
+                for (std::size_t j = 0; j < 2; ++j)
+                    {
+                        md.parents[j] = arrays.parents[2 * i + j];
+                        pop.tables->nodes[md.nodes[j]].deme = md.deme;
+                    }
+            }
+    }
+
+    fwdpy11::DiploidPopulation
+    create_DiploidPopulation(const population_arrays& arrays)
+    {
+        validate(arrays);
+        auto N = static_cast<fwdpp::uint_t>(arrays.diploids.size() / 2);
+        fwdpy11::DiploidPopulation pop(N, arrays.length);
+        apply_metadata(arrays, pop);
+        auto carriers = carriers_per_mutation(arrays);
+        add_mutations(arrays, pop);
+        build_tables(arrays, carriers, pop);
+        pop.rebuild_mutation_lookup(false);
+        return pop;
+    }
+} // namespace
+
+fwdpy11::DiploidPopulation
+create_DiploidPopulation_from_arrays(double length, const py::dict& mutations,
+                                     const py::dict& genomes, const py::handle& diploids,
+                                     const py::object& metadata)
+{
+    population_arrays arrays(length, mutations, genomes, diploids, metadata);
+    py::gil_scoped_release release;
+    return create_DiploidPopulation(arrays);
+}
@@ -2,7 +2,10 @@
 #include <utility>
 #include <cstdint>
 #include <cmath>
-#include <tuple>
+#include <map>
+#include <limits>
+#include <stdexcept>
+#include <algorithm>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <fwdpp/ts/definitions.hpp>
@@ -10,107 +13,505 @@
 #include <fwdpp/ts/node.hpp>
 #include <fwdpp/ts/table_collection_functions.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/evolvets/count_mutations.hpp>
 
 namespace py = pybind11;
 
-// TODO put this in a header in case anyone else finds it useful?
-std::tuple<fwdpp::ts::std_table_collection::node_table, fwdpp::ts::std_table_collection::edge_table, int, double>
-convert_tables_from_tskit(py::object ts)
+namespace
 {
-    py::object tstables = ts.attr("tables");
-    py::object tsnodes = tstables.attr("nodes");
-    py::object tsedges = tstables.attr("edges");
-
-    auto left = tsedges.attr("left").cast<py::array_t<double>>();
-    auto right = tsedges.attr("right").cast<py::array_t<double>>();
-    auto parent = tsedges.attr("parent").cast<py::array_t<std::int32_t>>();
-    auto child = tsedges.attr("child").cast<py::array_t<std::int32_t>>();
-
-    // Use unchecked access for speed
-    auto left_ = left.unchecked<1>();
-    auto right_ = right.unchecked<1>();
-    auto parent_ = parent.unchecked<1>();
-    auto child_ = child.unchecked<1>();
-
-    std::vector<fwdpp::ts::edge> edges;
-    edges.reserve(left_.shape(0));
-    for (py::ssize_t i = 0; i < left_.shape(0); ++i)
-        {
-            edges.push_back(
-                fwdpp::ts::edge{ left_(i), right_(i), parent_(i), child_(i) });
-        }
+    // tskit's NODE_IS_SAMPLE flag
+    constexpr std::uint32_t NODE_IS_SAMPLE = 1;
+
+    template <typename T>
+    std::vector<T>
+    column_to_vector(py::handle column)
+    {
+        auto a = column.cast<py::array_t<T, py::array::c_style | py::array::forcecast>>();
+        return std::vector<T>(a.data(), a.data() + a.size());
+    }
+
+    template <typename T>
+    std::vector<T>
+    optional_column(const py::object& columns, const char* key)
+    {
+        if (columns.is_none())
+            {
+                return {};
+            }
+        return column_to_vector<T>(columns[key]);
+    }
 
-    // same treatment for nodes
-    auto time = tsnodes.attr("time").cast<py::array_t<double>>();
-    auto population
-        = tsnodes.attr("population").cast<py::array_t<std::int32_t>>();
-    auto time_ = time.unchecked<1>();
-    auto population_ = population.unchecked<1>();
-
-    std::vector<fwdpp::ts::node> nodes;
-    nodes.reserve(time_.shape(0));
-    int ntips = 0;
-    for (py::ssize_t i = 0; i < time_.shape(0); ++i)
+    struct tskit_columns
+    // Copies of the tskit table columns that we need.
+    // The metadata columns hold values decoded from
+    // fwdpy11's metadata schemas and are empty if
+    // there was no such metadata.
+    {
+        double sequence_length;
+        std::int32_t generation;
+        std::vector<std::uint32_t> node_flags;
+        std::vector<double> node_time;
+        std::vector<std::int32_t> node_population, node_individual;
+        std::vector<double> edge_left, edge_right;
+        std::vector<std::int32_t> edge_parent, edge_child;
+        std::vector<double> site_position;
+        std::vector<std::int32_t> mutation_site, mutation_node, mutation_parent;
+        std::vector<double> mutation_time;
+        // Mutation metadata
+        std::vector<std::uint8_t> mutation_has_metadata, mutation_neutral;
+        std::vector<double> mutation_s, mutation_h;
+        std::vector<std::int32_t> mutation_origin;
+        std::vector<std::uint16_t> mutation_label;
+        std::size_t ndim;
+        std::vector<double> mutation_esizes, mutation_heffects;
+        // Individual metadata
+        std::vector<double> individual_g, individual_e, individual_w,
+            individual_geography;
+        std::vector<std::uint64_t> individual_parents;
+        std::vector<std::int32_t> individual_sex;
+
+        tskit_columns(const py::dict& columns, const py::object& mutation_metadata,
+                      const py::object& individual_metadata)
+            : sequence_length(columns["sequence_length"].cast<double>()),
+              generation(columns["generation"].cast<std::int32_t>()),
+              node_flags(column_to_vector<std::uint32_t>(columns["node_flags"])),
+              node_time(column_to_vector<double>(columns["node_time"])),
+              node_population(column_to_vector<std::int32_t>(columns["node_population"])),
+              node_individual(column_to_vector<std::int32_t>(columns["node_individual"])),
+              edge_left(column_to_vector<double>(columns["edge_left"])),
+              edge_right(column_to_vector<double>(columns["edge_right"])),
+              edge_parent(column_to_vector<std::int32_t>(columns["edge_parent"])),
+              edge_child(column_to_vector<std::int32_t>(columns["edge_child"])),
+              site_position(column_to_vector<double>(columns["site_position"])),
+              mutation_site(column_to_vector<std::int32_t>(columns["mutation_site"])),
+              mutation_node(column_to_vector<std::int32_t>(columns["mutation_node"])),
+              mutation_parent(
+                  column_to_vector<std::int32_t>(columns["mutation_parent"])),
+              mutation_time(column_to_vector<double>(columns["mutation_time"])),
+              mutation_has_metadata(
+                  optional_column<std::uint8_t>(mutation_metadata, "has_metadata")),
+              mutation_neutral(optional_column<std::uint8_t>(mutation_metadata, "neutral")),
+              mutation_s(optional_column<double>(mutation_metadata, "s")),
+              mutation_h(optional_column<double>(mutation_metadata, "h")),
+              mutation_origin(optional_column<std::int32_t>(mutation_metadata, "origin")),
+              mutation_label(optional_column<std::uint16_t>(mutation_metadata, "label")),
+              ndim(mutation_metadata.is_none()
+                       ? 0
+                       : mutation_metadata["ndim"].cast<std::size_t>()),
+              mutation_esizes(optional_column<double>(mutation_metadata, "esizes")),
+              mutation_heffects(optional_column<double>(mutation_metadata, "heffects")),
+              individual_g(optional_column<double>(individual_metadata, "g")),
+              individual_e(optional_column<double>(individual_metadata, "e")),
+              individual_w(optional_column<double>(individual_metadata, "w")),
+              individual_geography(
+                  optional_column<double>(individual_metadata, "geography")),
+              individual_parents(
+                  optional_column<std::uint64_t>(individual_metadata, "parents")),
+              individual_sex(optional_column<std::int32_t>(individual_metadata, "sex"))
         {
-            // reverse direction of time
-            auto t = time_(i);
-            if (t != 0.0)
+            if (edge_right.size() != edge_left.size()
+                || edge_parent.size() != edge_left.size()
+                || edge_child.size() != edge_left.size()
+                || node_time.size() != node_flags.size()
+                || node_population.size() != node_flags.size()
+                || node_individual.size() != node_flags.size()
+                || mutation_node.size() != mutation_site.size()
+                || mutation_parent.size() != mutation_site.size()
+                || mutation_time.size() != mutation_site.size())
                 {
-                    t *= -1.0;
+                    throw std::invalid_argument("table column lengths differ");
                 }
-            else
+            if (!mutation_has_metadata.empty()
+                && mutation_has_metadata.size() != mutation_site.size())
                 {
-                    ++ntips;
+                    throw std::invalid_argument(
+                        "mutation metadata length does not match mutation table");
                 }
-            nodes.push_back(fwdpp::ts::node{ population_(i), t });
         }
+    };
 
-    double l = ts.attr("get_sequence_length")().cast<double>();
-    return std::make_tuple(std::move(nodes), std::move(edges), ntips, l);
-}
+    std::vector<std::vector<std::int32_t>>
+    pair_alive_nodes(const tskit_columns& columns, double& alive_time,
+                     std::vector<std::int32_t>& individuals)
+    // Alive nodes are sample nodes at the most recent sample time.
+    // They are grouped into diploids by their individual, or
+    // consecutively by node id if there are no individuals.
+    {
+        alive_time = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < columns.node_flags.size(); ++i)
+            {
+                if (columns.node_flags[i] & NODE_IS_SAMPLE)
+                    {
+                        alive_time = std::min(alive_time, columns.node_time[i]);
+                    }
+            }
+        std::vector<std::int32_t> alive;
+        std::size_t with_individual = 0;
+        for (std::size_t i = 0; i < columns.node_flags.size(); ++i)
+            {
+                if ((columns.node_flags[i] & NODE_IS_SAMPLE)
+                    && columns.node_time[i] == alive_time)
+                    {
+                        alive.push_back(static_cast<std::int32_t>(i));
+                        with_individual += (columns.node_individual[i] != -1);
+                    }
+            }
+        if (alive.empty())
+            {
+                throw std::invalid_argument("tree sequence has no sample nodes");
+            }
+        if (alive.size() % 2 != 0)
+            {
+                throw std::invalid_argument("tree sequence has odd number of tips");
+            }
 
-fwdpy11::DiploidPopulation
-create_DiploidPopulation_from_tree_sequence(py::object ts)
-{
-    auto t = convert_tables_from_tskit(ts);
-    auto nodes(std::move(std::get<0>(t)));
-    auto edges(std::move(std::get<1>(t)));
-    auto twoN = std::get<2>(t);
-    auto l = std::get<3>(t);
-    if (twoN % 2 != 0.0)
-        {
-            throw std::invalid_argument(
-                "tree sequence has odd number of tips");
-        }
+        std::vector<std::vector<std::int32_t>> rv;
+        individuals.clear();
+        if (with_individual == 0)
+            {
+                for (std::size_t i = 0; i < alive.size(); i += 2)
+                    {
+                        rv.push_back({alive[i], alive[i + 1]});
+                    }
+                return rv;
+            }
+        if (with_individual != alive.size())
+            {
+                throw std::invalid_argument(
+                    "some alive sample nodes are not assigned to an individual");
+            }
+        // Ordered by individual id
+        std::map<std::int32_t, std::vector<std::int32_t>> nodes_per_individual;
+        for (auto n : alive)
+            {
+                nodes_per_individual[columns.node_individual[n]].push_back(n);
+            }
+        for (auto& i : nodes_per_individual)
+            {
+                if (i.second.size() != 2)
+                    {
+                        throw std::invalid_argument(
+                            "individuals must have exactly two alive sample nodes");
+                    }
+                individuals.push_back(i.first);
+                rv.emplace_back(std::move(i.second));
+            }
+        return rv;
+    }
 
-    fwdpy11::DiploidPopulation pop(twoN / 2, l);
-    pop.tables->nodes.swap(nodes);
-    pop.tables->edges.swap(edges);
-    // NOTE: this may be an issue when we allow variable survival probabilitites!
-    pop.tables->edge_offset = static_cast<fwdpp::ts::table_index_t>(pop.tables->num_edges());
-    if(!fwdpp::ts::edge_table_minimally_sorted(*pop.tables))
-        {
-            throw std::runtime_error("edge table is not sorted");
-        }
-    pop.tables->build_indexes();
+    std::int32_t
+    mutation_origin_time(const tskit_columns& columns, std::size_t i, double alive_time)
+    {
+        if (!columns.mutation_has_metadata.empty() && columns.mutation_has_metadata[i])
+            {
+                return columns.mutation_origin[i] - columns.generation;
+            }
+        // tskit uses NaN for unknown mutation times
+        auto t = columns.mutation_time[i];
+        if (std::isnan(t))
+            {
+                t = columns.node_time[columns.mutation_node[i]];
+            }
+        return static_cast<std::int32_t>(std::ceil(alive_time - t));
+    }
 
-    // Fixed in 0.5.3: metadata nodes now correct
-    // This was GitHub issue 333
-    // Fixed in 0.6.0 to update the deme field from
-    // the node data.
-    for (std::uint32_t i = 0; i < pop.N; ++i)
-        {
-            pop.diploid_metadata[i].nodes[0] = 2 * i;
-            pop.diploid_metadata[i].nodes[1] = 2 * i + 1;
-            if (pop.tables->nodes[2*i].deme 
-                != pop.tables->nodes[2*i+1].deme)
-                {
-                    throw std::invalid_argument(
-                        "inconsistent deme fields for nodes in the same "
-                        "individual");
-                }
-            pop.diploid_metadata[i].deme
-                = pop.tables->nodes[2*i].deme;
-        }
-    return pop;
+    fwdpy11::Mutation
+    make_mutation(const tskit_columns& columns, std::size_t i, double alive_time)
+    {
+        auto pos = columns.site_position[columns.mutation_site[i]];
+        auto g = mutation_origin_time(columns, i, alive_time);
+        if (columns.mutation_has_metadata.empty() || !columns.mutation_has_metadata[i])
+            {
+                return fwdpy11::Mutation(true, pos, 0., 0., g);
+            }
+        bool neutral = columns.mutation_neutral[i];
+        if (columns.ndim == 0)
+            {
+                return fwdpy11::Mutation(neutral, pos, columns.mutation_s[i],
+                                         columns.mutation_h[i], g,
+                                         columns.mutation_label[i]);
+            }
+        auto first = static_cast<std::ptrdiff_t>(i * columns.ndim);
+        auto last = first + static_cast<std::ptrdiff_t>(columns.ndim);
+        return fwdpy11::Mutation(
+            neutral, pos, columns.mutation_s[i], columns.mutation_h[i], g,
+            std::vector<double>(columns.mutation_esizes.begin() + first,
+                                columns.mutation_esizes.begin() + last),
+            std::vector<double>(columns.mutation_heffects.begin() + first,
+                                columns.mutation_heffects.begin() + last),
+            columns.mutation_label[i]);
+    }
+
+    std::vector<std::vector<fwdpp::uint_t>>
+    selected_mutations_per_node(const fwdpy11::DiploidPopulation& pop,
+                                const std::vector<fwdpp::ts::table_index_t>& alive)
+    // Returns the keys of the selected mutations carried by
+    // each alive node, in the order of alive and sorted by position.
+    // We iterate over trees, keeping only the parent array, and check
+    // which alive nodes descend from the node of each selected mutation.
+    {
+        const auto& tables = *pop.tables;
+        std::vector<std::vector<fwdpp::uint_t>> rv(alive.size());
+        std::vector<fwdpp::ts::table_index_t> parent(tables.nodes.size(),
+                                                     fwdpp::ts::NULL_INDEX);
+        std::size_t next_insertion = 0, next_removal = 0;
+        double left = 0.0, right = 0.0;
+        for (const auto& mr : tables.mutations)
+            {
+                if (pop.mutations[mr.key].neutral)
+                    {
+                        continue;
+                    }
+                auto x = tables.sites[mr.site].position;
+                while (right <= x)
+                    {
+                        left = right;
+                        for (; next_removal < tables.output_right.size()
+                               && tables.edges[tables.output_right[next_removal]].right
+                                      == left;
+                             ++next_removal)
+                            {
+                                parent[tables.edges[tables.output_right[next_removal]]
+                                           .child]
+                                    = fwdpp::ts::NULL_INDEX;
+                            }
+                        for (; next_insertion < tables.input_left.size()
+                               && tables.edges[tables.input_left[next_insertion]].left
+                                      == left;
+                             ++next_insertion)
+                            {
+                                const auto& e
+                                    = tables.edges[tables.input_left[next_insertion]];
+                                parent[e.child] = e.parent;
+                            }
+                        right = tables.genome_length();
+                        if (next_insertion < tables.input_left.size())
+                            {
+                                right = std::min(
+                                    right,
+                                    tables.edges[tables.input_left[next_insertion]].left);
+                            }
+                        if (next_removal < tables.output_right.size())
+                            {
+                                right = std::min(
+                                    right,
+                                    tables.edges[tables.output_right[next_removal]].right);
+                            }
+                    }
+                for (std::size_t i = 0; i < alive.size(); ++i)
+                    {
+                        auto u = alive[i];
+                        while (u != fwdpp::ts::NULL_INDEX && u != mr.node)
+                            {
+                                u = parent[u];
+                            }
+                        if (u == mr.node)
+                            {
+                                rv[i].push_back(static_cast<fwdpp::uint_t>(mr.key));
+                            }
+                    }
+            }
+        return rv;
+    }
+
+    void
+    import_mutations(const tskit_columns& columns, double alive_time,
+                     const std::vector<fwdpp::ts::table_index_t>& alive,
+                     fwdpy11::DiploidPopulation& pop)
+    // fwdpy11 is an infinitely-many sites model, so we
+    // require each site to have at most one mutation.
+    {
+        std::vector<std::uint32_t> mutations_per_site(columns.site_position.size(), 0);
+        for (std::size_t i = 0; i < columns.mutation_site.size(); ++i)
+            {
+                if (columns.mutation_parent[i] != -1
+                    || ++mutations_per_site[columns.mutation_site[i]] > 1)
+                    {
+                        throw std::invalid_argument(
+                            "sites with more than one mutation are not supported");
+                    }
+            }
+
+        // Sites are sorted by position and mutations by site,
+        // which is the order fwdpp requires.
+        std::vector<fwdpp::ts::table_index_t> site_remap(columns.site_position.size(),
+                                                         fwdpp::ts::NULL_INDEX);
+        for (std::size_t i = 0; i < columns.mutation_site.size(); ++i)
+            {
+                auto site = columns.mutation_site[i];
+                site_remap[site]
+                    = static_cast<fwdpp::ts::table_index_t>(pop.tables->sites.size());
+                pop.tables->sites.push_back(
+                    fwdpp::ts::site{columns.site_position[site], 0});
+                pop.mutations.emplace_back(make_mutation(columns, i, alive_time));
+                pop.tables->mutations.push_back(fwdpp::ts::mutation_record{
+                    columns.mutation_node[i], pop.mutations.size() - 1, site_remap[site],
+                    1, pop.mutations.back().neutral});
+            }
+
+        fwdpy11::count_mutations(*pop.tables, pop.mutations, alive, pop.mcounts);
+
+        // Remove variants not present in the alive nodes
+        decltype(pop.mutations) mutations;
+        decltype(pop.mcounts) mcounts;
+        decltype(pop.tables->mutations) mutation_table;
+        decltype(pop.tables->sites) site_table;
+        for (auto mr : pop.tables->mutations)
+            {
+                if (pop.mcounts[mr.key] == 0)
+                    {
+                        continue;
+                    }
+                site_table.push_back(pop.tables->sites[mr.site]);
+                mr.site = static_cast<decltype(mr.site)>(site_table.size() - 1);
+                mutations.emplace_back(std::move(pop.mutations[mr.key]));
+                mcounts.push_back(pop.mcounts[mr.key]);
+                mr.key = mutations.size() - 1;
+                mutation_table.push_back(mr);
+            }
+        pop.mutations.swap(mutations);
+        pop.mcounts.swap(mcounts);
+        pop.mcounts_from_preserved_nodes.assign(pop.mcounts.size(), 0);
+        pop.tables->mutations.swap(mutation_table);
+        pop.tables->sites.swap(site_table);
+
+        // Selected mutations must also be in the genomes.
+        // Nodes without selected mutations share genome 0.
+        auto smutations = selected_mutations_per_node(pop, alive);
+        std::vector<std::size_t> genomes(alive.size(), 0);
+        fwdpp::uint_t empty_genomes = 0;
+        for (std::size_t i = 0; i < alive.size(); ++i)
+            {
+                if (smutations[i].empty())
+                    {
+                        ++empty_genomes;
+                        continue;
+                    }
+                genomes[i] = pop.haploid_genomes.size();
+                pop.haploid_genomes.emplace_back(1, std::vector<fwdpp::uint_t>{},
+                                                 std::move(smutations[i]));
+            }
+        pop.haploid_genomes[0].n = empty_genomes;
+        for (std::size_t i = 0; i < pop.diploids.size(); ++i)
+            {
+                pop.diploids[i].first = genomes[2 * i];
+                pop.diploids[i].second = genomes[2 * i + 1];
+            }
+        pop.rebuild_mutation_lookup(false);
+    }
+
+    void
+    apply_individual_metadata(const tskit_columns& columns,
+                              const std::vector<std::int32_t>& individuals,
+                              fwdpy11::DiploidPopulation& pop)
+    {
+        if (individuals.empty() || columns.individual_g.empty())
+            {
+                return;
+            }
+        for (std::size_t i = 0; i < individuals.size(); ++i)
+            {
+                auto ind = static_cast<std::size_t>(individuals[i]);
+                if (ind >= columns.individual_g.size())
+                    {
+                        throw std::invalid_argument(
+                            "individual metadata length does not match individual "
+                            "table");
+                    }
+                auto& md = pop.diploid_metadata[i];
+                md.g = columns.individual_g[ind];
+                md.e = columns.individual_e[ind];
+                md.w = columns.individual_w[ind];
+                md.sex = columns.individual_sex[ind];
+                for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        md.geography[j] = columns.individual_geography[3 * ind + j];
+                    }
+                for (std::size_t j = 0; j < 2; ++j)
+                    {
+                        md.parents[j] = columns.individual_parents[2 * ind + j];
+                    }
+            }
+    }
+
+    fwdpy11::DiploidPopulation
+    create_DiploidPopulation(const tskit_columns& columns, bool import_mutations_)
+    {
+        double alive_time;
+        std::vector<std::int32_t> individuals;
+        auto diploids = pair_alive_nodes(columns, alive_time, individuals);
+
+        fwdpy11::DiploidPopulation pop(static_cast<fwdpp::uint_t>(diploids.size()),
+                                       columns.sequence_length);
+        pop.tables->nodes.clear();
+        pop.tables->nodes.reserve(columns.node_time.size());
+        for (std::size_t i = 0; i < columns.node_time.size(); ++i)
+            {
+                // Reverse the direction of time so that
+                // the alive nodes are at time zero.
+                // NOTE: this avoids creating -0.0
+                auto t = alive_time - columns.node_time[i];
+                if (t == 0.0)
+                    {
+                        t = 0.0;
+                    }
+                pop.tables->nodes.push_back(
+                    fwdpp::ts::node{columns.node_population[i], t});
+            }
+        pop.tables->edges.clear();
+        pop.tables->edges.reserve(columns.edge_left.size());
+        for (std::size_t i = 0; i < columns.edge_left.size(); ++i)
+            {
+                pop.tables->edges.push_back(
+                    fwdpp::ts::edge{columns.edge_left[i], columns.edge_right[i],
+                                    columns.edge_parent[i], columns.edge_child[i]});
+            }
+        // NOTE: this may be an issue when we allow variable survival probabilitites!
+        pop.tables->edge_offset
+            = static_cast<fwdpp::ts::table_index_t>(pop.tables->num_edges());
+        if (!fwdpp::ts::edge_table_minimally_sorted(*pop.tables))
+            {
+                throw std::runtime_error("edge table is not sorted");
+            }
+        pop.tables->build_indexes();
+
+        // Fixed in 0.5.3: metadata nodes now correct
+        // This was GitHub issue 333
+        // Fixed in 0.6.0 to update the deme field from
+        // the node data.
+        std::vector<fwdpp::ts::table_index_t> alive;
+        alive.reserve(2 * diploids.size());
+        for (std::uint32_t i = 0; i < pop.N; ++i)
+            {
+                pop.diploid_metadata[i].nodes[0] = diploids[i][0];
+                pop.diploid_metadata[i].nodes[1] = diploids[i][1];
+                if (pop.tables->nodes[diploids[i][0]].deme
+                    != pop.tables->nodes[diploids[i][1]].deme)
+                    {
+                        throw std::invalid_argument(
+                            "inconsistent deme fields for nodes in the same "
+                            "individual");
+                    }
+                pop.diploid_metadata[i].deme = pop.tables->nodes[diploids[i][0]].deme;
+                alive.push_back(diploids[i][0]);
+                alive.push_back(diploids[i][1]);
+            }
+        apply_individual_metadata(columns, individuals, pop);
+        if (import_mutations_ && !columns.mutation_site.empty())
+            {
+                import_mutations(columns, alive_time, alive, pop);
+            }
+        return pop;
+    }
+} // namespace
+
+fwdpy11::DiploidPopulation
+create_DiploidPopulation_from_tree_sequence(const py::dict& columns,
+                                            const py::object& mutation_metadata,
+                                            const py::object& individual_metadata,
+                                            bool import_mutations)
+{
+    tskit_columns tables(columns, mutation_metadata, individual_metadata);
+    py::gil_scoped_release release;
+    return create_DiploidPopulation(tables, import_mutations);
 }
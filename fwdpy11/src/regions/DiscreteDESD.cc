@@ -55,7 +55,7 @@ class DiscreteDESD : public fwdpy11::Sregion
     std::uint32_t
     operator()(fwdpp::flagged_mutation_queue& recycling_bin,
                std::vector<fwdpy11::Mutation>& mutations,
-               std::unordered_multimap<double, std::uint32_t>& lookup_table,
+               fwdpy11::MutationPositionLookup& lookup_table,
                const std::uint32_t generation,
                const fwdpy11::GSLrng_t& rng) const override
     {
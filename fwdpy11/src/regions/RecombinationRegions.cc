@@ -27,6 +27,17 @@ init_RecombinationRegions(py::module& m)
             return fwdpy11::GeneralizedGeneticMap(std::move(callbacks));
         }));
 
+    py::class_<fwdpy11::AggregatedGeneticMap, fwdpy11::GeneticMap>(
+        m, "AggregatedGeneticMap")
+        .def(py::init([](py::list l) {
+            std::vector<fwdpy11::GeneticMapUnitParameters> units;
+            for (auto& i : l)
+                {
+                    units.push_back(i.cast<fwdpy11::GeneticMapUnit&>().parameters());
+                }
+            return fwdpy11::AggregatedGeneticMap(units);
+        }));
+
     m.def("dispatch_create_GeneticMap",
           [](py::object o, std::vector<fwdpy11::Region>& regions) {
               if (regions.empty() && o.is_none())
@@ -37,14 +48,13 @@ init_RecombinationRegions(py::module& m)
           });
 
     m.def("dispatch_create_GeneticMap", [](py::object, py::list l) {
-        std::vector<std::unique_ptr<fwdpp::genetic_map_unit>> callbacks;
+        std::vector<fwdpy11::GeneticMapUnitParameters> units;
         for (auto& i : l)
             {
-                auto& ref = i.cast<fwdpy11::GeneticMapUnit&>();
-                callbacks.emplace_back(ref.ll_clone());
+                units.push_back(i.cast<fwdpy11::GeneticMapUnit&>().parameters());
             }
-        std::unique_ptr<fwdpy11::GeneralizedGeneticMap> rv(
-            new fwdpy11::GeneralizedGeneticMap(std::move(callbacks)));
+        std::unique_ptr<fwdpy11::AggregatedGeneticMap> rv(
+            new fwdpy11::AggregatedGeneticMap(units));
         return rv;
     });
 }
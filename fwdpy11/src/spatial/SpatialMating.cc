@@ -0,0 +1,39 @@
+#include <fwdpy11/spatial/SpatialMating.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+namespace
+{
+    class PySpatialMating : public fwdpy11::SpatialMating
+    // Allows density_regulation to be overridden in Python
+    {
+      public:
+        using fwdpy11::SpatialMating::SpatialMating;
+
+        double
+        density_regulation(const fwdpy11::DiploidMetadata& individual,
+                           std::size_t num_neighbors) const override
+        {
+            PYBIND11_OVERLOAD(double, fwdpy11::SpatialMating, density_regulation,
+                              individual, num_neighbors);
+        }
+    };
+} // namespace
+
+void
+init_SpatialMating(py::module& m)
+{
+    py::class_<fwdpy11::SpatialMating, PySpatialMating>(m, "_ll_SpatialMating")
+        .def(py::init<double, double, double, double, double, std::size_t>(),
+             py::kw_only(), py::arg("width"), py::arg("height"),
+             py::arg("mating_sigma"), py::arg("dispersal_sigma"),
+             py::arg("local_capacity"), py::arg("max_candidates"))
+        .def_readonly("mating_radius", &fwdpy11::SpatialMating::mating_radius)
+        .def("density_regulation", &fwdpy11::SpatialMating::density_regulation,
+             py::arg("individual"), py::arg("num_neighbors"))
+        .def_property_readonly(
+            "density",
+            [](const fwdpy11::SpatialMating& self) { return self.density(); });
+}
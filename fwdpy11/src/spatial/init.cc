@@ -0,0 +1,11 @@
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void init_SpatialMating(py::module &);
+
+void
+initialize_spatial(py::module &m)
+{
+    init_SpatialMating(m);
+}
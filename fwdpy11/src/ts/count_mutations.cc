@@ -3,7 +3,7 @@
 #include <pybind11/stl.h>
 #include <fwdpy11/types/Population.hpp>
 #include <fwdpy11/numpy/array.hpp>
-#include <fwdpp/ts/count_mutations.hpp>
+#include <fwdpy11/evolvets/count_mutations.hpp>
 
 namespace py = pybind11;
 
@@ -15,11 +15,16 @@ init_count_mutations(py::module& m)
     m.def(
         "count_mutations",
         [](const fwdpy11::Population& pop,
-           const std::vector<fwdpp::ts::table_index_t>& samples) {
+           const std::vector<fwdpp::ts::table_index_t>& samples, unsigned threads) {
             std::vector<fwdpp::uint_t> mc(pop.mutations.size(), 0);
-            fwdpp::ts::count_mutations(*pop.tables, pop.mutations, samples, mc);
+            {
+                py::gil_scoped_release release;
+                fwdpy11::count_mutations(*pop.tables, pop.mutations, samples, mc,
+                                         threads);
+            }
             return fwdpy11::make_1d_array_with_capsule(std::move(mc));
         },
+        py::arg("pop"), py::arg("samples"), py::arg("threads") = 0,
         R"delim(
           Count mutation occurrences in a sample of nodes.
 
@@ -27,20 +32,32 @@ init_count_mutations(py::module& m)
           :type pop: :class:`fwdpy11.Population`
           :param samples: List of samples
           :type samples: list
+          :param threads: Number of threads. The default uses one per core.
+          :type threads: int
 
           :return: Array of mutation counts
           :rtype: numpy.ndarray
+
+          .. versionchanged:: 0.16.0
+
+              Counting is done in parallel and without holding the GIL.
+              Added `threads`.
           )delim");
 
     m.def(
         "count_mutations",
         [](const fwdpp::ts::std_table_collection& tables,
            const std::vector<fwdpy11::Mutation>& mutations,
-           const std::vector<fwdpp::ts::table_index_t>& samples) {
+           const std::vector<fwdpp::ts::table_index_t>& samples, unsigned threads) {
             std::vector<fwdpp::uint_t> mc(mutations.size(), 0);
-            fwdpp::ts::count_mutations(tables, mutations, samples, mc);
+            {
+                py::gil_scoped_release release;
+                fwdpy11::count_mutations(tables, mutations, samples, mc, threads);
+            }
             return fwdpy11::make_1d_array_with_capsule(std::move(mc));
         },
+        py::arg("tables"), py::arg("mutations"), py::arg("samples"),
+        py::arg("threads") = 0,
         R"delim(
           Count mutation occurrences in a sample of nodes.
 
@@ -50,8 +67,15 @@ init_count_mutations(py::module& m)
           :type mutations: :class:`fwdpy11.VecMutation`
           :param samples: List of samples
           :type samples: list
+          :param threads: Number of threads. The default uses one per core.
+          :type threads: int
 
           :return: Array of mutation counts
           :rtype: numpy.ndarray
+
+          .. versionchanged:: 0.16.0
+
+              Counting is done in parallel and without holding the GIL.
+              Added `threads`.
           )delim");
 }
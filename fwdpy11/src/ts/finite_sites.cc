@@ -0,0 +1,44 @@
+#include <fwdpy11/rng.hpp>
+#include <fwdpy11/types/Population.hpp>
+#include <fwdpy11/evolvets/finite_sites.hpp>
+#include <fwdpy11/numpy/array.hpp>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+void
+init_finite_sites(py::module& m)
+{
+    m.def(
+        "_finite_sites",
+        [](const fwdpy11::GSLrng_t& rng, const fwdpy11::Population& pop,
+           const double mu, const std::array<double, 4>& stationary,
+           const std::array<std::array<double, 4>, 4>& transitions) {
+            fwdpy11::finite_sites_mutations rv;
+            {
+                py::gil_scoped_release release;
+                rv = fwdpy11::finite_sites(rng, *pop.tables, mu,
+                                           fwdpy11::nucleotide_model{stationary, transitions});
+            }
+            py::dict columns;
+            columns["site_position"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.site_position));
+            columns["site_ancestral_state"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.site_ancestral_state));
+            columns["mutation_site"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.mutation_site));
+            columns["mutation_node"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.mutation_node));
+            columns["mutation_time"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.mutation_time));
+            columns["mutation_derived_state"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.mutation_derived_state));
+            columns["mutation_parent"]
+                = fwdpy11::make_1d_array_with_capsule(std::move(rv.mutation_parent));
+            return columns;
+        },
+        py::arg("rng"), py::arg("pop"), py::arg("mu"), py::arg("stationary"),
+        py::arg("transitions"));
+}
@@ -8,6 +8,7 @@ void init_count_mutations(py::module&);
 void init_simplify_functions(py::module&);
 void init_data_matrix_from_tables(py::module&);
 void init_infinite_sites(py::module&);
+void init_finite_sites(py::module&);
 void
 init_DataMatrixIterator(py::module& m);
 
@@ -20,5 +21,6 @@ init_ts(py::module& m)
     init_simplify_functions(m);
     init_data_matrix_from_tables(m);
     init_infinite_sites(m);
+    init_finite_sites(m);
     init_DataMatrixIterator(m);
 }
@@ -1,3 +1,11 @@
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
 #include <fwdpy11/types/Population.hpp>
 #include <fwdpy11/numpy/array.hpp>
 #include <pybind11/pybind11.h>
@@ -9,32 +17,171 @@ namespace py = pybind11;
 
 PYBIND11_MAKE_OPAQUE(std::vector<fwdpy11::Mutation>);
 
-py::tuple
-simplify(const fwdpy11::Population& pop,
-         const std::vector<fwdpp::ts::table_index_t>& samples)
+namespace
 {
-    if (pop.tables->genome_length() == std::numeric_limits<double>::max())
+    using table_simplifier
+        = fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection>;
+    using simplification_result = std::pair<fwdpp::ts::std_table_collection,
+                                            std::vector<fwdpp::ts::table_index_t>>;
+
+    void
+    validate_simplification_input(const fwdpp::ts::std_table_collection& tables,
+                                  const std::vector<fwdpp::ts::table_index_t>& samples)
+    {
+        if (tables.genome_length() == std::numeric_limits<double>::max())
+            {
+                throw std::invalid_argument("population is not using tree sequences");
+            }
+        if (tables.num_nodes() == 0)
+            {
+                throw std::invalid_argument("population has empty TableCollection");
+            }
+        if (samples.empty())
+            {
+                throw std::invalid_argument("empty sample list");
+            }
+        if (std::any_of(samples.begin(), samples.end(),
+                        [&tables](const fwdpp::ts::table_index_t s) {
+                            return s == fwdpp::ts::NULL_INDEX
+                                   || static_cast<std::size_t>(s) >= tables.num_nodes();
+                        }))
+            {
+                throw std::invalid_argument("invalid sample list");
+            }
+    }
+
+    class Simplifier
+    // Simplifies table collections while keeping the internal
+    // buffers of fwdpp's simplifier between calls.  There is one
+    // simplifier per thread used by simplify_batch.
+    //
+    // The bindings release the GIL, so the public functions
+    // hold a mutex while they use the simplifiers.
+    {
+      private:
+        std::vector<std::unique_ptr<table_simplifier>> simplifiers;
+        std::mutex simplifiers_mutex;
+
+        void
+        reserve_simplifiers(std::size_t n)
         {
-            throw std::invalid_argument("population is not using tree sequences");
+            while (simplifiers.size() < n)
+                {
+                    simplifiers.emplace_back(new table_simplifier{});
+                }
         }
-    if (pop.tables->num_nodes() == 0)
+
+        static void
+        finish(fwdpp::ts::std_table_collection& tables, bool build_indexes)
+        // Stale indexes are removed if they are not rebuilt.
+        {
+            if (build_indexes)
+                {
+                    tables.build_indexes();
+                }
+            else
+                {
+                    tables.input_left.clear();
+                    tables.output_right.clear();
+                }
+        }
+
+      public:
+        Simplifier() : simplifiers{}, simplifiers_mutex{}
         {
-            throw std::invalid_argument("population has empty TableCollection");
         }
-    if (samples.empty())
+
+        std::vector<fwdpp::ts::table_index_t>
+        simplify(fwdpp::ts::std_table_collection& tables,
+                 const std::vector<fwdpp::ts::table_index_t>& samples,
+                 bool build_indexes)
+        // Simplifies tables in place and returns the node id map.
         {
-            throw std::invalid_argument("empty sample list");
+            validate_simplification_input(tables, samples);
+            std::lock_guard<std::mutex> lock(simplifiers_mutex);
+            reserve_simplifiers(1);
+            auto rv = simplifiers[0]->simplify(tables, samples);
+            finish(tables, build_indexes);
+            return std::move(rv.first);
         }
-    if (std::any_of(samples.begin(), samples.end(),
-                    [&pop](const fwdpp::ts::table_index_t s) {
-                        return s == fwdpp::ts::NULL_INDEX
-                               || static_cast<std::size_t>(s) >= pop.tables->num_nodes();
-                    }))
+
+        std::vector<simplification_result>
+        simplify_batch(const fwdpp::ts::std_table_collection& tables,
+                       const std::vector<std::vector<fwdpp::ts::table_index_t>>& sample_sets,
+                       bool build_indexes, unsigned nthreads)
+        // Simplifies a copy of tables to each sample set.
+        // Sample set i is handled by thread i % nthreads.
         {
-            throw std::invalid_argument("invalid sample list");
+            for (const auto& samples : sample_sets)
+                {
+                    validate_simplification_input(tables, samples);
+                }
+            if (nthreads == 0)
+                {
+                    nthreads = std::max(1u, std::thread::hardware_concurrency());
+                }
+            nthreads = static_cast<unsigned>(
+                std::min<std::size_t>(nthreads, sample_sets.size()));
+            std::lock_guard<std::mutex> lock(simplifiers_mutex);
+            reserve_simplifiers(nthreads);
+
+            std::vector<simplification_result> rv(
+                sample_sets.size(),
+                simplification_result(
+                    fwdpp::ts::std_table_collection(tables.genome_length()), {}));
+            auto worker = [&](unsigned thread) {
+                for (std::size_t i = thread; i < sample_sets.size(); i += nthreads)
+                    {
+                        rv[i].first = tables;
+                        auto result
+                            = simplifiers[thread]->simplify(rv[i].first, sample_sets[i]);
+                        finish(rv[i].first, build_indexes);
+                        rv[i].second = std::move(result.first);
+                    }
+            };
+            if (nthreads < 2)
+                {
+                    worker(0);
+                    return rv;
+                }
+            std::vector<std::thread> threads;
+            std::vector<std::exception_ptr> errors(nthreads);
+            for (unsigned t = 0; t < nthreads; ++t)
+                {
+                    threads.emplace_back([&worker, &errors, t]() {
+                        try
+                            {
+                                worker(t);
+                            }
+                        catch (...)
+                            {
+                                errors[t] = std::current_exception();
+                            }
+                    });
+                }
+            for (auto& t : threads)
+                {
+                    t.join();
+                }
+            for (auto& e : errors)
+                {
+                    if (e)
+                        {
+                            std::rethrow_exception(e);
+                        }
+                }
+            return rv;
         }
+    };
+} // namespace
+
+py::tuple
+simplify(const fwdpy11::Population& pop,
+         const std::vector<fwdpp::ts::table_index_t>& samples)
+{
+    validate_simplification_input(*pop.tables, samples);
     auto t(*pop.tables);
-    fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection> simplifier{};
+    table_simplifier simplifier{};
     auto rv = simplifier.simplify(t, samples);
     t.build_indexes();
     return py::make_tuple(std::move(t),
@@ -51,12 +198,49 @@ init_simplify_functions(py::module& m)
         [](const fwdpp::ts::std_table_collection& tables,
            const std::vector<fwdpp::ts::table_index_t>& samples) -> py::tuple {
             auto t(tables);
-            fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection> simplifier{};
+            table_simplifier simplifier{};
             auto rv = simplifier.simplify(t, samples);
             t.build_indexes();
             return py::make_tuple(
                 std::move(t), fwdpy11::make_1d_array_with_capsule(std::move(rv.first)));
         },
         py::arg("tables"), py::arg("samples"));
-}
 
+    py::class_<Simplifier>(m, "ll_Simplifier")
+        .def(py::init<>())
+        .def(
+            "_simplify",
+            [](Simplifier& self, fwdpp::ts::std_table_collection& tables,
+               const std::vector<fwdpp::ts::table_index_t>& samples,
+               bool build_indexes) {
+                std::vector<fwdpp::ts::table_index_t> idmap;
+                {
+                    py::gil_scoped_release release;
+                    idmap = self.simplify(tables, samples, build_indexes);
+                }
+                return fwdpy11::make_1d_array_with_capsule(std::move(idmap));
+            },
+            py::arg("tables"), py::arg("samples"), py::arg("build_indexes"))
+        .def(
+            "_simplify_batch",
+            [](Simplifier& self, const fwdpp::ts::std_table_collection& tables,
+               const std::vector<std::vector<fwdpp::ts::table_index_t>>& sample_sets,
+               bool build_indexes, unsigned threads) {
+                std::vector<simplification_result> results;
+                {
+                    py::gil_scoped_release release;
+                    results = self.simplify_batch(tables, sample_sets, build_indexes,
+                                                  threads);
+                }
+                py::list rv;
+                for (auto& r : results)
+                    {
+                        rv.append(py::make_tuple(
+                            std::move(r.first),
+                            fwdpy11::make_1d_array_with_capsule(std::move(r.second))));
+                    }
+                return rv;
+            },
+            py::arg("tables"), py::arg("sample_sets"), py::arg("build_indexes"),
+            py::arg("threads"));
+}
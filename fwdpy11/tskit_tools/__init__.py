@@ -25,6 +25,7 @@ interact with ``tskit``.
 """
 
 from ._flags import *  # NOQA
+from .finite_sites import HKY, JC69, add_finite_sites_mutations  # NOQA
 from .metadata import (DiploidMetadata, decode_individual_metadata,
                        decode_mutation_metadata)
 from .trees import WrappedTreeSequence
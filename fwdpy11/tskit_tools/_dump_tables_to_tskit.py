@@ -138,6 +138,9 @@ def _dump_tables_to_tskit(
 ) -> typing.Union[tskit.TreeSequence, WrappedTreeSequence]:
     from .._fwdpy11 import gsl_version, pybind11_version
 
+    # Tables shared with a clone must be left intact
+    clear_tables = destructive is True and not self._tables_are_shared
+
     environment = tskit.provenance.get_environment(
         extra_libs={
             "gsl": {"version": gsl_version()["gsl_version"]},
@@ -219,13 +222,15 @@ def _dump_tables_to_tskit(
         self._clear_diploid_metadata()
         self._clear_ancient_sample_metadata()
         node_view = None
-        self.tables._clear_nodes()
+        if clear_tables is True:
+            self.tables._clear_nodes()
 
     _dump_mutation_site_and_site_tables(self, tc)
     if destructive is True:
         self._clear_mutations()
-        self.tables._clear_sites()
-        self.tables._clear_mutations()
+        if clear_tables is True:
+            self.tables._clear_sites()
+            self.tables._clear_mutations()
 
     tc.edges.set_columns(
         left=edge_view["left"],
@@ -235,6 +240,7 @@ def _dump_tables_to_tskit(
     )
     if destructive is True:
         edge_view = None
+    if clear_tables is True:
         self.tables._clear_edges()
 
     tc.provenances.add_row(json.dumps(provenance))
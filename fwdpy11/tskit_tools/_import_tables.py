@@ -0,0 +1,218 @@
+#
+# Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+#
+# This file is part of fwdpy11.
+#
+# fwdpy11 is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# fwdpy11 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+#
+"""
+Conversion of tskit tables into the columns
+used to initialize populations.
+
+Metadata written using fwdpy11's struct-encoded schemas
+are decoded in bulk with numpy when each row has the
+same length, which is the case for data exported by
+fwdpy11.  Otherwise, rows are decoded one at a time.
+"""
+
+import copy
+import struct
+import typing
+
+import numpy as np
+import tskit
+
+from .metadata_schema import (IndividualDiploidMetadata, MutationMetadata,
+                              MutationMetadataWithVectors)
+
+_NUMPY_FORMATS = {"d": "<f8", "i": "<i4", "H": "<u2", "Q": "<u8", "?": "u1"}
+
+
+def _probe_value(fmt: str):
+    # A value whose encoding has no zero bytes
+    if fmt == "?":
+        return 1
+    return struct.unpack("<" + fmt, b"\x01" * struct.calcsize("<" + fmt))[0]
+
+
+def _struct_dtype(
+    schema: tskit.metadata.MetadataSchema, array_lengths: typing.Dict[str, int]
+) -> np.dtype:
+    """
+    The numpy dtype of rows encoded by a struct codec.
+
+    The layout is found by encoding a row of zeros and then,
+    for each value, a row where only that value is not zero.
+    Array elements become fields named "<name>_<index>".
+    """
+    properties = schema.schema["properties"]
+    row = {}
+    for name, p in properties.items():
+        if p["type"] == "array":
+            row[name] = [0] * array_lengths[name]
+        else:
+            row[name] = 0
+    zeros = schema.validate_and_encode_row(row)
+    names, formats, offsets = [], [], []
+    for name, p in properties.items():
+        if p["type"] == "array":
+            fmt = p["items"]["binaryFormat"]
+            elements = range(array_lengths[name])
+        else:
+            fmt = p["binaryFormat"]
+            elements = [None]
+        for i in elements:
+            probe = copy.deepcopy(row)
+            if i is None:
+                probe[name] = _probe_value(fmt)
+                names.append(name)
+            else:
+                probe[name][i] = _probe_value(fmt)
+                names.append(f"{name}_{i}")
+            encoded = schema.validate_and_encode_row(probe)
+            offsets.append(next(j for j, b in enumerate(zeros) if encoded[j] != b))
+            formats.append(_NUMPY_FORMATS[fmt])
+    return np.dtype(
+        {"names": names, "formats": formats, "offsets": offsets, "itemsize": len(zeros)}
+    )
+
+
+def _decode_fixed_size_rows(table, dtype: np.dtype) -> typing.Optional[np.ndarray]:
+    lengths = np.diff(table.metadata_offset)
+    if not np.all(lengths == dtype.itemsize):
+        return None
+    return np.frombuffer(table.metadata.tobytes(), dtype=dtype)
+
+
+def _decode_mutation_metadata(
+    tables: tskit.TableCollection,
+) -> typing.Optional[typing.Dict]:
+    mutations = tables.mutations
+    schema = mutations.metadata_schema.schema
+    if schema is None or schema.get("codec") != "struct":
+        return None
+    if schema.get("name") not in (
+        MutationMetadata.schema["name"],
+        MutationMetadataWithVectors.schema["name"],
+    ):
+        return None
+
+    n = mutations.num_rows
+    rv = {"ndim": 0}
+    if "esizes" not in schema["properties"]:
+        decoded = _decode_fixed_size_rows(
+            mutations, _struct_dtype(mutations.metadata_schema, {})
+        )
+        if decoded is not None:
+            rv["has_metadata"] = np.ones(n, dtype=np.uint8)
+            for name in ("s", "h", "origin", "neutral", "label"):
+                rv[name] = decoded[name]
+            return rv
+
+    # General case: rows may be null or contain vectors
+    rv["has_metadata"] = np.zeros(n, dtype=np.uint8)
+    rv["s"] = np.zeros(n)
+    rv["h"] = np.zeros(n)
+    rv["origin"] = np.zeros(n, dtype=np.int32)
+    rv["neutral"] = np.ones(n, dtype=np.uint8)
+    rv["label"] = np.zeros(n, dtype=np.uint16)
+    esizes, heffects = [], []
+    for i, m in enumerate(mutations):
+        md = m.metadata
+        if md is None:
+            esizes.append(None)
+            heffects.append(None)
+            continue
+        rv["has_metadata"][i] = 1
+        for name in ("s", "h", "origin", "neutral", "label"):
+            rv[name][i] = md[name]
+        esizes.append(md.get("esizes", []))
+        heffects.append(md.get("heffects", []))
+    ndim = max((len(e) for e in esizes if e is not None), default=0)
+    if ndim > 0:
+        rv["ndim"] = ndim
+        rv["esizes"] = np.zeros((n, ndim))
+        rv["heffects"] = np.zeros((n, ndim))
+        for i, (e, h) in enumerate(zip(esizes, heffects)):
+            if e is not None:
+                if len(e) != ndim or len(h) != ndim:
+                    raise ValueError(
+                        "mutations have effect size vectors of different lengths"
+                    )
+                rv["esizes"][i] = e
+                rv["heffects"][i] = h
+    return rv
+
+
+def _decode_individual_metadata(
+    tables: tskit.TableCollection,
+) -> typing.Optional[typing.Dict]:
+    individuals = tables.individuals
+    schema = individuals.metadata_schema.schema
+    if (
+        individuals.num_rows == 0
+        or schema is None
+        or schema.get("codec") != "struct"
+        or set(schema["properties"])
+        != set(IndividualDiploidMetadata.schema["properties"])
+    ):
+        return None
+    dtype = _struct_dtype(
+        individuals.metadata_schema, {"geography": 3, "parents": 2, "nodes": 2}
+    )
+    decoded = _decode_fixed_size_rows(individuals, dtype)
+    if decoded is None:
+        return None
+    return {
+        "g": decoded["g"],
+        "e": decoded["e"],
+        "w": decoded["w"],
+        "sex": decoded["sex"],
+        "geography": np.stack([decoded[f"geography_{i}"] for i in range(3)], axis=1),
+        "parents": np.stack([decoded[f"parents_{i}"] for i in range(2)], axis=1),
+    }
+
+
+def tree_sequence_columns(ts: tskit.TreeSequence, import_mutations: bool):
+    """
+    Returns the table columns, decoded mutation metadata,
+    and decoded individual metadata of a tree sequence.
+    The metadata values are None if fwdpy11's metadata
+    schemas are not used.
+    """
+    tables = ts.tables
+    generation = 0
+    if isinstance(ts.metadata, dict):
+        generation = ts.metadata.get("generation", 0)
+    columns = {
+        "sequence_length": ts.sequence_length,
+        "generation": generation,
+        "node_flags": tables.nodes.flags,
+        "node_time": tables.nodes.time,
+        "node_population": tables.nodes.population,
+        "node_individual": tables.nodes.individual,
+        "edge_left": tables.edges.left,
+        "edge_right": tables.edges.right,
+        "edge_parent": tables.edges.parent,
+        "edge_child": tables.edges.child,
+        "site_position": tables.sites.position,
+        "mutation_site": tables.mutations.site,
+        "mutation_node": tables.mutations.node,
+        "mutation_parent": tables.mutations.parent,
+        "mutation_time": tables.mutations.time,
+    }
+    mutation_metadata = None
+    if import_mutations:
+        mutation_metadata = _decode_mutation_metadata(tables)
+    return columns, mutation_metadata, _decode_individual_metadata(tables)
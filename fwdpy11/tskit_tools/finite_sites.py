@@ -0,0 +1,213 @@
+#
+# Copyright (C) 2021 Kevin Thornton <krthornt@uci.edu>
+#
+# This file is part of fwdpy11.
+#
+# fwdpy11 is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# fwdpy11 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+#
+"""
+Neutral mutations under finite-sites nucleotide models,
+written directly to :class:`tskit.TableCollection` objects.
+
+.. versionadded:: 0.16.0
+"""
+
+import typing
+
+import attr
+import numpy as np
+import tskit
+
+from .._fwdpy11 import GSLrng, _finite_sites
+
+NUCLEOTIDES = "ACGT"
+
+# A <-> G and C <-> T
+_TRANSITIONS = np.array(
+    [[0, 0, 1, 0], [0, 0, 0, 1], [1, 0, 0, 0], [0, 1, 0, 0]], dtype=bool
+)
+
+
+def _uniformized(Q: np.ndarray) -> np.ndarray:
+    """
+    The transition matrix of the jump chain of
+    a rate matrix, uniformized so that mutation
+    events occur at the same rate in each state.
+    The state with the largest total rate has
+    no silent events.
+    """
+    Q = np.array(Q, dtype=np.float64)
+    np.fill_diagonal(Q, 0.0)
+    rates = Q.sum(axis=1)
+    P = Q / rates.max()
+    np.fill_diagonal(P, 1.0 - rates / rates.max())
+    return P
+
+
+@attr.s(auto_attribs=True, frozen=True, repr_ns="fwdpy11.tskit_tools")
+class JC69(object):
+    """
+    The Jukes-Cantor (1969) model.
+
+    All nucleotides are equally frequent and every
+    mutation changes the state to one of the
+    other three nucleotides with equal probability.
+
+    .. versionadded:: 0.16.0
+    """
+
+    @property
+    def stationary_distribution(self) -> np.ndarray:
+        return np.full(4, 0.25)
+
+    @property
+    def transition_matrix(self) -> np.ndarray:
+        return _uniformized(np.ones((4, 4)))
+
+
+@attr.s(auto_attribs=True, frozen=True, repr_ns="fwdpy11.tskit_tools")
+class HKY(object):
+    """
+    The Hasegawa-Kishino-Yano (1985) model.
+
+    This class has the following attributes, whose names
+    are also `kwargs` for intitialization.  The attribute names
+    also determine the order of positional arguments:
+
+    :param kappa: The ratio of the transition rate
+                  to the transversion rate
+    :type kappa: float
+    :param equilibrium_frequencies: The frequencies of
+                                    A, C, G, and T.
+    :type equilibrium_frequencies: list-like
+
+    The rate of change from nucleotide `i` to `j` is proportional
+    to the frequency of `j`, multiplied by `kappa` for transitions.
+    Mutation events are uniformized: they happen at the same rate
+    at all sites, and some of them are silent unless all
+    nucleotides have the same total rate of change.
+
+    .. versionadded:: 0.16.0
+    """
+
+    kappa: float = attr.ib(converter=float)
+    equilibrium_frequencies: typing.Tuple[float, float, float, float] = attr.ib(
+        default=(0.25, 0.25, 0.25, 0.25), converter=lambda x: tuple(float(i) for i in x)
+    )
+
+    @kappa.validator
+    def validate_kappa(self, attribute, value):
+        if not np.isfinite(value) or value <= 0.0:
+            raise ValueError(f"kappa must be > 0, got {value}")
+
+    @equilibrium_frequencies.validator
+    def validate_equilibrium_frequencies(self, attribute, value):
+        if len(value) != 4:
+            raise ValueError("there must be four equilibrium frequencies")
+        if any(not np.isfinite(i) or i <= 0.0 for i in value):
+            raise ValueError("equilibrium frequencies must be > 0")
+        if not np.isclose(sum(value), 1.0):
+            raise ValueError("equilibrium frequencies must sum to 1")
+
+    @property
+    def stationary_distribution(self) -> np.ndarray:
+        return np.array(self.equilibrium_frequencies)
+
+    @property
+    def transition_matrix(self) -> np.ndarray:
+        Q = np.tile(self.stationary_distribution, (4, 1))
+        Q[_TRANSITIONS] *= self.kappa
+        return _uniformized(Q)
+
+
+def add_finite_sites_mutations(
+    tables: tskit.TableCollection,
+    pop,
+    rng: GSLrng,
+    mu: float,
+    model: typing.Optional[typing.Union[JC69, HKY]] = None,
+) -> int:
+    """
+    Add neutral mutations from a finite-sites model to tskit tables.
+
+    :param tables: Tables made from the population,
+                   using :meth:`fwdpy11.DiploidPopulation.dump_tables_to_tskit`.
+    :type tables: :class:`tskit.TableCollection`
+    :param pop: A population
+    :type pop: :class:`fwdpy11.DiploidPopulation`
+    :param rng: Random number generator
+    :type rng: :class:`fwdpy11.GSLrng`
+    :param mu: The rate of mutation events, per haploid genome per generation.
+    :type mu: float
+    :param model: The nucleotide model.  Defaults to :class:`JC69`.
+    :type model: :class:`JC69` or :class:`HKY`
+
+    :returns: The number of mutations added.
+    :rtype: int
+
+    The sites are the integers in `[0, genome_length)`, so the
+    genome length must be an integer.  Any site may mutate
+    more than once.  The `parent` column of the mutation table
+    links each mutation to the previous mutation at the site
+    that it inherits, and states are written as the letters
+    ``A``, ``C``, ``G``, and ``T``.  Sites already in the
+    population's site table are not mutated.
+
+    The mutations are generated from `pop.tables`, which
+    must be indexed.  They are added to `tables` in bulk.
+    If `tables` already has sites, the tables are sorted
+    afterwards.
+
+    .. note::
+
+        The new mutations are not added to the population.
+
+    .. versionadded:: 0.16.0
+    """
+    if model is None:
+        model = JC69()
+    if tables.nodes.num_rows != len(pop.tables.nodes):
+        raise ValueError("the node tables of tables and pop differ in length")
+    columns = _finite_sites(
+        rng, pop, mu, model.stationary_distribution, model.transition_matrix
+    )
+    nmutations = len(columns["mutation_site"])
+    if nmutations == 0:
+        return 0
+
+    # Convert times to those of dump_tables_to_tskit
+    tmax = np.array(pop.tables.nodes, copy=False)["time"].max()
+    letters = np.frombuffer(NUCLEOTIDES.encode("ascii"), dtype=np.int8)
+    nsites = len(columns["site_position"])
+    site_offset = tables.sites.num_rows
+    mutation_offset = tables.mutations.num_rows
+    parent = columns["mutation_parent"].astype(np.int32)
+    parent[parent >= 0] += mutation_offset
+
+    tables.sites.append_columns(
+        position=columns["site_position"],
+        ancestral_state=letters[columns["site_ancestral_state"]],
+        ancestral_state_offset=np.arange(nsites + 1, dtype=np.uint32),
+    )
+    tables.mutations.append_columns(
+        site=columns["mutation_site"] + site_offset,
+        node=columns["mutation_node"],
+        time=tmax - columns["mutation_time"],
+        derived_state=letters[columns["mutation_derived_state"]],
+        derived_state_offset=np.arange(nmutations + 1, dtype=np.uint32),
+        parent=parent,
+    )
+    if site_offset > 0:
+        tables.sort()
+    return nmutations
@@ -6,7 +6,7 @@ call_Sregion(const fwdpy11::Sregion& s, unsigned seed)
 {
     fwdpy11::GSLrng_t rng(seed);
     std::vector<fwdpy11::Mutation> mutations;
-    std::unordered_multimap<double, std::uint32_t> lookup_table;
+    fwdpy11::MutationPositionLookup lookup_table;
     fwdpp::flagged_mutation_queue recycling_bin = fwdpp::empty_mutation_queue();
 
     auto idx = s(recycling_bin, mutations, lookup_table, 0u, rng);
@@ -0,0 +1,87 @@
+import copy
+
+import numpy as np
+
+import fwdpy11
+
+
+def _params(simlen):
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05, 0.5)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": simlen,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+def _burn_in():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(202)
+    fwdpy11.evolvets(rng, pop, _params(50), 100)
+    return pop
+
+
+def _tables(pop):
+    return {
+        t: np.array(getattr(pop.tables, t), copy=True)
+        for t in ("nodes", "edges", "sites", "mutations")
+    }
+
+
+def _assert_same_tables(a, b):
+    for t in a:
+        assert np.array_equal(a[t], b[t])
+
+
+def test_clone_shares_tables():
+    pop = _burn_in()
+    assert pop._tables_are_shared is False
+    clone = pop.clone()
+    assert clone == pop
+    assert pop._tables_are_shared is True
+    assert clone._tables_are_shared is True
+    assert clone.tables._is_same_object(pop._tables)
+    del clone
+    assert pop._tables_are_shared is False
+
+
+def test_evolving_clone_leaves_original_unchanged():
+    pop = _burn_in()
+    before = _tables(pop)
+    generation = pop.generation
+    clone = pop.clone()
+    rng = fwdpy11.GSLrng(303)
+    fwdpy11.evolvets(rng, clone, _params(20), 100)
+    assert clone.generation == generation + 20
+    assert clone._tables_are_shared is False
+    assert pop._tables_are_shared is False
+    assert not clone.tables._is_same_object(pop._tables)
+    assert clone.tables._is_same_object(clone._tables)
+    assert pop.generation == generation
+    _assert_same_tables(before, _tables(pop))
+    # The original can also be evolved
+    fwdpy11.evolvets(rng, pop, _params(20), 100)
+    assert pop.generation == generation + 20
+
+
+def test_clone_matches_deep_copy():
+    pop = _burn_in()
+    clone = pop.clone()
+    deep = copy.deepcopy(pop)
+    assert deep._tables_are_shared is False
+    fwdpy11.evolvets(fwdpy11.GSLrng(404), clone, _params(20), 100)
+    fwdpy11.evolvets(fwdpy11.GSLrng(404), deep, _params(20), 100)
+    assert clone == deep
+
+
+def test_destructive_dump_of_clone():
+    pop = _burn_in()
+    before = _tables(pop)
+    clone = pop.clone()
+    ts = clone.dump_tables_to_tskit(destructive=True)
+    assert ts.num_nodes == len(before["nodes"])
+    _assert_same_tables(before, _tables(pop))
+    fwdpy11.evolvets(fwdpy11.GSLrng(505), pop, _params(20), 100)
@@ -0,0 +1,99 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _params(simlen):
+    # The population shrinks after 50 generations,
+    # leaving most mutations and genomes unused.
+    pdict = {
+        "nregions": [fwdpy11.Region(0, 1, 1)],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05, 0.5)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (1e-2, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "demography": fwdpy11.DiscreteDemography(
+            set_deme_sizes=[fwdpy11.SetDemeSize(50, 0, 20)]
+        ),
+        "simlen": simlen,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+def _run(compaction_threshold, recorder=None):
+    pop = fwdpy11.DiploidPopulation(500, 1.0)
+    rng = fwdpy11.GSLrng(54321)
+    fwdpy11.evolvets(
+        rng,
+        pop,
+        _params(100),
+        10,
+        recorder,
+        remove_extinct_variants=False,
+        compaction_threshold=compaction_threshold,
+    )
+    return pop
+
+
+def _genomes(pop):
+    rv = []
+    for d in pop.diploids:
+        for g in (d.first, d.second):
+            rv.append(
+                sorted(pop.mutations[k].pos for k in pop.haploid_genomes[g].smutations)
+            )
+    return rv
+
+
+def _assert_same_tables(pop, compacted):
+    for table in ("nodes", "edges"):
+        assert np.array_equal(
+            np.array(getattr(pop.tables, table), copy=False),
+            np.array(getattr(compacted.tables, table), copy=False),
+        )
+
+
+def test_compaction_does_not_change_output():
+    pop = _run(None)
+    compacted = _run(1.0)
+    _assert_same_tables(pop, compacted)
+    assert len(pop.tables.mutations) == len(compacted.tables.mutations)
+    for a, b in zip(pop.tables.mutations, compacted.tables.mutations):
+        assert pop.mutations[a.key].pos == compacted.mutations[b.key].pos
+        assert pop.mcounts[a.key] == compacted.mcounts[b.key]
+    assert _genomes(pop) == _genomes(compacted)
+    assert len(compacted.mutations) < len(pop.mutations)
+    assert (
+        compacted.memory_usage()["haploid_genomes"][1]
+        < pop.memory_usage()["haploid_genomes"][1]
+    )
+    lookup = compacted.mut_lookup
+    for i, m in enumerate(compacted.mutations):
+        if compacted.mcounts[i] > 0:
+            assert lookup[m.pos] == [i]
+
+
+def test_compaction_with_ancient_samples():
+    def recorder(pop, sampler):
+        if pop.generation % 25 == 0:
+            sampler.assign(np.arange(5, dtype=np.uint32))
+
+    pop = _run(None, recorder)
+    compacted = _run(1.0, recorder)
+    _assert_same_tables(pop, compacted)
+    assert len(pop.tables.mutations) == len(compacted.tables.mutations)
+    for a, b in zip(pop.tables.mutations, compacted.tables.mutations):
+        assert pop.mutations[a.key].pos == compacted.mutations[b.key].pos
+        assert (
+            pop.mcounts_ancient_samples[a.key]
+            == compacted.mcounts_ancient_samples[b.key]
+        )
+
+
+@pytest.mark.parametrize("threshold", [0.0, -1.0, 1.5])
+def test_invalid_compaction_threshold(threshold):
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, _params(10), 10, compaction_threshold=threshold)
@@ -0,0 +1,115 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+class CountingGeneticValue(fwdpy11.PyDiploidGeneticValue):
+    """
+    Neutral genetic value that records how often it is used.
+    """
+
+    def __init__(self):
+        fwdpy11.PyDiploidGeneticValue.__init__(self, 1, None, None)
+        self.ncalls = 0
+        self.nupdates = 0
+
+    def calculate_gvalue(self, data: fwdpy11.PyDiploidGeneticValueData) -> float:
+        self.ncalls += 1
+        memoryview(data)[0] = 1.0
+        return 1.0
+
+    def update(self, pop):
+        self.nupdates += 1
+
+
+def _model(mu_selected, demography=None, gvalue=None, simlen=50):
+    pdict = {
+        "nregions": [fwdpy11.Region(0, 1, 1)],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.01)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (1e-2, mu_selected, None),
+        "gvalue": fwdpy11.Multiplicative(2.0) if gvalue is None else gvalue,
+        "simlen": simlen,
+    }
+    if demography is not None:
+        pdict["demography"] = demography
+    return fwdpy11.ModelParams(**pdict)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_neutral_model(rng, pop):
+    params = _model(0.0)
+    fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
+    assert pop.generation == 50
+    assert len(pop.tables.mutations) > 0
+    md = np.array(pop.diploid_metadata, copy=False)
+    assert np.all(md["w"] == 1.0)
+    assert np.all(md["g"] == 1.0)
+
+
+def test_multiple_demes():
+    demography = fwdpy11.DiscreteDemography(
+        migmatrix=np.array([0.9, 0.1, 0.1, 0.9]).reshape(2, 2)
+    )
+    pop = fwdpy11.DiploidPopulation([50, 50], 1.0)
+    params = _model(0.0, demography)
+    rng = fwdpy11.GSLrng(42)
+    fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
+    assert pop.deme_sizes()[1].tolist() == [50, 50]
+
+
+def test_genetic_value_not_called_per_offspring():
+    demography = fwdpy11.DiscreteDemography(
+        migmatrix=np.array([0.9, 0.1, 0.1, 0.9]).reshape(2, 2)
+    )
+    pop = fwdpy11.DiploidPopulation([50, 50], 1.0)
+    gvalue = CountingGeneticValue()
+    params = _model(0.0, demography, gvalue)
+    rng = fwdpy11.GSLrng(42)
+    fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
+    assert pop.generation == 50
+    # The founders are evaluated once before the first generation.
+    # After that, each deme is evaluated once for the whole run.
+    assert gvalue.ncalls == pop.N + 2
+    assert gvalue.nupdates == 1
+
+    pop = fwdpy11.DiploidPopulation([50, 50], 1.0)
+    gvalue = CountingGeneticValue()
+    params = _model(0.0, demography, gvalue)
+    rng = fwdpy11.GSLrng(42)
+    fwdpy11.evolvets(rng, pop, params, 10)
+    assert gvalue.ncalls == pop.N * (params.simlen + 1)
+    assert gvalue.nupdates == params.simlen + 1
+
+
+@pytest.mark.parametrize("pop", [{"N": 5000, "genome_length": 1}], indirect=["pop"])
+def test_parents_sampled_uniformly(rng, pop):
+    params = _model(0.0, simlen=1)
+    fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
+    md = np.array(pop.diploid_metadata, copy=False)
+    counts = np.bincount(md["parents"].flatten(), minlength=pop.N)
+    assert counts.sum() == 2 * pop.N
+    # Each of the 2N parent draws is uniform over the N parents,
+    # so the chi-squared statistic has N - 1 degrees of freedom.
+    expected = 2.0
+    chisq = ((counts - expected) ** 2 / expected).sum()
+    df = pop.N - 1
+    assert abs(chisq - df) < 5.0 * np.sqrt(2.0 * df)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_selected_mutation_rate(rng, pop):
+    params = _model(1e-3)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_existing_selected_mutations(rng, pop):
+    params = _model(1e-1)
+    fwdpy11.evolvets(rng, pop, params, 10)
+    assert any(len(g.smutations) > 0 for g in pop.haploid_genomes if g.n > 0)
+    params = _model(0.0)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, constant_fitness=True)
@@ -0,0 +1,96 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _arrays():
+    # Three genomes: one with no mutations, one with
+    # mutations 0 and 2, and one with mutations 1 and 2.
+    return {
+        "positions": np.array([0.5, 0.1, 0.9]),
+        "effect_sizes": np.array([0.0, -0.01, 0.0]),
+        "genome_offsets": np.array([0, 0, 2, 4], dtype=np.uint64),
+        "genome_keys": np.array([0, 2, 2, 1], dtype=np.uint32),
+        "diploids": np.array([[0, 1], [1, 2], [2, 2], [0, 0]], dtype=np.uint32),
+    }
+
+
+def test_create_from_arrays():
+    pop = fwdpy11.DiploidPopulation.create_from_arrays(1.0, **_arrays())
+    assert pop.N == 4
+    assert len(pop.mutations) == 3
+    assert [m.neutral for m in pop.mutations] == [True, False, True]
+    assert list(pop.mcounts) == [2, 3, 5]
+    # Only selected mutations are in genomes
+    assert list(pop.haploid_genomes[pop.diploids[1].second].smutations) == [1]
+    assert len(pop.haploid_genomes[pop.diploids[1].second].mutations) == 0
+    assert [pop.haploid_genomes[i].n for i in range(3)] == [3, 2, 3]
+    for i, m in enumerate(pop.mutations):
+        assert pop.mut_lookup[m.pos] == [i]
+
+    # The tables give the same counts
+    ts = pop.dump_tables_to_tskit()
+    assert ts.num_sites == 3
+    for v in ts.variants():
+        key = [m.pos for m in pop.mutations].index(v.site.position)
+        assert v.genotypes.sum() == pop.mcounts[key]
+
+
+def test_evolve_population_from_arrays():
+    pop = fwdpy11.DiploidPopulation.create_from_arrays(1.0, **_arrays())
+    rng = fwdpy11.GSLrng(42)
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-1)],
+        "rates": (0, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 20,
+    }
+    fwdpy11.evolvets(rng, pop, fwdpy11.ModelParams(**pdict), 5)
+    assert pop.generation == 20
+
+
+def test_diploid_metadata():
+    arrays = _arrays()
+    md = np.array(fwdpy11.DiploidPopulation(4, 1.0).diploid_metadata)
+    md["deme"] = [0, 1, 1, 0]
+    md["g"] = [1.0, 2.0, 3.0, 4.0]
+    pop = fwdpy11.DiploidPopulation.create_from_arrays(
+        1.0, diploid_metadata=md, **arrays
+    )
+    assert list(pop.deme_sizes()[1]) == [2, 2]
+    assert [i.g for i in pop.diploid_metadata] == [1.0, 2.0, 3.0, 4.0]
+    nodes = np.array(pop.tables.nodes, copy=False)
+    for i, m in enumerate(pop.diploid_metadata):
+        assert m.label == i
+        assert list(m.nodes) == [2 * i, 2 * i + 1]
+        assert nodes["deme"][m.nodes[0]] == m.deme
+
+
+@pytest.mark.parametrize(
+    "key,value",
+    [
+        ("positions", np.array([0.5, 0.5, 0.9])),
+        ("positions", np.array([0.5, 0.1, 1.0])),
+        ("genome_keys", np.array([0, 2, 2, 3], dtype=np.uint32)),
+        ("genome_keys", np.array([0, 0, 2, 1], dtype=np.uint32)),
+        ("genome_offsets", np.array([0, 0, 2, 5], dtype=np.uint64)),
+        ("diploids", np.array([[0, 1], [1, 3]], dtype=np.uint32)),
+        ("diploids", np.array([0, 1, 1, 2], dtype=np.uint32)),
+        ("origins", np.array([-1, 0, -1], dtype=np.int32)),
+    ],
+)
+def test_invalid_input(key, value):
+    arrays = _arrays()
+    arrays[key] = value
+    with pytest.raises(ValueError):
+        fwdpy11.DiploidPopulation.create_from_arrays(1.0, **arrays)
+
+
+def test_mutation_not_in_any_genome():
+    arrays = _arrays()
+    arrays["diploids"] = np.array([[0, 1], [0, 0]], dtype=np.uint32)
+    with pytest.raises(ValueError):
+        fwdpy11.DiploidPopulation.create_from_arrays(1.0, **arrays)
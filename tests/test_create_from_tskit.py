@@ -0,0 +1,111 @@
+import msprime
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def test_import_neutral_mutations():
+    ts = msprime.simulate(20, Ne=100, mutation_rate=0.05, random_seed=42)
+    assert ts.num_mutations > 0
+    pop = fwdpy11.DiploidPopulation.create_from_tskit(ts, import_mutations=True)
+    assert pop.N == 10
+    assert len(pop.mutations) == ts.num_sites
+    assert len(pop.tables.mutations) == ts.num_sites
+    positions = np.array([m.pos for m in pop.mutations])
+    assert np.array_equal(positions, ts.tables.sites.position)
+    assert all(m.neutral for m in pop.mutations)
+    assert all(m.g <= 0 for m in pop.mutations)
+    counts = np.array([v.genotypes.sum() for v in ts.variants()])
+    assert np.array_equal(np.array(pop.mcounts), counts)
+    # The default remains to not import mutations
+    pop = fwdpy11.DiploidPopulation.create_from_tskit(ts)
+    assert len(pop.mutations) == 0
+    assert len(pop.tables.mutations) == 0
+
+
+def test_evolve_imported_neutral_mutations():
+    ts = msprime.simulate(200, Ne=100, mutation_rate=0.05, random_seed=42)
+    pop = fwdpy11.DiploidPopulation.create_from_tskit(ts, import_mutations=True)
+    assert len(pop.mutations) > 0
+    assert len(pop.mcounts_ancient_samples) == len(pop.mcounts)
+    assert np.all(np.array(pop.mcounts_ancient_samples) == 0)
+    pdict = {
+        "nregions": [fwdpy11.Region(0, 1, 1)],
+        "sregions": [],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (1e-2, 0, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 50,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    rng = fwdpy11.GSLrng(1010)
+    fwdpy11.evolvets(rng, pop, params, 10)
+    assert pop.generation == 50
+    assert len(pop.mcounts) == len(pop.mutations)
+    assert len(pop.mcounts_ancient_samples) == len(pop.mutations)
+    mc = fwdpy11.count_mutations(pop, pop.alive_nodes)
+    assert np.array_equal(mc, np.array(pop.mcounts))
+
+
+def test_individuals_from_sim_ancestry():
+    ts = msprime.sim_ancestry(samples=50, population_size=100, random_seed=1)
+    pop = fwdpy11.DiploidPopulation.create_from_tskit(ts)
+    assert pop.N == 50
+    for i, md in enumerate(pop.diploid_metadata):
+        assert list(md.nodes) == list(ts.individual(i).nodes)
+
+
+def test_round_trip_with_selected_mutations():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(1010)
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05, 0.5, label=3)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 100,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    fwdpy11.evolvets(rng, pop, params, 100)
+    assert len(pop.tables.mutations) > 0
+    ts = pop.dump_tables_to_tskit()
+    imported = fwdpy11.DiploidPopulation.create_from_tskit(ts, import_mutations=True)
+    assert imported.N == pop.N
+    assert len(imported.tables.mutations) == len(pop.tables.mutations)
+    for a, b in zip(pop.tables.mutations, imported.tables.mutations):
+        ma = pop.mutations[a.key]
+        mb = imported.mutations[b.key]
+        assert ma.pos == mb.pos
+        assert ma.s == mb.s
+        assert ma.h == mb.h
+        assert ma.label == mb.label
+        assert ma.neutral == mb.neutral
+        assert ma.g - pop.generation == mb.g
+        assert pop.mcounts[a.key] == imported.mcounts[b.key]
+    for i in range(pop.N):
+        for g in ("first", "second"):
+            a = pop.haploid_genomes[getattr(pop.diploids[i], g)]
+            b = imported.haploid_genomes[getattr(imported.diploids[i], g)]
+            assert [pop.mutations[k].pos for k in a.smutations] == [
+                imported.mutations[k].pos for k in b.smutations
+            ]
+    for a, b in zip(pop.diploid_metadata, imported.diploid_metadata):
+        assert a.w == b.w
+        assert a.g == b.g
+        assert a.deme == b.deme
+    # The imported population can be simulated further
+    fwdpy11.evolvets(rng, imported, params, 100)
+
+
+def test_multiple_mutations_per_site():
+    ts = msprime.simulate(10, Ne=100, random_seed=42)
+    tables = ts.dump_tables()
+    site = tables.sites.add_row(0.5, "0")
+    tables.mutations.add_row(site=site, node=0, derived_state="1")
+    tables.mutations.add_row(site=site, node=1, derived_state="1")
+    with pytest.raises(ValueError):
+        fwdpy11.DiploidPopulation.create_from_tskit(
+            tables.tree_sequence(), import_mutations=True
+        )
@@ -772,3 +772,50 @@ def test_yamls_with_migration(data):
     g = demes.loads(data)
     demog = fwdpy11.discrete_demography.from_demes(g, 1)
     check_debugger_passes(demog)
+
+
+def stepping_stone(ndemes):
+    # Each deme receives migrants from its left neighbor
+    # from the start, and from its right neighbor after
+    # time 10.
+    b = demes.Builder(description="stepping stone", time_units="generations")
+    for i in range(ndemes):
+        b.add_deme(name=f"d{i}", epochs=[dict(start_size=10, end_time=0)])
+    for i in range(ndemes):
+        b.add_migration(source=f"d{i}", dest=f"d{(i + 1) % ndemes}", rate=0.05)
+        b.add_migration(
+            source=f"d{(i + 1) % ndemes}", dest=f"d{i}", rate=0.05, start_time=10
+        )
+    return fwdpy11.discrete_demography.from_demes(b.resolve(), 1)
+
+
+def test_sparse_stepping_stone(monkeypatch):
+    import fwdpy11._functions.import_demes as import_demes
+
+    ndemes = import_demes._SPARSE_MIGMATRIX_MIN_DEMES
+    demog = stepping_stone(ndemes)
+    M = demog.model.migmatrix.M
+    assert hasattr(M, "tocsr")
+    assert M.shape == (ndemes, ndemes)
+    assert M.nnz == 2 * ndemes
+    assert len(demog.model.set_migration_rates) == ndemes
+    for e in demog.model.set_migration_rates:
+        assert hasattr(e.migrates, "tocsr")
+        assert e.migrates.shape == (1, ndemes)
+        assert e.migrates.nnz == 3
+
+    # The sparse output matches the dense output
+    monkeypatch.setattr(import_demes, "_SPARSE_MIGMATRIX_MIN_DEMES", ndemes + 1)
+    dense = stepping_stone(ndemes)
+    assert isinstance(dense.model.migmatrix.M, np.ndarray)
+    assert demog.model.migmatrix == dense.model.migmatrix
+    assert np.array_equal(M.toarray(), dense.model.migmatrix.M)
+    for s, d in zip(demog.model.set_migration_rates, dense.model.set_migration_rates):
+        assert s.when == d.when
+        assert s.deme == d.deme
+        assert np.array_equal(s.migrates.toarray().flatten(), d.migrates)
+
+    check_debugger_passes(demog)
+    pop = evolve_demes_model(demog, [10] * ndemes)
+    assert pop.generation == demog.metadata["total_simulation_length"]
+    assert pop.deme_sizes()[1].tolist() == [10] * ndemes
@@ -0,0 +1,118 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _growth_and_split_model():
+    G = fwdpy11.exponential_growth_rate(100, 500, 50)
+    return fwdpy11.DiscreteDemography(
+        mass_migrations=[fwdpy11.move_individuals(10, 0, 1, 0.25)],
+        set_growth_rates=[
+            fwdpy11.SetExponentialGrowth(10, 0, G),
+            fwdpy11.SetExponentialGrowth(30, 1, 0.95),
+        ],
+        set_selfing_rates=[fwdpy11.SetSelfingRate(40, 1, 0.5)],
+    )
+
+
+def test_deme_sizes_match_simulation():
+    class Recorder(object):
+        def __init__(self):
+            self.deme_sizes = {}
+
+        def __call__(self, pop, sampler):
+            sizes = np.zeros(2, dtype=np.uint32)
+            for deme, n in pop.deme_sizes(as_dict=True).items():
+                sizes[deme] = n
+            self.deme_sizes[pop.generation] = sizes
+
+    demography = _growth_and_split_model()
+    pdict = {
+        "nregions": [],
+        "sregions": [],
+        "recregions": [],
+        "rates": (0, 0, 0),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "demography": demography,
+        "simlen": 75,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    traj = fwdpy11.demography_trajectory([100], demography, params.simlen)
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    recorder = Recorder()
+    fwdpy11.evolvets(rng, pop, params, 100, recorder=recorder)
+    for generation, sizes in recorder.deme_sizes.items():
+        assert np.array_equal(traj.deme_sizes(generation), sizes)
+    assert traj.times.tolist() == [0, 10, 30, 40]
+    assert traj.growth_rates.shape == (4, 2)
+    assert traj.selfing_rates[-1].tolist() == [0.0, 0.5]
+    assert traj.migration_matrices is None
+    assert traj.global_extinction_time is None
+
+
+def test_model_errors():
+    demography = fwdpy11.DiscreteDemography(
+        set_deme_sizes=[fwdpy11.SetDemeSize(5, 1, 100)]
+    )
+    with pytest.raises(fwdpy11.DemographyError):
+        fwdpy11.demography_trajectory([100], demography)
+
+
+def test_global_extinction():
+    demography = fwdpy11.DiscreteDemography(
+        set_growth_rates=[fwdpy11.SetExponentialGrowth(5, 0, 0.9)]
+    )
+    traj = fwdpy11.demography_trajectory([100], demography, 1000)
+    t = traj.global_extinction_time
+    assert t is not None
+    assert traj.deme_sizes(t).sum() > 0
+    assert traj.deme_sizes(t + 1).sum() == 0
+
+
+def test_migration_matrix_changes():
+    demography = fwdpy11.DiscreteDemography(
+        migmatrix=np.identity(2),
+        set_migration_rates=[fwdpy11.SetMigrationRates(10, 0, [0.5, 0.5])],
+    )
+    traj = fwdpy11.demography_trajectory([50, 50], demography)
+    assert traj.migration_times.tolist() == [0, 10]
+    assert traj.migration_matrices.shape == (2, 2, 2)
+    assert traj.migration_matrices[1][0].tolist() == [0.5, 0.5]
+
+
+def test_debugger_trajectory():
+    demography = _growth_and_split_model()
+    dbg = fwdpy11.DemographyDebugger([100], demography, 75)
+    traj = dbg.trajectory
+    assert traj.times.tolist() == [0, 10, 30, 40]
+
+
+def test_debugger_report_is_lazy(monkeypatch):
+    calls = []
+    generate_report = fwdpy11.DemographyDebugger._generate_report
+
+    def counting_generate_report(self, event_queues, simlen):
+        calls.append(simlen)
+        generate_report(self, event_queues, simlen)
+
+    monkeypatch.setattr(
+        fwdpy11.DemographyDebugger, "_generate_report", counting_generate_report
+    )
+    demography = _growth_and_split_model()
+    dbg = fwdpy11.DemographyDebugger([100], demography, 75)
+    assert len(calls) == 0
+    report = dbg.report
+    assert len(calls) == 1
+    assert "Events at time 10" in report
+    assert dbg.report == report
+    assert len(calls) == 1
+
+
+def test_debugger_model_errors():
+    demography = fwdpy11.DiscreteDemography(
+        set_deme_sizes=[fwdpy11.SetDemeSize(5, 1, 100)]
+    )
+    with pytest.raises(ValueError):
+        fwdpy11.DemographyDebugger([100], demography)
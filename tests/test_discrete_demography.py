@@ -167,6 +167,51 @@ class TestMigrationMatrix(unittest.TestCase):
             fwdpy11.MigrationMatrix(np.array([2.0] * 4).reshape(2, 2), False)
 
 
+def test_sparse_migration_matrix():
+    scipy_sparse = pytest.importorskip("scipy.sparse")
+    dense = np.array([0.9, 0.1, 0.0, 0.0, 1.0, 0.0, 0.25, 0.0, 0.75]).reshape(3, 3)
+    m = fwdpy11.MigrationMatrix(scipy_sparse.csr_matrix(dense))
+    assert m.shape == (3, 3)
+    assert m._nnz == 5
+    assert m == fwdpy11.MigrationMatrix(dense)
+    up = pickle.loads(pickle.dumps(m, -1))
+    assert up == m
+    assert up._nnz == 5
+
+    with pytest.raises(ValueError):
+        fwdpy11.MigrationMatrix(scipy_sparse.csr_matrix(np.ones(6).reshape(2, 3)))
+
+
+def test_sparse_migration_matrix_in_simulation():
+    scipy_sparse = pytest.importorskip("scipy.sparse")
+    ndemes = 10
+    # A circular stepping stone model
+    M = scipy_sparse.lil_matrix((ndemes, ndemes))
+    for i in range(ndemes):
+        M[i, i] = 0.9
+        M[i, (i + 1) % ndemes] = 0.05
+        M[i, (i - 1) % ndemes] = 0.05
+    reset = scipy_sparse.identity(ndemes, format="csr")
+    demog = fwdpy11.DiscreteDemography(
+        migmatrix=M, set_migration_rates=[fwdpy11.SetMigrationRates(5, None, reset)]
+    )
+    pop = fwdpy11.DiploidPopulation([50] * ndemes, 1.0)
+    pdict = {
+        "nregions": [],
+        "sregions": [],
+        "recregions": [],
+        "rates": (0, 0, 0),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "demography": demog,
+        "simlen": 10,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    rng = fwdpy11.GSLrng(42)
+    fwdpy11.evolvets(rng, pop, params, 100)
+    assert pop.generation == 10
+    assert sorted(pop.deme_sizes()[1].tolist()) == [50] * ndemes
+
+
 class TestSetMigrationRates(unittest.TestCase):
     def test_init_from_list(self):
         m = fwdpy11.SetMigrationRates(0, 0, [0, 1, 0])
@@ -0,0 +1,102 @@
+import pickle
+
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _discrete_model(L, mu_neutral, recregions, recrate):
+    pdict = {
+        "nregions": [fwdpy11.Region(0, L, 1)] if mu_neutral > 0 else [],
+        "sregions": [fwdpy11.ExpS(0, L, 1, -0.01)],
+        "recregions": recregions,
+        "rates": (mu_neutral, 1e-2, recrate),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 50,
+        "prune_selected": False,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+@pytest.mark.parametrize("mu_neutral", [0.0, 1e-2])
+def test_integer_positions(rng, pop, mu_neutral):
+    params = _discrete_model(100, mu_neutral, [fwdpy11.Region(0, 100, 1)], 1.0)
+    fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+    assert len(pop.mutations) > 0
+    for m in pop.mutations:
+        assert m.pos == np.floor(m.pos)
+        assert m.pos >= 0 and m.pos < 100
+    positions = np.array([s.position for s in pop.tables.sites])
+    assert np.all(positions == np.floor(positions))
+    assert np.all(positions[1:] > positions[:-1])
+    for e in pop.tables.edges:
+        assert e.left == np.floor(e.left)
+        assert e.right == np.floor(e.right)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+def test_integer_breakpoints_from_genetic_map_units(rng, pop):
+    params = _discrete_model(
+        100, 0.0, [fwdpy11.PoissonInterval(0, 100, 1.0, discrete=False)], None
+    )
+    fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+    for e in pop.tables.edges:
+        assert e.left == np.floor(e.left)
+        assert e.right == np.floor(e.right)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100.5}], indirect=["pop"])
+def test_non_integer_genome_length(rng, pop):
+    params = _discrete_model(100, 0.0, [fwdpy11.Region(0, 100, 1)], 1.0)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+def test_existing_continuous_positions(rng, pop):
+    params = _discrete_model(100, 0.0, [fwdpy11.Region(0, 100, 1)], 1.0)
+    fwdpy11.evolvets(rng, pop, params, 10)
+    assert len(pop.tables.mutations) > 0
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+def test_region_runs_out_of_sites(rng, pop):
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 2, 1, -0.01)],
+        "recregions": [],
+        "rates": (0.0, 1.0, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 10,
+        "prune_selected": False,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    with pytest.raises(RuntimeError):
+        fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+def test_discrete_mode_does_not_outlive_evolvets(rng, pop):
+    params = _discrete_model(100, 0.0, [fwdpy11.Region(0, 100, 1)], 1.0)
+    fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+    copy = pickle.loads(pickle.dumps(pop))
+    fwdpy11.infinite_sites(fwdpy11.GSLrng(101), pop, 10.0)
+    fwdpy11.infinite_sites(fwdpy11.GSLrng(101), copy, 10.0)
+    assert pop.tables == copy.tables
+    positions = np.array([s.position for s in pop.tables.sites])
+    assert np.any(positions != np.floor(positions))
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 100}], indirect=["pop"])
+def test_infinite_sites_discrete_genome(rng, pop):
+    params = _discrete_model(100, 0.0, [fwdpy11.Region(0, 100, 1)], 1.0)
+    fwdpy11.evolvets(rng, pop, params, 10, discrete_genome=True)
+    nmuts = fwdpy11.infinite_sites(rng, pop, 1e-2, discrete_genome=True)
+    assert nmuts > 0
+    positions = np.array([s.position for s in pop.tables.sites])
+    assert np.all(positions == np.floor(positions))
+    assert np.all(positions[1:] > positions[:-1])
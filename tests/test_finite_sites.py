@@ -0,0 +1,70 @@
+import msprime
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _population(L=100):
+    ts = msprime.simulate(
+        20, Ne=100, length=L, recombination_rate=1e-4, random_seed=2021
+    )
+    return fwdpy11.DiploidPopulation.create_from_tskit(ts)
+
+
+@pytest.mark.parametrize(
+    "model",
+    [
+        fwdpy11.tskit_tools.JC69(),
+        fwdpy11.tskit_tools.HKY(2.0, [0.1, 0.2, 0.3, 0.4]),
+    ],
+)
+def test_parents_and_states(model):
+    pop = _population()
+    rng = fwdpy11.GSLrng(42)
+    tables = pop.dump_tables_to_tskit().dump_tables()
+    n = fwdpy11.tskit_tools.add_finite_sites_mutations(
+        tables, pop, rng, 2.0, model=model
+    )
+    assert n == tables.mutations.num_rows
+    assert n > tables.sites.num_rows
+    ts = tables.tree_sequence()
+    assert np.all(ts.tables.sites.position == np.floor(ts.tables.sites.position))
+    parents = tables.mutations.parent.copy()
+    tables.compute_mutation_parents()
+    assert np.array_equal(parents, tables.mutations.parent)
+    for site in ts.sites():
+        for m in site.mutations:
+            if m.parent == -1:
+                inherited = site.ancestral_state
+            else:
+                inherited = ts.mutation(m.parent).derived_state
+            assert m.derived_state in "ACGT"
+            assert m.derived_state != inherited
+
+
+def test_population_sites_are_kept():
+    pop = _population()
+    rng = fwdpy11.GSLrng(101)
+    fwdpy11.infinite_sites(rng, pop, 0.1)
+    tables = pop.dump_tables_to_tskit().dump_tables()
+    nsites = tables.sites.num_rows
+    n = fwdpy11.tskit_tools.add_finite_sites_mutations(tables, pop, rng, 1.0)
+    assert n > 0
+    assert tables.sites.num_rows > nsites
+    tables.tree_sequence()
+
+
+def test_non_integer_genome_length():
+    pop = _population(L=10.5)
+    rng = fwdpy11.GSLrng(101)
+    tables = pop.dump_tables_to_tskit().dump_tables()
+    with pytest.raises(ValueError):
+        fwdpy11.tskit_tools.add_finite_sites_mutations(tables, pop, rng, 1.0)
+
+
+def test_invalid_hky():
+    with pytest.raises(ValueError):
+        fwdpy11.tskit_tools.HKY(0.0)
+    with pytest.raises(ValueError):
+        fwdpy11.tskit_tools.HKY(2.0, [0.5, 0.5, 0.5, 0.5])
@@ -0,0 +1,80 @@
+import pickle
+
+import numpy as np
+
+import fwdpy11
+
+
+def _params(simlen, prune_selected):
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, 0.1)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 5e-3, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": simlen,
+        "prune_selected": prune_selected,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+def test_preserved_fixations_recorded_once():
+    pop = fwdpy11.DiploidPopulation(50, 1.0)
+    rng = fwdpy11.GSLrng(54321)
+    params = _params(200, False)
+    fwdpy11.evolvets(rng, pop, params, 20, track_mutation_counts=True)
+    # Continuing the simulation must not record
+    # existing fixations a second time.
+    fwdpy11.evolvets(rng, pop, params, 20, track_mutation_counts=True)
+    assert len(pop.fixations) > 0, "Nothing fixed, so test case is not helpful"
+    assert len(pop.fixations) == len(pop.fixation_times)
+    keys = [(f.g, f.pos) for f in pop.fixations]
+    assert keys == sorted(keys)
+    assert len(set(keys)) == len(keys)
+    mc = np.array(pop.mcounts)
+    fixed = set(
+        (pop.mutations[i].g, pop.mutations[i].pos)
+        for i in np.where(mc == 2 * pop.N)[0]
+    )
+    assert fixed.issubset(set(keys))
+    for f, t in zip(pop.fixations, pop.fixation_times):
+        assert t > f.g
+
+
+def test_pickling_during_simulation_sorts_fixations(tmp_path):
+    # Fixations may be stored unsorted during a simulation.
+    # Pickled and dumped populations must have them in the
+    # order exposed to Python, which is what accessing
+    # pop.fixations leaves in place.
+    class Recorder(object):
+        def __init__(self):
+            self.nchecks = 0
+
+        def __call__(self, pop, sampler):
+            if pop.generation % 10 != 0:
+                return
+            pickled = pickle.dumps(pop)
+            with open(tmp_path / "pickled", "wb") as f:
+                pop.pickle_to_file(f)
+            pop.dump_to_file(str(tmp_path / "dumped"))
+            keys = [(f.g, f.pos) for f in pop.fixations]
+            assert keys == sorted(keys)
+            assert pickle.dumps(pop) == pickled
+            loaded = [pickle.loads(pickled)]
+            with open(tmp_path / "pickled", "rb") as f:
+                loaded.append(fwdpy11.DiploidPopulation.load_from_pickle_file(f))
+            loaded.append(
+                fwdpy11.DiploidPopulation.load_from_file(str(tmp_path / "dumped"))
+            )
+            for lpop in loaded:
+                assert [(f.g, f.pos) for f in lpop.fixations] == keys
+                assert list(lpop.fixation_times) == list(pop.fixation_times)
+            self.nchecks += 1
+
+    pop = fwdpy11.DiploidPopulation(50, 1.0)
+    rng = fwdpy11.GSLrng(54321)
+    params = _params(200, False)
+    recorder = Recorder()
+    fwdpy11.evolvets(rng, pop, params, 20, recorder, track_mutation_counts=True)
+    assert recorder.nchecks == 20
+    assert len(pop.fixations) > 0, "Nothing fixed, so test case is not helpful"
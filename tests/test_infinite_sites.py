@@ -0,0 +1,70 @@
+import msprime
+import numpy as np
+
+import fwdpy11
+
+
+def _mutate(threads):
+    ts = msprime.simulate(50, Ne=100, recombination_rate=5e-3, random_seed=12)
+    pop = fwdpy11.DiploidPopulation.create_from_tskit(ts)
+    rng = fwdpy11.GSLrng(54321)
+    n = fwdpy11.infinite_sites(rng, pop, 1e-2, threads=threads)
+    return n, pop
+
+
+def test_output_does_not_depend_on_threads():
+    n1, pop1 = _mutate(1)
+    n4, pop4 = _mutate(4)
+    assert n1 > 0
+    assert n1 == n4
+    assert [m.pos for m in pop1.mutations] == [m.pos for m in pop4.mutations]
+    assert np.array_equal(np.array(pop1.mcounts), np.array(pop4.mcounts))
+
+
+def test_tables_and_counts():
+    n, pop = _mutate(2)
+    assert len(pop.tables.mutations) == n
+    positions = np.array(pop.tables.sites, copy=False)["position"]
+    assert np.all(positions[1:] > positions[:-1])
+    samples = pop.alive_nodes
+    counts = fwdpy11.count_mutations(pop, samples, threads=1)
+    assert np.array_equal(np.array(pop.mcounts), counts)
+    for m in pop.tables.mutations:
+        assert pop.mutations[m.key].neutral
+        assert pop.mutations[m.key].pos == positions[m.site]
+
+
+def test_no_edges_no_mutations():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    assert fwdpy11.infinite_sites(rng, pop, 10.0) == 0
+    assert len(pop.tables.mutations) == 0
+
+
+def test_mutations_only_on_edges_of_uncoalesced_trees():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    pdict = {
+        "nregions": [],
+        "sregions": [],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 0, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 10,
+    }
+    rng = fwdpy11.GSLrng(101)
+    fwdpy11.evolvets(rng, pop, fwdpy11.ModelParams(**pdict), 100)
+    n = fwdpy11.infinite_sites(rng, pop, 10.0)
+    assert n > 0
+    nodes = np.array(pop.tables.nodes, copy=False)
+    edges = np.array(pop.tables.edges, copy=False)
+    positions = np.array(pop.tables.sites, copy=False)["position"]
+    for m in pop.tables.mutations:
+        pos = positions[m.site]
+        above = edges[
+            (edges["child"] == m.node) & (edges["left"] <= pos) & (edges["right"] > pos)
+        ]
+        # Each mutation is on a branch with a parent,
+        # and arose along that branch.
+        assert len(above) == 1
+        assert pop.mutations[m.key].g > nodes["time"][above["parent"][0]]
+        assert pop.mutations[m.key].g <= nodes["time"][m.node]
@@ -0,0 +1,79 @@
+import pytest
+
+import fwdpy11
+
+
+def _params(simlen=50):
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05, 0.5)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": simlen,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+def test_memory_usage():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    fwdpy11.evolvets(rng, pop, _params(), 10)
+    usage = pop.memory_usage()
+    for key in (
+        "tables.nodes",
+        "tables.edges",
+        "tables.sites",
+        "tables.mutations",
+        "tables.indexes",
+        "haploid_genomes",
+        "haploid_genomes.keys",
+        "mutations",
+        "mcounts",
+        "mut_lookup",
+        "fixations",
+        "fixation_lookup",
+        "diploids",
+        "diploid_metadata",
+        "ancient_sample_metadata",
+        "genetic_value_matrix",
+        "ancient_sample_genetic_value_matrix",
+    ):
+        assert key in usage
+        nbytes, capacity = usage[key]
+        assert nbytes <= capacity
+    assert usage["tables.nodes"][0] > 0
+    assert usage["diploids"][0] > 0
+    assert usage["mutations"][0] > 0
+
+    tables_usage = pop.tables.memory_usage()
+    for key, value in tables_usage.items():
+        assert usage[f"tables.{key}"] == value
+
+
+def test_memory_limit_exceeded():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    with pytest.raises(fwdpy11.MemoryLimitExceeded):
+        fwdpy11.evolvets(rng, pop, _params(), 100, memory_limit=1000)
+
+
+def test_memory_limit_forces_simplification():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    limit = 1000000
+
+    def recorder(pop, _):
+        # Without the limit, the tables are never
+        # simplified during the simulation.
+        assert sum(v[1] for v in pop.memory_usage().values()) <= 4 * limit
+
+    fwdpy11.evolvets(rng, pop, _params(500), 1000, recorder, memory_limit=limit)
+    assert pop.generation == 500
+
+
+def test_invalid_memory_limit():
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    rng = fwdpy11.GSLrng(101)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, _params(), 100, memory_limit=0)
@@ -0,0 +1,97 @@
+import msprime
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+@pytest.fixture
+def pop():
+    ts = msprime.simulate(100, recombination_rate=10.0, random_seed=666)
+    return fwdpy11.DiploidPopulation.create_from_tskit(ts)
+
+
+def _sample_sets():
+    return [np.arange(10, dtype=np.int32), np.arange(50, 100, 2, dtype=np.int32)]
+
+
+def _same_tables(a, b):
+    return (
+        np.array_equal(np.array(a.edges, copy=False), np.array(b.edges, copy=False))
+        and np.array_equal(
+            np.array(a.nodes, copy=False), np.array(b.nodes, copy=False)
+        )
+        and np.array_equal(np.array(a.input_left), np.array(b.input_left))
+        and np.array_equal(np.array(a.output_right), np.array(b.output_right))
+    )
+
+
+def test_batch_matches_simplify_tables(pop):
+    simplifier = fwdpy11.Simplifier()
+    for threads in (1, 2):
+        results = simplifier.simplify_batch(pop.tables, _sample_sets(), threads=threads)
+        assert len(results) == 2
+        for samples, (tables, idmap) in zip(_sample_sets(), results):
+            expected, expected_idmap = fwdpy11.simplify_tables(pop.tables, samples)
+            assert _same_tables(tables, expected)
+            assert np.array_equal(idmap, expected_idmap)
+
+
+def test_in_place(pop):
+    simplifier = fwdpy11.Simplifier()
+    for samples in _sample_sets():
+        expected, expected_idmap = fwdpy11.simplify_tables(pop.tables, samples)
+        tables, _ = fwdpy11.simplify_tables(pop.tables, np.arange(2 * pop.N))
+        idmap = simplifier.simplify(tables, samples)
+        assert _same_tables(tables, expected)
+        assert np.array_equal(idmap, expected_idmap)
+
+
+def test_skip_index_building(pop):
+    simplifier = fwdpy11.Simplifier()
+    tables, _ = simplifier.simplify_batch(
+        pop.tables, _sample_sets(), build_indexes=False
+    )[0]
+    assert len(tables.input_left) == 0
+    assert len(tables.output_right) == 0
+    tables.build_indexes()
+    assert len(tables.input_left) == len(tables.edges)
+
+
+def test_invalid_samples(pop):
+    simplifier = fwdpy11.Simplifier()
+    with pytest.raises(ValueError):
+        simplifier.simplify_batch(pop.tables, [[0, 1], [len(pop.tables.nodes)]])
+
+
+def test_population_tables_rejected(pop):
+    simplifier = fwdpy11.Simplifier()
+    nedges = len(pop.tables.edges)
+    with pytest.raises(ValueError):
+        simplifier.simplify(pop.tables, _sample_sets()[0])
+    assert len(pop.tables.edges) == nedges
+    # Copies are fine
+    results = simplifier.simplify_batch(pop.tables, _sample_sets())
+    simplifier.simplify(results[0][0], np.arange(5, dtype=np.int32))
+
+
+def test_shared_between_python_threads(pop):
+    import concurrent.futures
+
+    simplifier = fwdpy11.Simplifier()
+    expected = [fwdpy11.simplify_tables(pop.tables, s) for s in _sample_sets()]
+
+    def work(i):
+        samples = _sample_sets()[i % 2]
+        tables, _ = fwdpy11.simplify_tables(pop.tables, np.arange(2 * pop.N))
+        idmap = simplifier.simplify(tables, samples)
+        batch = simplifier.simplify_batch(pop.tables, _sample_sets(), threads=2)
+        return i % 2, tables, idmap, batch
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=4) as executor:
+        for i, tables, idmap, batch in executor.map(work, range(16)):
+            assert _same_tables(tables, expected[i][0])
+            assert np.array_equal(idmap, expected[i][1])
+            for (t, m), (e, em) in zip(batch, expected):
+                assert _same_tables(t, e)
+                assert np.array_equal(m, em)
@@ -0,0 +1,137 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+def _set_positions(pop, rng, width, height):
+    for md in pop.diploid_metadata:
+        md.geography = (
+            fwdpy11.gsl_ran_flat(rng, 0, width),
+            fwdpy11.gsl_ran_flat(rng, 0, height),
+            0.0,
+        )
+
+
+@pytest.fixture
+def params():
+    pdict = {
+        "nregions": [],
+        "sregions": [],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0.0, 0.0, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 20,
+    }
+    return fwdpy11.ModelParams(**pdict)
+
+
+@pytest.mark.parametrize("pop", [{"N": 500, "genome_length": 1}], indirect=["pop"])
+def test_parents_are_nearby(rng, pop, params):
+    _set_positions(pop, rng, 10.0, 10.0)
+    spatial = fwdpy11.SpatialMating(
+        width=10.0, height=10.0, mating_sigma=0.5, dispersal_sigma=0.25
+    )
+    parents = []
+
+    def recorder(pop, _):
+        parents.append(np.array(pop.diploid_metadata, copy=True))
+
+    fwdpy11.evolvets(rng, pop, params, 10, recorder, spatial_mating=spatial)
+    assert pop.generation == 20
+    md = np.array(pop.diploid_metadata, copy=False)
+    assert np.all(md["geography"][:, :2] >= 0.0)
+    assert np.all(md["geography"][:, 0] <= 10.0)
+    assert np.all(md["geography"][:, 1] <= 10.0)
+    # Parents were recorded one generation before their offspring
+    for prev, offspring in zip(parents[:-1], parents[1:]):
+        p = offspring["parents"]
+        d = prev["geography"][p[:, 0], :2] - prev["geography"][p[:, 1], :2]
+        outcrossed = p[:, 0] != p[:, 1]
+        assert np.all(np.sqrt((d[outcrossed] ** 2).sum(axis=1)) <= 1.5 + 1e-9)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_density_regulation(rng, pop, params):
+    _set_positions(pop, rng, 1.0, 1.0)
+    spatial = fwdpy11.SpatialMating(
+        width=1.0,
+        height=1.0,
+        mating_sigma=1.0,
+        dispersal_sigma=0.1,
+        local_capacity=10.0,
+    )
+    fwdpy11.evolvets(rng, pop, params, 10, spatial_mating=spatial)
+    md = np.array(pop.diploid_metadata, copy=False)
+    # Everyone is a neighbor of everyone else
+    assert len(spatial.density) == pop.N
+    assert np.allclose(spatial.density, 1.0 / (1.0 + 99.0 / 10.0))
+    # Density regulation does not change fitness
+    assert np.all(md["w"] == 1.0)
+
+
+class HalfDensity(fwdpy11.SpatialMating):
+    def density_regulation(self, individual, num_neighbors):
+        if num_neighbors == 0:
+            return 1.0
+        return 0.5
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_density_regulation_from_python(rng, pop, params):
+    _set_positions(pop, rng, 1.0, 1.0)
+    spatial = HalfDensity(
+        width=1.0,
+        height=1.0,
+        mating_sigma=1.0,
+        dispersal_sigma=0.1,
+    )
+    fwdpy11.evolvets(rng, pop, params, 10, spatial_mating=spatial)
+    assert np.allclose(spatial.density, 0.5)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_positions_outside_of_habitat(rng, pop, params):
+    spatial = fwdpy11.SpatialMating(
+        width=1.0, height=1.0, mating_sigma=0.1, dispersal_sigma=0.1
+    )
+    _set_positions(pop, rng, 1.0, 1.0)
+    pop.diploid_metadata[0].geography = (2.0, 0.0, 0.0)
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, spatial_mating=spatial)
+
+
+@pytest.mark.parametrize("pop", [{"N": 100, "genome_length": 1}], indirect=["pop"])
+def test_default_positions(rng, pop, params):
+    spatial = fwdpy11.SpatialMating(
+        width=1.0, height=1.0, mating_sigma=0.1, dispersal_sigma=0.1
+    )
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 10, spatial_mating=spatial)
+
+
+@pytest.mark.parametrize("pop", [{"N": 5000, "genome_length": 1}], indirect=["pop"])
+def test_clustered_individuals(rng, pop, params):
+    for md in pop.diploid_metadata:
+        md.geography = (0.5, 0.5, 0.0)
+    spatial = fwdpy11.SpatialMating(
+        width=1.0,
+        height=1.0,
+        mating_sigma=0.1,
+        dispersal_sigma=0.0,
+        local_capacity=10.0,
+        max_candidates=100,
+    )
+    fwdpy11.evolvets(rng, pop, params, 10, spatial_mating=spatial)
+    assert pop.generation == 20
+    md = np.array(pop.diploid_metadata, copy=False)
+    assert np.all(md["geography"][:, :2] == 0.5)
+    # Neighbor counts are estimated from samples of 100 individuals
+    assert np.allclose(spatial.density, 1.0 / (1.0 + 4999.0 / 10.0), rtol=0.05)
+
+
+def test_invalid_parameters():
+    with pytest.raises(ValueError):
+        fwdpy11.SpatialMating(
+            width=-1.0, height=1.0, mating_sigma=0.1, dispersal_sigma=0.1
+        )